@@ -0,0 +1,417 @@
+#!/usr/bin/env python3
+"""
+Zephyr Edge AI Demo - Deploy-time TFLite Graph Optimizer
+
+Post-export pass over the converter output. The device only uses the
+argmax and a confidence score, so anything after the last Dense layer is
+dead weight that costs per-op interpreter overhead on every Invoke().
+
+Passes (in order):
+1. Strip trailing SOFTMAX - the firmware detects a logits output and
+   applies softmax to the 4 dequantized scores itself
+2. Remove identity QUANTIZE / DEQUANTIZE->QUANTIZE / RESHAPE nodes
+3. Fuse standalone RELU/RELU6/RELU_N1_TO_1 into the producing op
+4. Drop unused tensors, buffers and operator codes
+
+Usage:
+    python optimize_tflite.py gesture_model.tflite -o gesture_model_opt.tflite
+"""
+
+import argparse
+import sys
+from collections import Counter
+from typing import Dict, List, Optional
+
+from tensorflow.lite.python import schema_py_generated as schema
+from tensorflow.lite.tools import flatbuffer_utils
+
+BuiltinOperator = schema.BuiltinOperator
+ActivationFunctionType = schema.ActivationFunctionType
+
+# Reverse map for readable op names in the report
+OP_NAMES = {v: k for k, v in vars(BuiltinOperator).items()
+            if not k.startswith('_')}
+
+# Ops whose builtin options carry a fusedActivationFunction field
+FUSABLE_PRODUCERS = {
+    BuiltinOperator.FULLY_CONNECTED,
+    BuiltinOperator.CONV_2D,
+    BuiltinOperator.DEPTHWISE_CONV_2D,
+    BuiltinOperator.ADD,
+}
+
+# Standalone activation op -> fused activation enum
+ACTIVATION_FUSIONS = {
+    BuiltinOperator.RELU: ActivationFunctionType.RELU,
+    BuiltinOperator.RELU6: ActivationFunctionType.RELU6,
+    BuiltinOperator.RELU_N1_TO_1: ActivationFunctionType.RELU_N1_TO_1,
+}
+
+
+def builtin_code(op_code) -> int:
+    """Builtin code of an OperatorCodeT (handles the deprecated field)."""
+    return max(op_code.builtinCode, op_code.deprecatedBuiltinCode)
+
+
+def op_name(code: int) -> str:
+    return OP_NAMES.get(code, f'OP_{code}')
+
+
+def quant_equal(a, b) -> bool:
+    """True if two tensors share type and quantization parameters."""
+    if a.type != b.type:
+        return False
+    qa, qb = a.quantization, b.quantization
+    if qa is None or qb is None:
+        return qa is None and qb is None
+    return (list(qa.scale if qa.scale is not None else []) ==
+            list(qb.scale if qb.scale is not None else []) and
+            list(qa.zeroPoint if qa.zeroPoint is not None else []) ==
+            list(qb.zeroPoint if qb.zeroPoint is not None else []))
+
+
+class GraphOptimizer:
+    """Applies deploy-time rewrites to a TFLite ModelT (object API)."""
+
+    def __init__(self, model, keep_softmax: bool = False):
+        self.model = model
+        self.keep_softmax = keep_softmax
+        self.actions: List[str] = []
+
+    # ------------------------------------------------------------------
+    # Graph helpers (main subgraph)
+    # ------------------------------------------------------------------
+
+    @property
+    def graph(self):
+        return self.model.subgraphs[0]
+
+    def code_of(self, op) -> int:
+        return builtin_code(self.model.operatorCodes[op.opcodeIndex])
+
+    def producer(self, tensor_idx: int):
+        for op in self.graph.operators:
+            if tensor_idx in list(op.outputs):
+                return op
+        return None
+
+    def consumers(self, tensor_idx: int) -> list:
+        return [op for op in self.graph.operators
+                if tensor_idx in list(op.inputs)]
+
+    def is_graph_input(self, tensor_idx: int) -> bool:
+        return tensor_idx in list(self.graph.inputs)
+
+    def is_graph_output(self, tensor_idx: int) -> bool:
+        return tensor_idx in list(self.graph.outputs)
+
+    def replace_tensor_uses(self, old: int, new: int):
+        """Point every reader of tensor `old` at tensor `new`."""
+        for op in self.graph.operators:
+            op.inputs = [new if t == old else t for t in op.inputs]
+        self.graph.outputs = [new if t == old else t
+                              for t in self.graph.outputs]
+        for sig in self.model.signatureDefs or []:
+            if sig.subgraphIndex != 0:
+                continue
+            for tensor_map in sig.outputs or []:
+                if tensor_map.tensorIndex == old:
+                    tensor_map.tensorIndex = new
+
+    def bypass(self, op, src: int, dst: int, reason: str) -> bool:
+        """Remove `op`, making readers of `dst` read `src` instead."""
+        if self.is_graph_input(src) and self.is_graph_output(dst):
+            return False
+        self.replace_tensor_uses(dst, src)
+        self.graph.operators.remove(op)
+        self.actions.append(reason)
+        return True
+
+    # ------------------------------------------------------------------
+    # Passes
+    # ------------------------------------------------------------------
+
+    def strip_trailing_softmax(self) -> int:
+        """Replace graph outputs produced by SOFTMAX with the logits."""
+        if self.keep_softmax:
+            return 0
+        removed = 0
+        for out_idx in list(self.graph.outputs):
+            op = self.producer(out_idx)
+            if op is None or self.code_of(op) != BuiltinOperator.SOFTMAX:
+                continue
+            if len(self.consumers(out_idx)) > 0:
+                continue
+            logits = op.inputs[0]
+            if self.bypass(op, logits, out_idx,
+                           f'strip SOFTMAX -> output tensor {logits}'):
+                removed += 1
+        return removed
+
+    def remove_identity_ops(self) -> int:
+        """Remove quantize/dequantize/reshape nodes that change nothing."""
+        removed = 0
+        changed = True
+        while changed:
+            changed = False
+            tensors = self.graph.tensors
+            for op in list(self.graph.operators):
+                code = self.code_of(op)
+                src, dst = op.inputs[0], op.outputs[0]
+
+                if code == BuiltinOperator.QUANTIZE:
+                    if quant_equal(tensors[src], tensors[dst]):
+                        changed = self.bypass(
+                            op, src, dst, f'remove identity QUANTIZE ({dst})')
+                    else:
+                        # DEQUANTIZE -> QUANTIZE round trip
+                        prev = self.producer(src)
+                        if (prev is not None and
+                                self.code_of(prev) == BuiltinOperator.DEQUANTIZE and
+                                len(self.consumers(src)) == 1 and
+                                quant_equal(tensors[prev.inputs[0]],
+                                            tensors[dst]) and
+                                not (self.is_graph_input(prev.inputs[0]) and
+                                     self.is_graph_output(dst))):
+                            origin = prev.inputs[0]
+                            self.graph.operators.remove(prev)
+                            changed = self.bypass(
+                                op, origin, dst,
+                                f'remove DEQUANTIZE/QUANTIZE pair ({dst})')
+                            removed += 1
+
+                elif code == BuiltinOperator.RESHAPE:
+                    if list(tensors[src].shape) == list(tensors[dst].shape):
+                        changed = self.bypass(
+                            op, src, dst, f'remove no-op RESHAPE ({dst})')
+
+                if changed:
+                    removed += 1
+                    break
+        return removed
+
+    def fuse_activations(self) -> int:
+        """Fold standalone activations into the producing op."""
+        fused = 0
+        for op in list(self.graph.operators):
+            fused_act = ACTIVATION_FUSIONS.get(self.code_of(op))
+            if fused_act is None:
+                continue
+            src, dst = op.inputs[0], op.outputs[0]
+            prev = self.producer(src)
+            if (prev is None or
+                    self.code_of(prev) not in FUSABLE_PRODUCERS or
+                    len(self.consumers(src)) != 1 or
+                    self.is_graph_output(src)):
+                continue
+            options = prev.builtinOptions
+            if (options is None or
+                    getattr(options, 'fusedActivationFunction', None) !=
+                    ActivationFunctionType.NONE):
+                continue
+
+            # Producer writes straight into the activation's output tensor,
+            # which already carries the post-activation quantization
+            options.fusedActivationFunction = fused_act
+            prev.outputs = [dst if t == src else t for t in prev.outputs]
+            self.graph.operators.remove(op)
+            self.actions.append(
+                f'fuse {op_name(self.code_of(prev))} + activation ({dst})')
+            fused += 1
+        return fused
+
+    def prune_unused(self) -> Dict[str, int]:
+        """Drop tensors, buffers and opcodes nothing refers to."""
+        model = self.model
+        pruned = {'tensors': 0, 'buffers': 0, 'opcodes': 0}
+
+        # Tensors, per subgraph
+        for graph in model.subgraphs:
+            used = set(graph.inputs) | set(graph.outputs)
+            for op in graph.operators:
+                used.update(t for t in op.inputs if t >= 0)
+                used.update(op.outputs)
+                if op.intermediates is not None:
+                    used.update(op.intermediates)
+
+            remap = {}
+            kept = []
+            for idx, tensor in enumerate(graph.tensors):
+                if idx in used:
+                    remap[idx] = len(kept)
+                    kept.append(tensor)
+            pruned['tensors'] += len(graph.tensors) - len(kept)
+            graph.tensors = kept
+
+            def fix(lst):
+                return [remap[t] if t >= 0 else t for t in lst]
+
+            graph.inputs = fix(graph.inputs)
+            graph.outputs = fix(graph.outputs)
+            for op in graph.operators:
+                op.inputs = fix(op.inputs)
+                op.outputs = fix(op.outputs)
+                if op.intermediates is not None:
+                    op.intermediates = fix(op.intermediates)
+
+            graph_idx = model.subgraphs.index(graph)
+            for sig in model.signatureDefs or []:
+                if sig.subgraphIndex != graph_idx:
+                    continue
+                for tensor_map in (sig.inputs or []) + (sig.outputs or []):
+                    tensor_map.tensorIndex = remap[tensor_map.tensorIndex]
+
+        # Buffers (index 0 is the reserved empty buffer)
+        used_buffers = {0}
+        for graph in model.subgraphs:
+            used_buffers.update(t.buffer for t in graph.tensors)
+        for meta in model.metadata or []:
+            used_buffers.add(meta.buffer)
+
+        buf_remap = {}
+        kept_buffers = []
+        for idx, buf in enumerate(model.buffers):
+            if idx in used_buffers:
+                buf_remap[idx] = len(kept_buffers)
+                kept_buffers.append(buf)
+        pruned['buffers'] = len(model.buffers) - len(kept_buffers)
+        model.buffers = kept_buffers
+        for graph in model.subgraphs:
+            for tensor in graph.tensors:
+                tensor.buffer = buf_remap[tensor.buffer]
+        for meta in model.metadata or []:
+            meta.buffer = buf_remap[meta.buffer]
+
+        # Operator codes
+        used_codes = set()
+        for graph in model.subgraphs:
+            used_codes.update(op.opcodeIndex for op in graph.operators)
+        code_remap = {}
+        kept_codes = []
+        for idx, code in enumerate(model.operatorCodes):
+            if idx in used_codes:
+                code_remap[idx] = len(kept_codes)
+                kept_codes.append(code)
+        pruned['opcodes'] = len(model.operatorCodes) - len(kept_codes)
+        model.operatorCodes = kept_codes
+        for graph in model.subgraphs:
+            for op in graph.operators:
+                op.opcodeIndex = code_remap[op.opcodeIndex]
+
+        return pruned
+
+    def op_histogram(self) -> Counter:
+        return Counter(op_name(self.code_of(op))
+                       for op in self.graph.operators)
+
+
+def optimize_model(tflite_model: bytes, keep_softmax: bool = False):
+    """
+    Run all optimization passes over a serialized TFLite model.
+
+    Args:
+        tflite_model: Converter output
+        keep_softmax: Leave a trailing SOFTMAX in place
+
+    Returns:
+        Tuple of (optimized model bytes, report dict)
+    """
+    model = flatbuffer_utils.read_model_from_bytearray(bytearray(tflite_model))
+    opt = GraphOptimizer(model, keep_softmax=keep_softmax)
+
+    ops_before = opt.op_histogram()
+    tensors_before = len(opt.graph.tensors)
+    buffers_before = len(model.buffers)
+
+    passes = {
+        'softmax_stripped': opt.strip_trailing_softmax(),
+        'identity_removed': opt.remove_identity_ops(),
+        'activations_fused': opt.fuse_activations(),
+    }
+    pruned = opt.prune_unused()
+
+    optimized = bytes(flatbuffer_utils.convert_object_to_bytearray(model))
+    ops_after = opt.op_histogram()
+
+    report = {
+        'ops_before': sum(ops_before.values()),
+        'ops_after': sum(ops_after.values()),
+        'op_types_before': dict(ops_before),
+        'op_types_after': dict(ops_after),
+        'tensors_before': tensors_before,
+        'tensors_after': len(opt.graph.tensors),
+        'buffers_before': buffers_before,
+        'buffers_after': len(model.buffers),
+        'size_before': len(tflite_model),
+        'size_after': len(optimized),
+        'passes': passes,
+        'pruned': pruned,
+        'actions': opt.actions,
+    }
+    return optimized, report
+
+
+def print_report(report: Dict, out=sys.stdout):
+    """Print a plain-text optimization report."""
+    size_delta = report['size_after'] - report['size_before']
+    op_delta = report['ops_after'] - report['ops_before']
+
+    print("=" * 60, file=out)
+    print("TFLITE GRAPH OPTIMIZATION REPORT", file=out)
+    print("=" * 60, file=out)
+    print(f"  Ops:      {report['ops_before']:>6} -> {report['ops_after']:<6} "
+          f"({op_delta:+d})", file=out)
+    print(f"  Tensors:  {report['tensors_before']:>6} -> "
+          f"{report['tensors_after']:<6}", file=out)
+    print(f"  Buffers:  {report['buffers_before']:>6} -> "
+          f"{report['buffers_after']:<6}", file=out)
+    print(f"  Size:     {report['size_before']:>6} -> {report['size_after']:<6} "
+          f"({size_delta:+d} bytes)", file=out)
+
+    print("\n  Op types:", file=out)
+    names = sorted(set(report['op_types_before']) |
+                   set(report['op_types_after']))
+    for name in names:
+        before = report['op_types_before'].get(name, 0)
+        after = report['op_types_after'].get(name, 0)
+        print(f"    {name:<20} {before:>3} -> {after:<3}", file=out)
+
+    if report['actions']:
+        print("\n  Actions:", file=out)
+        for action in report['actions']:
+            print(f"    - {action}", file=out)
+    print("=" * 60, file=out)
+
+
+def main(argv: Optional[List[str]] = None) -> int:
+    parser = argparse.ArgumentParser(
+        description="Deploy-time graph optimizer for the gesture model"
+    )
+    parser.add_argument('input', help='Input .tflite file')
+    parser.add_argument(
+        '--output', '-o',
+        help='Output .tflite file (default: overwrite input)'
+    )
+    parser.add_argument(
+        '--keep-softmax',
+        action='store_true',
+        help='Keep the trailing SOFTMAX (firmware then reports probabilities)'
+    )
+    args = parser.parse_args(argv)
+
+    with open(args.input, 'rb') as f:
+        tflite_model = f.read()
+
+    optimized, report = optimize_model(tflite_model,
+                                       keep_softmax=args.keep_softmax)
+    print_report(report)
+
+    output_path = args.output or args.input
+    with open(output_path, 'wb') as f:
+        f.write(optimized)
+    print(f"Wrote {output_path}")
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -6,7 +6,10 @@ This script:
 1. Generates synthetic accelerometer data for 4 gesture classes
 2. Trains a SIMPLE Dense-layer-only neural network (TFLite-Micro compatible)
 3. Converts to TFLite with INT8 quantization
-4. Exports as C header for embedding in Zephyr
+4. Optimizes the graph for deployment (see optimize_tflite.py)
+5. Exports as C header for embedding in Zephyr
+6. Trains the gradient-boosted tree backend on window features and
+   compares it with the network (see tree_model.py)
 
 Features beautiful progress visualization using Rich!
 """
@@ -25,6 +28,9 @@ from rich.live import Live
 from rich import box
 from tqdm.keras import TqdmCallback
 
+from optimize_tflite import optimize_model
+import tree_model
+
 console = Console()
 
 # Configuration
@@ -282,6 +288,89 @@ def quantize_model(model, X_train):
     return tflite_model
 
 
+def optimize_for_deploy(tflite_model):
+    """Run the deploy-time graph optimizer and show its report"""
+    console.print("\n[bold cyan]✂️  Optimizing Graph for Deployment[/bold cyan]")
+    
+    optimized, report = optimize_model(tflite_model)
+    
+    table = Table(title="Graph Optimization", box=box.ROUNDED)
+    table.add_column("Metric", style="cyan")
+    table.add_column("Before", justify="right", style="yellow")
+    table.add_column("After", justify="right", style="green")
+    table.add_column("Delta", justify="right")
+    for label, key in [("Ops", "ops"), ("Tensors", "tensors"),
+                       ("Buffers", "buffers"), ("Size (bytes)", "size")]:
+        before = report[f'{key}_before']
+        after = report[f'{key}_after']
+        table.add_row(label, f"{before:,}", f"{after:,}", f"{after - before:+,}")
+    console.print(table)
+    
+    for action in report['actions']:
+        console.print(f"   [green]✓[/green] {action}")
+    
+    return optimized, report
+
+
+def evaluate_tflite(tflite_model, X, y):
+    """Accuracy of the deployed int8 model, run by the TFLite interpreter"""
+    interpreter = tf.lite.Interpreter(model_content=tflite_model)
+    interpreter.allocate_tensors()
+    inp = interpreter.get_input_details()[0]
+    out = interpreter.get_output_details()[0]
+    scale, zero_point = inp['quantization']
+    
+    correct = 0
+    for i in range(len(X)):
+        q = np.clip(np.round(X[i:i+1] / scale + zero_point), -128, 127)
+        interpreter.set_tensor(inp['index'], q.astype(np.int8))
+        interpreter.invoke()
+        correct += int(np.argmax(interpreter.get_tensor(out['index'])[0]) == y[i])
+    
+    return correct / len(X)
+
+
+def train_tree_backend(X_train, y_train, X_val, y_val, output_path):
+    """Train the tree backend and generate tree_model.h"""
+    console.print("\n[bold cyan]🌲 Training Gradient-Boosted Tree Backend[/bold cyan]")
+    
+    # Features of the int8 windows the device will see
+    f_train = tree_model.extract_features(
+        tree_model.quantize_windows(X_train, NUM_SAMPLES, NUM_AXES))
+    f_val = tree_model.extract_features(
+        tree_model.quantize_windows(X_val, NUM_SAMPLES, NUM_AXES))
+    
+    clf = tree_model.train(f_train, y_train)
+    tables = tree_model.export(clf)
+    
+    float_acc = float(np.mean(clf.predict(f_val) == y_val))
+    scores = tree_model.emulate(tables, f_val, NUM_CLASSES)
+    int_acc = float(np.mean(np.argmax(scores, axis=1) == y_val))
+    
+    n_trees = len(tables['feature'])
+    summary = [
+        f"{tree_model.TREE_STAGES} stages x {NUM_CLASSES} classes, depth {tree_model.TREE_DEPTH}, "
+        f"learning rate {tree_model.LEARNING_RATE}",
+        f"Validation accuracy: {float_acc:.2%} (sklearn), {int_acc:.2%} (integer tables)",
+    ]
+    with open(output_path, 'w') as f:
+        f.write(tree_model.render_header(tables, NUM_SAMPLES, NUM_AXES,
+                                         GESTURE_LABELS, summary))
+    
+    console.print(f"   [green]✓[/green] {n_trees} trees, "
+                  f"{tree_model.table_bytes(tables):,} bytes of tables")
+    console.print(f"   [green]✓[/green] Integer accuracy: [bold]{int_acc:.2%}[/bold] "
+                  f"(float {float_acc:.2%})")
+    
+    return {
+        'tables': tables,
+        'float_acc': float_acc,
+        'int_acc': int_acc,
+        'bytes': tree_model.table_bytes(tables),
+        'compares': n_trees * tree_model.TREE_DEPTH,
+    }
+
+
 def export_to_c_header(tflite_model, output_path):
     """Export TFLite model as C header file"""
     header_content = f'''/*
@@ -294,7 +383,8 @@ def export_to_c_header(tflite_model, output_path):
  *
  * Model: Gesture classification (IDLE, WAVE, TAP, CIRCLE)
  * Input: 150 INT8 values (50 samples x 3 axes, flattened)
- * Output: 4 class probabilities (INT8)
+ * Output: 4 class scores (INT8; logits when the softmax was stripped,
+ *         the firmware applies softmax on device)
  * Architecture: Dense(32) -> Dense(16) -> Dense(4)
  * Size: {len(tflite_model)} bytes
  */
@@ -448,6 +538,9 @@ def main():
     # Quantize
     tflite_model = quantize_model(model, X_train)
     
+    # Strip deploy-time dead weight (trailing softmax, identity ops, ...)
+    tflite_model, opt_report = optimize_for_deploy(tflite_model)
+    
     # Export
     console.print("\n[bold cyan]💾 Exporting Model Files[/bold cyan]")
     
@@ -469,12 +562,32 @@ def main():
     table.add_row("gesture_model.h", f"{(src_dir / 'gesture_model.h').stat().st_size:,} bytes")
     console.print(table)
     
+    # Tree backend, and how it compares with the network it replaces
+    tree = train_tree_backend(X_train, y_train, X_val, y_val,
+                              src_dir / 'tree_model.h')
+    tflite_acc = evaluate_tflite(tflite_model, X_val, y_val)
+    macs = sum(int(np.prod(w.shape)) for w in model.get_weights() if w.ndim == 2)
+    
+    table = Table(title="Backend Comparison", box=box.ROUNDED)
+    table.add_column("Metric", style="cyan")
+    table.add_column("TFLM (int8)", justify="right", style="yellow")
+    table.add_column("Trees", justify="right", style="green")
+    table.add_row("Validation accuracy", f"{tflite_acc:.2%}", f"{tree['int_acc']:.2%}")
+    table.add_row("Model flash (bytes)", f"{len(tflite_model):,}", f"{tree['bytes']:,}")
+    table.add_row("Work per window",
+                  f"{macs:,} MACs",
+                  f"{NUM_SAMPLES * NUM_AXES:,} samples, {tree['compares']} compares")
+    console.print(table)
+    console.print("   [dim]Device latency: build with CONFIG_ML_TREE_CLASSIFIER=y and compare "
+                  "the invoke stage (scripts/insn_bench.py, latency_analyzer.py --compare)[/dim]")
+    
     # Final summary
     console.print(Panel.fit(
         "[bold green]✅ Model Training Complete![/bold green]\n\n"
         f"[white]Model Size:[/white] [bold]{len(tflite_model):,}[/bold] bytes\n"
         f"[white]Accuracy:[/white] [bold green]{val_acc:.1%}[/bold green]\n"
-        f"[white]TFLite Ops:[/white] FullyConnected, Relu, Softmax\n\n"
+        f"[white]TFLite Ops:[/white] {', '.join(sorted(opt_report['op_types_after']))}\n"
+        f"[white]Tree Backend:[/white] {tree['bytes']:,} bytes, [bold green]{tree['int_acc']:.1%}[/bold green]\n\n"
         "[dim]Next steps:[/dim]\n"
         "  [cyan]1.[/cyan] west build -b mps2/an385\n"
         "  [cyan]2.[/cyan] west build -t run",
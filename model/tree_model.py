@@ -0,0 +1,283 @@
+#!/usr/bin/env python3
+"""
+Zephyr Edge AI Demo - Gradient-Boosted Tree Backend
+
+Trains a small gradient-boosted tree ensemble on per-axis window
+features and generates src/ml/tree_model.h for the tree classifier
+backend (CONFIG_ML_TREE_CLASSIFIER, see src/ml/tree_classifier.c).
+
+The features are computed from the int8 window the firmware feeds to
+inference, and in integer arithmetic, exactly as tree_classifier.c does:
+training windows in g are first quantized like preprocessing.c (gravity
+removed by the DC filter, 8192 raw per g, * 127/16384, int8 saturation).
+Thresholds are then exact integer comparisons, and emulate() reproduces
+the device's scores bit for bit.
+
+Per axis, over the N samples of a window:
+    sum      sum(x)                          mean * N
+    energy   sum(x^2)
+    var      N * sum(x^2) - sum(x)^2         variance * N^2
+    zc       sign changes between neighbours
+    hi       sum((x[i] - x[i-1])^2)          high band energy
+    lo       sum((x[i] + .. + x[i-3])^2)     low band energy (4-tap box)
+    peak     max(|x|)
+
+Every tree is stored as a complete binary tree of fixed depth (shallower
+branches padded with never-taken splits), so evaluation is a fixed
+sequence of compare-and-index steps without branches.
+
+Used by train_gesture_model.py.
+"""
+
+import numpy as np
+from sklearn.ensemble import GradientBoostingClassifier
+
+# Must match preprocessing.c
+RAW_PER_G = 8192
+QUANT_SCALE = 127.0 / 16384.0
+GRAVITY_AXIS = 2
+
+FEATURE_NAMES = ['sum', 'energy', 'var', 'zc', 'hi', 'lo', 'peak']
+
+# Ensemble shape; stages * classes trees of TREE_DEPTH splits each
+TREE_STAGES = 12
+TREE_DEPTH = 3
+LEARNING_RATE = 0.3
+
+# Leaf values are int16 in units of 2^-shift
+MAX_SCORE_SHIFT = 12
+
+# Padding split: "f > INT32_MAX" is never true, evaluation goes left
+NEVER = np.iinfo(np.int32).max
+
+
+def quantize_windows(X, num_samples, num_axes):
+    """
+    Quantize float windows (in g) like the firmware preprocessing.
+
+    Args:
+        X: (n, num_samples * num_axes) sample-major windows
+
+    Returns:
+        (n, num_samples, num_axes) int64 array of int8 values
+    """
+    g = X.reshape(len(X), num_samples, num_axes).copy()
+    g[:, :, GRAVITY_AXIS] -= 1.0
+    q = np.trunc(np.trunc(g * RAW_PER_G) * QUANT_SCALE)
+    return np.clip(q, -128, 127).astype(np.int64)
+
+
+def extract_features(q):
+    """
+    Integer window features, as computed by tree_classifier.c.
+
+    Args:
+        q: (n, samples, axes) int8 values (any integer dtype)
+
+    Returns:
+        (n, axes * len(FEATURE_NAMES)) int64 array, axis-major
+    """
+    q = q.astype(np.int64)
+    n_samples = q.shape[1]
+    d = q[:, 1:] - q[:, :-1]
+    box = q[:, 3:] + q[:, 2:-1] + q[:, 1:-2] + q[:, :-3]
+
+    s = q.sum(axis=1)
+    energy = (q * q).sum(axis=1)
+    feats = [
+        s,
+        energy,
+        n_samples * energy - s * s,
+        ((q[:, 1:] ^ q[:, :-1]) < 0).sum(axis=1),
+        (d * d).sum(axis=1),
+        (box * box).sum(axis=1),
+        np.abs(q).max(axis=1),
+    ]
+
+    # (features, n, axes) -> (n, axes, features) -> axis-major rows
+    return np.stack(feats).transpose(1, 2, 0).reshape(len(q), -1)
+
+
+def train(features, labels, seed=42):
+    """Fit the gradient-boosted ensemble on integer features."""
+    clf = GradientBoostingClassifier(
+        n_estimators=TREE_STAGES,
+        max_depth=TREE_DEPTH,
+        learning_rate=LEARNING_RATE,
+        init='zero',
+        random_state=seed,
+    )
+    clf.fit(features, labels)
+    return clf
+
+
+def _pad_tree(tree, depth):
+    """
+    Flatten one sklearn regression tree to a complete tree of `depth`.
+
+    Returns:
+        (feature[2^depth - 1], threshold[2^depth - 1], value[2^depth])
+        with node i's children at 2i+1 (f <= thr) and 2i+2 (f > thr)
+    """
+    n_inner = (1 << depth) - 1
+    feature = np.zeros(n_inner, dtype=np.int64)
+    threshold = np.full(n_inner, NEVER, dtype=np.int64)
+    value = np.zeros(1 << depth, dtype=np.float64)
+
+    def walk(node, slot, level):
+        if level == depth:
+            value[slot - n_inner] = tree.value[node][0][0]
+            return
+        if tree.children_left[node] < 0:
+            # Leaf above full depth: a never-taken split repeats it
+            walk(node, 2 * slot + 1, level + 1)
+            walk(node, 2 * slot + 2, level + 1)
+            return
+        feature[slot] = tree.feature[node]
+        # x <= t is x <= floor(t) for integer features
+        threshold[slot] = int(np.floor(tree.threshold[node]))
+        walk(tree.children_left[node], 2 * slot + 1, level + 1)
+        walk(tree.children_right[node], 2 * slot + 2, level + 1)
+
+    walk(0, 0, 0)
+    return feature, threshold, value
+
+
+def export(clf):
+    """
+    Convert a fitted ensemble to integer tables.
+
+    Returns:
+        dict with 'feature', 'threshold', 'leaf', 'cls' arrays and 'shift'
+    """
+    features, thresholds, values, classes = [], [], [], []
+    for stage in clf.estimators_:
+        for cls, est in enumerate(stage):
+            f, t, v = _pad_tree(est.tree_, TREE_DEPTH)
+            features.append(f)
+            thresholds.append(t)
+            values.append(v * clf.learning_rate)
+            classes.append(cls)
+
+    values = np.array(values)
+    peak = max(np.abs(values).max(), 1e-9)
+    shift = MAX_SCORE_SHIFT
+    while shift > 0 and peak * (1 << shift) > np.iinfo(np.int16).max:
+        shift -= 1
+
+    return {
+        'feature': np.array(features),
+        'threshold': np.array(thresholds),
+        'leaf': np.round(values * (1 << shift)).astype(np.int64),
+        'cls': np.array(classes),
+        'shift': shift,
+    }
+
+
+def emulate(tables, features, num_classes):
+    """
+    Integer scores as computed on the device.
+
+    Returns:
+        (n, num_classes) int64 scores in units of 2^-shift
+    """
+    n = len(features)
+    scores = np.zeros((n, num_classes), dtype=np.int64)
+    rows = np.arange(n)
+    n_inner = tables['feature'].shape[1]
+
+    for feat, thr, leaf, cls in zip(tables['feature'], tables['threshold'],
+                                    tables['leaf'], tables['cls']):
+        idx = np.zeros(n, dtype=np.int64)
+        for _ in range(TREE_DEPTH):
+            idx = 2 * idx + 1 + (features[rows, feat[idx]] > thr[idx])
+        scores[:, cls] += leaf[idx - n_inner]
+
+    return scores
+
+
+def table_bytes(tables):
+    """Flash taken by the generated tables (see render_header)."""
+    n_trees, n_inner = tables['feature'].shape
+    return n_trees * (n_inner * (1 + 4) + (n_inner + 1) * 2 + 1)
+
+
+def _c_rows(rows, width):
+    return [f"    {{ {', '.join(f'{v:{width}d}' for v in row)} }},"
+            for row in rows]
+
+
+def render_header(tables, num_samples, num_axes, labels, summary):
+    """
+    Generate tree_model.h.
+
+    Args:
+        summary: comment lines describing the training run
+    """
+    n_trees, n_inner = tables['feature'].shape
+    n_features = num_axes * len(FEATURE_NAMES)
+
+    lines = [
+        '/*',
+        ' * SPDX-License-Identifier: MIT',
+        ' *',
+        ' * Zephyr Edge AI Demo - Gradient-Boosted Tree Model',
+        ' *',
+        ' * Generated by model/train_gesture_model.py; regenerate rather than edit.',
+        ' * Complete binary trees in heap order: node i splits on',
+        ' * features[tree_feature[t][i]] > tree_threshold[t][i] (go to 2i+2, else',
+        ' * 2i+1); leaves add tree_leaf[t][j] to the score of class tree_class[t].',
+        ' * Scores are in units of 2^-TREE_MODEL_SCORE_SHIFT.',
+        ' *',
+    ]
+    lines += [f' * {s}' if s else ' *' for s in summary]
+    lines += [
+        ' */',
+        '',
+        '#ifndef TREE_MODEL_H',
+        '#define TREE_MODEL_H',
+        '',
+        '#include <stdint.h>',
+        '',
+        f'#define TREE_MODEL_WINDOW      {num_samples}',
+        f'#define TREE_MODEL_AXES        {num_axes}',
+        f'#define TREE_MODEL_FEATURES    {n_features}',
+        f'#define TREE_MODEL_CLASSES     {len(labels)}',
+        f'#define TREE_MODEL_TREES       {n_trees}',
+        f'#define TREE_MODEL_DEPTH       {TREE_DEPTH}',
+        f'#define TREE_MODEL_SCORE_SHIFT {tables["shift"]}',
+        '',
+        '/* Feature index: axis * ' + str(len(FEATURE_NAMES)) + ' + one of ' +
+        ', '.join(FEATURE_NAMES) + ' */',
+        '',
+        f'static const uint8_t tree_feature[TREE_MODEL_TREES][{n_inner}] = {{',
+    ]
+    lines += _c_rows(tables['feature'], 2)
+    lines += [
+        '};',
+        '',
+        f'static const int32_t tree_threshold[TREE_MODEL_TREES][{n_inner}] = {{',
+    ]
+    lines += _c_rows(tables['threshold'], 10)
+    lines += [
+        '};',
+        '',
+        f'static const int16_t tree_leaf[TREE_MODEL_TREES][{n_inner + 1}] = {{',
+    ]
+    lines += _c_rows(tables['leaf'], 6)
+    lines += [
+        '};',
+        '',
+        '/* ' + ', '.join(f'{i} = {name}' for i, name in enumerate(labels)) + ' */',
+        'static const uint8_t tree_class[TREE_MODEL_TREES] = {',
+    ]
+    for i in range(0, n_trees, 16):
+        chunk = tables['cls'][i:i + 16]
+        lines.append('    ' + ', '.join(str(c) for c in chunk) + ',')
+    lines += [
+        '};',
+        '',
+        '#endif /* TREE_MODEL_H */',
+        '',
+    ]
+    return '\n'.join(lines)
@@ -0,0 +1,628 @@
+#!/usr/bin/env python3
+"""
+SPDX-License-Identifier: MIT
+
+Zephyr Edge AI Demo - Host Batch Evaluator
+
+Replays recorded accelerometer traces through a host copy of the device
+pipeline: preprocessing.c (DC tracking, window triggering, INT8
+quantization) reimplemented bit-exactly, then the model embedded in the
+firmware run by the TFLite interpreter with its reference kernels.
+Files are processed in parallel, so a change to windowing or
+preprocessing can be judged on hours of data in minutes.
+
+Features:
+- Fixed and onset window triggers, float and fixed-point quantization,
+  parameters read from a build's .config or given on the command line
+- Accuracy, per-class recall and confusion matrix for labeled traces
+- Inferences per second of signal
+- Divergence from device UART captures of the same traces
+- --no-model: window counts only (no TensorFlow needed)
+
+Trace format (CSV with header, raw sensor units, one row per sample):
+    timestamp_us,x,y,z[,label]
+label is a gesture name (IDLE, WAVE, TAP, CIRCLE); traces without it
+are evaluated for inference counts and divergence only. Traces are
+assumed uniformly sampled at the configured rate; CONFIG_ML_RESAMPLE
+is not mirrored.
+
+Float results are bit-exact with a device build that evaluates float
+expressions as written (no FMA contraction of the DC filter, e.g.
+soft-float Cortex-M3 targets); elsewhere, compare with --device-logs.
+
+Usage:
+    python batch_eval.py traces/ --config build/zephyr/.config
+    python batch_eval.py traces/*.csv --quant fixed --output fixed.json
+    python batch_eval.py traces/ --device-logs captures/ --jobs 8
+"""
+
+import argparse
+import csv
+import glob
+import json
+import multiprocessing
+import os
+import re
+import struct
+import sys
+import time
+from collections import deque
+from typing import Any, Dict, List, Optional, Tuple
+
+GESTURE_LABELS = ['IDLE', 'WAVE', 'TAP', 'CIRCLE']
+
+REPO_ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+DEFAULT_MODEL_SOURCE = os.path.join(REPO_ROOT, 'src', 'ml', 'gesture_model.c')
+
+# preprocessing.c constants
+RING_SLACK = 16
+DC_INITIAL = (0.0, 0.0, 8192.0)
+
+# onset_detector.c constants
+ENVELOPE_SHIFT = 2
+FLOOR_SHIFT = 6
+STATE_FRAC_BITS = 8
+
+
+def f32(value: float) -> float:
+    """Round to the nearest float32, as one C float operation would."""
+    return struct.unpack('f', struct.pack('f', value))[0]
+
+
+DC_FILTER_ALPHA = f32(0.95)
+DC_FILTER_BETA = f32(1.0 - DC_FILTER_ALPHA)
+QUANT_SCALE = f32(127.0 / 16384.0)
+
+
+# -----------------------------------------------------------------------------
+# Configuration
+# -----------------------------------------------------------------------------
+
+class PipelineConfig:
+    """Device pipeline parameters (Kconfig defaults)."""
+
+    def __init__(self):
+        self.rate_hz = 100
+        self.window = 50
+        self.trigger = 'fixed'
+        self.pretrigger = 10
+        self.onset_ratio = 300
+        self.onset_min_level = 500
+        self.refractory_ms = 500
+        self.quant = 'float'
+
+    def load_kconfig(self, path: str):
+        """Take the parameters from a build's zephyr/.config."""
+        values: Dict[str, str] = {}
+        with open(path, 'r') as f:
+            for line in f:
+                m = re.match(r'^CONFIG_(\w+)=(.*)$', line.strip())
+                if m:
+                    values[m.group(1)] = m.group(2).strip('"')
+
+        def get_int(name: str, current: int) -> int:
+            return int(values[name], 0) if name in values else current
+
+        self.rate_hz = get_int('SENSOR_SAMPLE_RATE_HZ', self.rate_hz)
+        self.window = get_int('ML_INFERENCE_WINDOW_SIZE', self.window)
+        if values.get('ML_WINDOW_TRIGGER_ONSET') == 'y':
+            self.trigger = 'onset'
+        self.pretrigger = get_int('ML_ONSET_PRETRIGGER_SAMPLES', self.pretrigger)
+        self.onset_ratio = get_int('ML_ONSET_THRESHOLD_RATIO', self.onset_ratio)
+        self.onset_min_level = get_int('ML_ONSET_MIN_LEVEL', self.onset_min_level)
+        self.refractory_ms = get_int('ML_ONSET_REFRACTORY_MS', self.refractory_ms)
+        if values.get('ML_PREPROC_QUANT_FIXED') == 'y':
+            self.quant = 'fixed'
+        if values.get('ML_RESAMPLE') == 'y':
+            print("Warning: CONFIG_ML_RESAMPLE is not mirrored; "
+                  "traces are taken as uniformly sampled", file=sys.stderr)
+
+    def describe(self) -> str:
+        desc = (f"{self.rate_hz} Hz, window {self.window}, "
+                f"{self.trigger} trigger, {self.quant} quantization")
+        if self.trigger == 'onset':
+            desc += (f" (pretrigger {self.pretrigger}, ratio {self.onset_ratio}%, "
+                     f"min {self.onset_min_level}, refractory {self.refractory_ms} ms)")
+        return desc
+
+
+# -----------------------------------------------------------------------------
+# Device pipeline mirror
+# -----------------------------------------------------------------------------
+
+class OnsetDetector:
+    """Integer mirror of onset_detector.c."""
+
+    def __init__(self, cfg: PipelineConfig):
+        self.ratio = cfg.onset_ratio
+        self.min_level = cfg.onset_min_level
+        self.refractory = (cfg.refractory_ms * cfg.rate_hz) // 1000
+        self.envelope_q = 0
+        self.floor_q = 0
+        self.refractory_left = 0
+        self.active = False
+
+    def threshold(self) -> int:
+        floor_raw = (self.floor_q >> STATE_FRAC_BITS) & 0xFFFFFFFF
+        threshold = ((floor_raw * self.ratio) & 0xFFFFFFFF) // 100
+        return max(threshold, self.min_level)
+
+    def update(self, dx: int, dy: int, dz: int) -> bool:
+        energy_q = (abs(dx) + abs(dy) + abs(dz)) << STATE_FRAC_BITS
+        onset = False
+
+        self.envelope_q += (energy_q - self.envelope_q) >> ENVELOPE_SHIFT
+        envelope = (self.envelope_q >> STATE_FRAC_BITS) & 0xFFFFFFFF
+        threshold = self.threshold()
+
+        if self.active:
+            if envelope < (threshold * 3) // 4:
+                self.active = False
+        elif envelope < threshold:
+            self.floor_q += (self.envelope_q - self.floor_q) >> FLOOR_SHIFT
+        elif self.refractory_left == 0:
+            onset = True
+            self.active = True
+            self.refractory_left = self.refractory
+
+        if self.refractory_left > 0 and not onset:
+            self.refractory_left -= 1
+
+        return onset
+
+
+def quantize_window(window: List[Tuple[int, int, int]], dc: List[float],
+                    scheme: str) -> List[int]:
+    """Mirror of preprocess_quantize(): DC removal and INT8 quantization."""
+    out: List[int] = []
+
+    if scheme == 'fixed':
+        dc_i = [int(f32(d + (0.5 if d >= 0.0 else -0.5))) for d in dc]
+        for sample in window:
+            for axis in range(3):
+                t = (sample[axis] - dc_i[axis]) * 127
+                q = t // 16384 if t >= 0 else -((-t) // 16384)
+                out.append(min(max(q, -128), 127))
+    else:
+        for sample in window:
+            for axis in range(3):
+                v = f32(sample[axis] - dc[axis])
+                q = int(f32(v * QUANT_SCALE))
+                out.append(min(max(q, -128), 127))
+
+    return out
+
+
+class Preprocessor:
+    """
+    Mirror of preprocessing.c for the primary view.
+
+    Windows are quantized with the DC estimate at completion: on the
+    device the ML thread reads the window before the next sample arrives.
+    """
+
+    def __init__(self, cfg: PipelineConfig):
+        self.cfg = cfg
+        self.ring_size = cfg.window + RING_SLACK
+        self.history: deque = deque([(0, 0, 0)] * cfg.window, maxlen=cfg.window)
+        self.ring_count = 0
+        self.dc = list(DC_INITIAL)
+        self.onset = OnsetDetector(cfg) if cfg.trigger == 'onset' else None
+        self.samples_to_ready = 0 if self.onset else cfg.window
+
+    def add_sample(self, x: int, y: int, z: int) -> Optional[List[int]]:
+        """
+        Ingest one sample.
+
+        Returns:
+            Quantized window if this sample completed one, else None
+        """
+        raw = (x, y, z)
+        for axis in range(3):
+            self.dc[axis] = f32(f32(DC_FILTER_ALPHA * self.dc[axis]) +
+                                f32(DC_FILTER_BETA * raw[axis]))
+
+        self.history.append(raw)
+        if self.ring_count < self.ring_size:
+            self.ring_count += 1
+
+        onset = False
+        if self.onset is not None:
+            onset = self.onset.update(int(f32(x - self.dc[0])),
+                                      int(f32(y - self.dc[1])),
+                                      int(f32(z - self.dc[2])))
+
+        size = self.cfg.window
+        if onset and self.samples_to_ready == 0:
+            history = min(min(self.cfg.pretrigger, size - 1), self.ring_count - 1)
+            self.samples_to_ready = size - history
+
+        if self.samples_to_ready > 0:
+            self.samples_to_ready -= 1
+            if self.samples_to_ready == 0:
+                if self.onset is None:
+                    self.samples_to_ready = size
+                return quantize_window(list(self.history), self.dc, self.cfg.quant)
+
+        return None
+
+
+# -----------------------------------------------------------------------------
+# Model
+# -----------------------------------------------------------------------------
+
+def load_model_bytes(path: str) -> bytes:
+    """Load a .tflite file, or the model array from gesture_model.c."""
+    if not path.endswith('.c'):
+        with open(path, 'rb') as f:
+            return f.read()
+
+    with open(path, 'r') as f:
+        source = f.read()
+    body = re.search(r'gesture_model_data\[\][^{]*\{(.*?)\};', source, re.S)
+    length = re.search(r'gesture_model_data_len\s*=\s*(\d+)', source)
+    if body is None:
+        raise ValueError(f"No gesture_model_data array in {path}")
+    data = bytes(int(b, 16) for b in re.findall(r'0x([0-9a-fA-F]{2})', body.group(1)))
+    if length and int(length.group(1)) != len(data):
+        raise ValueError(f"{path}: array has {len(data)} bytes, "
+                         f"gesture_model_data_len says {length.group(1)}")
+    return data
+
+
+class ModelRunner:
+    """TFLite interpreter with the device's output post-processing."""
+
+    def __init__(self, model: bytes):
+        import numpy as np
+        self.np = np
+        try:
+            import tensorflow as tf
+            # Reference kernels: the same integer arithmetic as TFLM
+            self.interpreter = tf.lite.Interpreter(
+                model_content=model,
+                experimental_op_resolver_type=(
+                    tf.lite.experimental.OpResolverType.BUILTIN_REF))
+        except ImportError:
+            from tflite_runtime.interpreter import Interpreter
+            self.interpreter = Interpreter(model_content=model)
+        self.interpreter.allocate_tensors()
+
+        inp = self.interpreter.get_input_details()[0]
+        out = self.interpreter.get_output_details()[0]
+        self.input_index = inp['index']
+        self.input_shape = inp['shape']
+        self.output_index = out['index']
+        self.scale, self.zero_point = out['quantization']
+        # inference.cpp: any other quantization means softmax was stripped
+        self.is_logits = not (self.zero_point == -128 and
+                              abs(self.scale - 1.0 / 256.0) < 1e-6)
+
+    def run(self, window: List[int]) -> Tuple[int, float]:
+        """
+        Classify one quantized window.
+
+        Returns:
+            (class index, confidence)
+        """
+        np = self.np
+        data = np.array(window, dtype=np.int8).reshape(self.input_shape)
+        self.interpreter.set_tensor(self.input_index, data)
+        self.interpreter.invoke()
+        raw = self.interpreter.get_tensor(self.output_index).reshape(-1)
+
+        scores = ((raw[:len(GESTURE_LABELS)].astype(np.int32) - self.zero_point)
+                  .astype(np.float32) * np.float32(self.scale))
+        if self.is_logits:
+            scores = np.exp(scores - scores.max())
+            scores = scores / scores.sum()
+
+        best = int(np.argmax(scores))
+        return best, float(scores[best])
+
+
+# -----------------------------------------------------------------------------
+# Per-file evaluation (worker processes)
+# -----------------------------------------------------------------------------
+
+_worker_model: Optional[ModelRunner] = None
+
+
+def worker_init(model: Optional[bytes]):
+    global _worker_model
+    _worker_model = ModelRunner(model) if model is not None else None
+
+
+def window_truth(labels: List[Optional[int]], min_fraction: float) -> Optional[int]:
+    """
+    Ground truth for a window: the most frequent gesture covering at
+    least min_fraction of it, else IDLE. None if samples are unlabeled.
+    """
+    if not labels or labels[-1] is None:
+        return None
+    counts = [0] * len(GESTURE_LABELS)
+    for label in labels:
+        if label is not None:
+            counts[label] += 1
+    best = max(range(1, len(GESTURE_LABELS)), key=lambda c: counts[c])
+    if counts[best] >= min_fraction * len(labels):
+        return best
+    return 0
+
+
+def load_device_log(path: str) -> List[Tuple[int, float]]:
+    """Inference records (class, confidence) from a UART capture."""
+    results = []
+    with open(path, 'r', errors='replace') as f:
+        for line in f:
+            line = line.strip()
+            if not line.startswith('{'):
+                continue
+            try:
+                msg = json.loads(line)
+            except json.JSONDecodeError:
+                continue
+            if msg.get('type') == 'inference' and msg.get('gesture') in GESTURE_LABELS:
+                results.append((GESTURE_LABELS.index(msg['gesture']),
+                                float(msg.get('conf', 0.0))))
+    return results
+
+
+def evaluate_file(job: Tuple[str, PipelineConfig, float, Optional[str]]) -> Dict[str, Any]:
+    """Run one trace through the pipeline mirror and the model."""
+    path, cfg, min_fraction, device_log = job
+    pre = Preprocessor(cfg)
+    labels: deque = deque([None] * cfg.window, maxlen=cfg.window)
+    predictions: List[Tuple[int, float]] = []
+    truths: List[Optional[int]] = []
+    samples = 0
+
+    with open(path, 'r', newline='') as f:
+        reader = csv.DictReader(f)
+        for row in reader:
+            samples += 1
+            label = row.get('label')
+            labels.append(GESTURE_LABELS.index(label.strip().upper())
+                          if label and label.strip().upper() in GESTURE_LABELS
+                          else None)
+
+            window = pre.add_sample(int(row['x']), int(row['y']), int(row['z']))
+            if window is None:
+                continue
+
+            truths.append(window_truth(list(labels), min_fraction))
+            if _worker_model is not None:
+                predictions.append(_worker_model.run(window))
+
+    result: Dict[str, Any] = {
+        'file': path,
+        'samples': samples,
+        'duration_s': samples / cfg.rate_hz,
+        'windows': len(truths),
+        'truths': truths,
+        'predictions': [p[0] for p in predictions],
+    }
+
+    if device_log and _worker_model is not None:
+        device = load_device_log(device_log)
+        compared = min(len(device), len(predictions))
+        mismatches = sum(1 for i in range(compared)
+                         if device[i][0] != predictions[i][0])
+        conf_diff = max((abs(device[i][1] - predictions[i][1])
+                         for i in range(compared)), default=0.0)
+        result['device'] = {
+            'log': device_log,
+            'device_inferences': len(device),
+            'compared': compared,
+            'class_mismatches': mismatches,
+            'max_conf_diff': round(conf_diff, 4),
+        }
+
+    return result
+
+
+# -----------------------------------------------------------------------------
+# Reporting
+# -----------------------------------------------------------------------------
+
+def find_traces(paths: List[str]) -> List[str]:
+    traces = []
+    for path in paths:
+        if os.path.isdir(path):
+            traces.extend(sorted(glob.glob(os.path.join(path, '**', '*.csv'),
+                                           recursive=True)))
+        else:
+            traces.extend(sorted(glob.glob(path)))
+    return traces
+
+
+def find_device_log(trace: str, log_dir: Optional[str]) -> Optional[str]:
+    if not log_dir:
+        return None
+    stem = os.path.splitext(os.path.basename(trace))[0]
+    for ext in ('.log', '.txt', '.jsonl'):
+        candidate = os.path.join(log_dir, stem + ext)
+        if os.path.exists(candidate):
+            return candidate
+    return None
+
+
+def summarize(results: List[Dict[str, Any]], with_model: bool) -> Dict[str, Any]:
+    n = len(GESTURE_LABELS)
+    confusion = [[0] * n for _ in range(n)]
+    samples = sum(r['samples'] for r in results)
+    duration = sum(r['duration_s'] for r in results)
+    windows = sum(r['windows'] for r in results)
+
+    for r in results:
+        for truth, pred in zip(r['truths'], r['predictions']):
+            if truth is not None:
+                confusion[truth][pred] += 1
+
+    labeled = sum(sum(row) for row in confusion)
+    correct = sum(confusion[i][i] for i in range(n))
+
+    summary: Dict[str, Any] = {
+        'files': len(results),
+        'samples': samples,
+        'signal_s': round(duration, 1),
+        'inferences': windows,
+        'inferences_per_s': round(windows / duration, 4) if duration else 0.0,
+    }
+
+    if with_model and labeled:
+        summary['labeled_windows'] = labeled
+        summary['accuracy'] = round(correct / labeled, 4)
+        summary['recall'] = {
+            GESTURE_LABELS[i]: (round(confusion[i][i] / sum(confusion[i]), 4)
+                                if sum(confusion[i]) else None)
+            for i in range(n)
+        }
+        summary['confusion'] = confusion
+
+    device = [r['device'] for r in results if 'device' in r]
+    if device:
+        summary['device'] = {
+            'files': len(device),
+            'divergent_files': sum(1 for d in device
+                                   if d['class_mismatches'] or
+                                   d['compared'] != d['device_inferences']),
+            'compared': sum(d['compared'] for d in device),
+            'class_mismatches': sum(d['class_mismatches'] for d in device),
+            'count_diff': sum(d['device_inferences'] for d in device) -
+                          sum(d['compared'] for d in device),
+            'max_conf_diff': max(d['max_conf_diff'] for d in device),
+        }
+
+    return summary
+
+
+def print_summary(summary: Dict[str, Any], results: List[Dict[str, Any]],
+                  verbose: bool):
+    if verbose:
+        print()
+        print(f"{'file':40s} {'signal_s':>9s} {'inferences':>10s} {'device':>14s}")
+        for r in results:
+            dev = ''
+            if 'device' in r:
+                d = r['device']
+                dev = f"{d['class_mismatches']}/{d['compared']} diff"
+            print(f"{os.path.basename(r['file'])[:40]:40s} "
+                  f"{r['duration_s']:9.1f} {r['windows']:10d} {dev:>14s}")
+
+    print()
+    print(f"Files:            {summary['files']}")
+    print(f"Signal:           {summary['signal_s']:.1f} s ({summary['samples']} samples)")
+    print(f"Inferences:       {summary['inferences']} "
+          f"({summary['inferences_per_s']:.3f} per second of signal)")
+
+    if 'accuracy' in summary:
+        print(f"Accuracy:         {summary['accuracy'] * 100:.2f}% "
+              f"over {summary['labeled_windows']} labeled windows")
+        print("Recall:           " + ', '.join(
+            f"{label} {value * 100:.1f}%" if value is not None else f"{label} -"
+            for label, value in summary['recall'].items()))
+        print()
+        print("Confusion (rows: truth, columns: predicted)")
+        print(' ' * 8 + ''.join(f"{label:>8s}" for label in GESTURE_LABELS))
+        for label, row in zip(GESTURE_LABELS, summary['confusion']):
+            print(f"{label:8s}" + ''.join(f"{v:8d}" for v in row))
+
+    if 'device' in summary:
+        d = summary['device']
+        print()
+        print(f"Device logs:      {d['files']} files, {d['divergent_files']} divergent")
+        print(f"  Class mismatches: {d['class_mismatches']} of {d['compared']} inferences")
+        print(f"  Inference count difference: {d['count_diff']:+d}")
+        print(f"  Max confidence difference: {d['max_conf_diff']:.4f}")
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Evaluate recorded traces through a host copy of the "
+                    "Zephyr Edge AI pipeline"
+    )
+    parser.add_argument('traces', nargs='+',
+                        help='Trace CSV files, globs or directories')
+    parser.add_argument('--config',
+                        help='Build .config to take pipeline parameters from')
+    parser.add_argument('--model', default=DEFAULT_MODEL_SOURCE,
+                        help='.tflite file, or C source with gesture_model_data '
+                             '(default: src/ml/gesture_model.c)')
+    parser.add_argument('--no-model', action='store_true',
+                        help='Only count windows, do not run the model')
+    parser.add_argument('--rate', type=int, help='Sample rate (Hz)')
+    parser.add_argument('--window', type=int, help='Window length (samples)')
+    parser.add_argument('--trigger', choices=['fixed', 'onset'],
+                        help='Window trigger mode')
+    parser.add_argument('--pretrigger', type=int,
+                        help='Onset pre-trigger history (samples)')
+    parser.add_argument('--onset-ratio', type=int,
+                        help='Onset threshold, percent of noise floor')
+    parser.add_argument('--onset-min-level', type=int,
+                        help='Onset minimum envelope level')
+    parser.add_argument('--refractory-ms', type=int,
+                        help='Onset refractory period (ms)')
+    parser.add_argument('--quant', choices=['float', 'fixed'],
+                        help='Quantization scheme')
+    parser.add_argument('--min-label-fraction', type=float, default=0.3,
+                        help='Share of a window a gesture label must cover '
+                             'to be its ground truth (default: 0.3)')
+    parser.add_argument('--device-logs',
+                        help='Directory of UART captures named like the traces')
+    parser.add_argument('--jobs', '-j', type=int, default=os.cpu_count(),
+                        help='Worker processes (default: all CPUs)')
+    parser.add_argument('--output', '-o', help='Write the summary as JSON')
+    parser.add_argument('--verbose', '-v', action='store_true',
+                        help='Per-file results')
+
+    args = parser.parse_args()
+
+    cfg = PipelineConfig()
+    if args.config:
+        cfg.load_kconfig(args.config)
+    for attr, value in (('rate_hz', args.rate), ('window', args.window),
+                        ('trigger', args.trigger), ('pretrigger', args.pretrigger),
+                        ('onset_ratio', args.onset_ratio),
+                        ('onset_min_level', args.onset_min_level),
+                        ('refractory_ms', args.refractory_ms),
+                        ('quant', args.quant)):
+        if value is not None:
+            setattr(cfg, attr, value)
+
+    traces = find_traces(args.traces)
+    if not traces:
+        print("No trace files found")
+        sys.exit(1)
+
+    model = None if args.no_model else load_model_bytes(args.model)
+
+    print(f"Pipeline: {cfg.describe()}")
+    print(f"Traces:   {len(traces)} files, {args.jobs} workers")
+
+    jobs = [(path, cfg, args.min_label_fraction,
+             find_device_log(path, args.device_logs)) for path in traces]
+
+    start = time.time()
+    with multiprocessing.Pool(args.jobs, initializer=worker_init,
+                              initargs=(model,)) as pool:
+        results = pool.map(evaluate_file, jobs, chunksize=1)
+    elapsed = time.time() - start
+
+    summary = summarize(results, model is not None)
+    summary['config'] = vars(cfg)
+    summary['elapsed_s'] = round(elapsed, 1)
+
+    print_summary(summary, results, args.verbose)
+    if elapsed > 0:
+        print(f"\nEvaluated {summary['signal_s']:.0f} s of signal in "
+              f"{elapsed:.1f} s ({summary['signal_s'] / elapsed:.0f}x real time)")
+
+    if args.output:
+        with open(args.output, 'w') as f:
+            json.dump(summary, f, indent=2)
+        print(f"Summary written to {args.output}")
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,321 @@
+#!/usr/bin/env python3
+"""
+SPDX-License-Identifier: MIT
+
+Zephyr Edge AI Demo - FC Kernel Autotuner
+
+Builds the firmware with CONFIG_ML_FC_TUNE=y, runs it on the target and
+writes the fastest fully-connected kernel variant per layer shape to
+src/ml/fc_tuning.h, which the weight streaming backend uses.
+
+The firmware times every variant on one chunk of each layer at boot and
+prints "fctune" records. In QEMU the image runs with -icount, so the
+cycle counter advances with retired instructions and the numbers are
+repeatable instruction counts; on a board (--port) they are real
+cycles. Variants whose output differs from the reference kernel are
+never selected.
+
+Usage:
+    python fc_autotune.py --board mps2/an385
+    python fc_autotune.py --board nrf52840dk/nrf52840 --port /dev/ttyACM0
+    python fc_autotune.py --from-json fctune.json --dry-run
+"""
+
+import argparse
+import json
+import os
+import subprocess
+import sys
+import time
+from collections import defaultdict
+from typing import Dict, List, Optional, Tuple
+
+REPO_ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+TUNING_HEADER = os.path.join(REPO_ROOT, 'src', 'ml', 'fc_tuning.h')
+
+# Variant names as printed by the firmware, and their fc_variant_t names
+VARIANTS = {
+    'reference': 'FC_VARIANT_REFERENCE',
+    'row4': 'FC_VARIANT_ROW_BLOCKED',
+    'coltile': 'FC_VARIANT_COL_BLOCKED',
+    'unroll4': 'FC_VARIANT_UNROLL4',
+    'dualmac': 'FC_VARIANT_DUAL_MAC',
+}
+
+# The board's flash may not have a weights partition; tuning needs none,
+# it times the weights of the linked-in model
+TUNE_CONFIG = [
+    '-DCONFIG_ML_WEIGHT_STREAM=y',
+    '-DCONFIG_ML_WEIGHT_STREAM_PROVISION=y',
+    '-DCONFIG_ML_FC_TUNE=y',
+    '-DCONFIG_OUTPUT_JSON_FORMAT=y',
+]
+
+
+def build(board: str, build_dir: str, iterations: Optional[int]) -> str:
+    """
+    Build the tuning image.
+
+    Returns:
+        Path to zephyr.elf
+    """
+    cmd = ['west', 'build', '-b', board, '-d', build_dir, '-p', 'auto',
+           REPO_ROOT, '--'] + TUNE_CONFIG
+    if iterations:
+        cmd.append(f'-DCONFIG_ML_FC_TUNE_ITERATIONS={iterations}')
+
+    print(f"Building: {' '.join(cmd)}")
+    subprocess.run(cmd, check=True)
+    return os.path.join(build_dir, 'zephyr', 'zephyr.elf')
+
+
+def parse_record(line: str) -> Optional[dict]:
+    """Extract an fctune record from a line of firmware output."""
+    start = line.find('{')
+    if start < 0:
+        return None
+    try:
+        msg = json.loads(line[start:])
+    except json.JSONDecodeError:
+        return None
+    return msg if msg.get('type') == 'fctune' else None
+
+
+def expected_count(records: List[dict]) -> Optional[int]:
+    """Records the firmware will send, once the first one is known."""
+    if not records:
+        return None
+    return records[0]['layers'] * records[0]['variants']
+
+
+def collect_qemu(args, elf: str) -> List[dict]:
+    """Run the image in QEMU and collect fctune records from its console."""
+    cmd = [
+        args.qemu,
+        '-machine', args.machine,
+        '-cpu', args.cpu,
+        '-nographic',
+        # Virtual time follows the instruction count: repeatable cycles
+        '-icount', 'shift=0,align=off,sleep=off',
+        '-kernel', elf,
+    ]
+    print(f"Running: {' '.join(cmd)}")
+
+    records: List[dict] = []
+    deadline = time.monotonic() + args.timeout
+    proc = subprocess.Popen(cmd, stdin=subprocess.DEVNULL,
+                            stdout=subprocess.PIPE,
+                            stderr=subprocess.DEVNULL, text=True)
+    try:
+        for line in proc.stdout:
+            rec = parse_record(line)
+            if rec:
+                records.append(rec)
+            if len(records) == expected_count(records) or \
+               time.monotonic() > deadline:
+                break
+    finally:
+        proc.terminate()
+        proc.wait(timeout=10)
+
+    return records
+
+
+def collect_serial(args) -> List[dict]:
+    """Collect fctune records from a board over serial (reset it after start)."""
+    try:
+        import serial
+    except ImportError:
+        print("pyserial required for --port: pip install pyserial")
+        sys.exit(1)
+
+    records: List[dict] = []
+    deadline = time.monotonic() + args.timeout
+    print(f"Listening on {args.port}; reset the board")
+
+    with serial.Serial(args.port, args.baud, timeout=1) as ser:
+        while time.monotonic() < deadline:
+            line = ser.readline().decode('utf-8', errors='replace')
+            rec = parse_record(line)
+            if rec:
+                records.append(rec)
+            if len(records) == expected_count(records):
+                break
+
+    return records
+
+
+def select_winners(records: List[dict],
+                   margin: float) -> Dict[Tuple[int, int], dict]:
+    """
+    Choose the fastest correct variant per (in, out) shape.
+
+    A variant replaces the reference only if it is at least margin
+    percent faster, so noise on real hardware does not flip the table.
+
+    Returns:
+        {(in, out): {'variant', 'cycles', 'reference'}}
+    """
+    by_shape: Dict[Tuple[int, int], Dict[str, int]] = defaultdict(dict)
+
+    for rec in records:
+        if not rec.get('match'):
+            print(f"  {rec['variant']} output differs on {rec['out']}x{rec['in']}, skipped")
+            continue
+        shape = (rec['in'], rec['out'])
+        cycles = rec['cycles']
+        prev = by_shape[shape].get(rec['variant'])
+        by_shape[shape][rec['variant']] = cycles if prev is None else min(prev, cycles)
+
+    winners = {}
+    for shape, timings in by_shape.items():
+        reference = timings.get('reference')
+        best = min(timings, key=lambda v: (timings[v], v != 'reference'))
+        if reference is not None and best != 'reference' and \
+           timings[best] > reference * (1 - margin / 100):
+            best = 'reference'
+        winners[shape] = {'variant': best, 'cycles': timings[best],
+                          'reference': reference, 'timings': timings}
+
+    return winners
+
+
+def print_results(winners: Dict[Tuple[int, int], dict]):
+    """Print the timings per shape with the winner marked."""
+    names = list(VARIANTS)
+    print()
+    print(f"{'shape':>9s} " + ' '.join(f"{n:>10s}" for n in names) + "  winner")
+    for (in_dim, out_dim), w in sorted(winners.items()):
+        cells = []
+        for n in names:
+            c = w['timings'].get(n)
+            cells.append(f"{c:10d}" if c is not None else f"{'-':>10s}")
+        speedup = (w['reference'] / w['cycles']
+                   if w['reference'] and w['cycles'] else 1.0)
+        print(f"{out_dim:4d}x{in_dim:<4d} " + ' '.join(cells) +
+              f"  {w['variant']} ({speedup:.2f}x)")
+
+
+def render_header(winners: Dict[Tuple[int, int], dict], board: str,
+                  source: str) -> str:
+    """Generate fc_tuning.h."""
+    lines = [
+        '/*',
+        ' * SPDX-License-Identifier: MIT',
+        ' *',
+        ' * Zephyr Edge AI Demo - Fully-Connected Kernel Tuning Table',
+        ' *',
+        ' * Generated by scripts/fc_autotune.py; regenerate rather than edit.',
+        ' * Maps layer shapes (input width, output width) to the fastest kernel',
+        ' * variant measured on the tuning board. The last entry is the default',
+        ' * for shapes that were not tuned.',
+        ' *',
+        f' * Board: {board}',
+        f' * Source: {source}',
+        ' */',
+        '',
+        '#ifndef FC_TUNING_H',
+        '#define FC_TUNING_H',
+        '',
+        '#include "fc_kernels.h"',
+        '',
+        'static const struct fc_tuning_entry fc_tuning_table[] = {',
+    ]
+    for (in_dim, out_dim), w in sorted(winners.items()):
+        comment = f"  /* {w['cycles']} vs {w['reference']} cycles */" \
+            if w['reference'] else ''
+        lines.append(f"    {{ {in_dim}, {out_dim}, {VARIANTS[w['variant']]} }},{comment}")
+    lines += [
+        '    { 0, 0, FC_VARIANT_REFERENCE },',
+        '};',
+        '',
+        '#endif /* FC_TUNING_H */',
+        '',
+    ]
+    return '\n'.join(lines)
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Tune FC kernel variants for Zephyr Edge AI Demo"
+    )
+    parser.add_argument('--board', default='mps2/an385',
+                        help='Zephyr board (default: mps2/an385)')
+    parser.add_argument('--build-dir', default='build_fctune',
+                        help='Build directory (default: build_fctune)')
+    parser.add_argument('--no-build', action='store_true',
+                        help='Use the existing image in --build-dir')
+    parser.add_argument('--iterations', type=int,
+                        help='Runs per variant (CONFIG_ML_FC_TUNE_ITERATIONS)')
+    parser.add_argument('--port',
+                        help='Serial port of a flashed board (default: run in QEMU)')
+    parser.add_argument('--baud', type=int, default=115200,
+                        help='Baud rate (default: 115200)')
+    parser.add_argument('--qemu', default='qemu-system-arm',
+                        help='QEMU binary (default: qemu-system-arm)')
+    parser.add_argument('--machine', default='mps2-an385',
+                        help='QEMU machine (default: mps2-an385)')
+    parser.add_argument('--cpu', default='cortex-m3',
+                        help='QEMU CPU (default: cortex-m3)')
+    parser.add_argument('--timeout', type=int, default=60,
+                        help='Seconds to wait for all results (default: 60)')
+    parser.add_argument('--margin', type=float, default=2.0,
+                        help='Percent a variant must beat the reference by (default: 2)')
+    parser.add_argument('--from-json',
+                        help='Use records saved by an earlier --json instead of running')
+    parser.add_argument('--json',
+                        help='Save the raw fctune records')
+    parser.add_argument('--output', '-o', default=TUNING_HEADER,
+                        help='Header to write (default: src/ml/fc_tuning.h)')
+    parser.add_argument('--dry-run', action='store_true',
+                        help='Print the header instead of writing it')
+
+    args = parser.parse_args()
+
+    if args.from_json:
+        with open(args.from_json, 'r') as f:
+            records = json.load(f)
+        source = os.path.basename(args.from_json)
+    else:
+        if args.port:
+            if not args.no_build:
+                build(args.board, args.build_dir, args.iterations)
+                subprocess.run(['west', 'flash', '-d', args.build_dir], check=True)
+            records = collect_serial(args)
+            source = f'cycles on {args.port}'
+        else:
+            elf = os.path.join(args.build_dir, 'zephyr', 'zephyr.elf')
+            if not args.no_build:
+                elf = build(args.board, args.build_dir, args.iterations)
+            records = collect_qemu(args, elf)
+            source = f'QEMU {args.machine} instruction counts'
+
+    expected = expected_count(records)
+    if not records:
+        print("No fctune records received (does the model stream? see the boot log)")
+        sys.exit(1)
+    if len(records) < expected:
+        print(f"Only {len(records)}/{expected} records received; "
+              f"tuning the shapes that completed")
+
+    if args.json:
+        with open(args.json, 'w') as f:
+            json.dump(records, f, indent=2)
+        print(f"Records written to {args.json}")
+
+    winners = select_winners(records, args.margin)
+    print_results(winners)
+
+    header = render_header(winners, args.board, source)
+    if args.dry_run:
+        print()
+        print(header)
+    else:
+        with open(args.output, 'w') as f:
+            f.write(header)
+        print(f"\nTuning table written to {args.output}; rebuild to use it")
+
+
+if __name__ == '__main__':
+    main()
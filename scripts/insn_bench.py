@@ -0,0 +1,274 @@
+#!/usr/bin/env python3
+"""
+SPDX-License-Identifier: MIT
+
+Zephyr Edge AI Demo - Instruction Count Benchmark
+
+Runs a CONFIG_DEBUG_INSN_MARKERS build in QEMU with a TCG plugin
+(scripts/qemu_plugins/insn_marks.c) that counts retired guest
+instructions between the firmware's stage markers. Unlike wall-clock or
+k_cycle_get_32() numbers under QEMU, the counts do not depend on host
+load, so they can be tracked for regressions in CI.
+
+Features:
+- Builds the plugin against the installed QEMU plugin header
+- Resolves marker addresses from zephyr.elf
+- Runs with -icount so guest timing (and thus control flow) is repeatable
+- Per-stage min/median/mean/max instruction counts
+- JSON results and comparison against a baseline
+
+Usage:
+    python insn_bench.py --build-dir build --duration 20 --output insn.json
+    python insn_bench.py --build-dir build --baseline insn.json --tolerance 2
+"""
+
+import argparse
+import json
+import os
+import shutil
+import statistics
+import subprocess
+import sys
+import tempfile
+from collections import defaultdict
+from typing import Dict, List, Optional
+
+PLUGIN_SOURCE = os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                             'qemu_plugins', 'insn_marks.c')
+
+MARK_PREFIX = 'insn_mark_'
+
+NM_CANDIDATES = ['arm-zephyr-eabi-nm', 'arm-none-eabi-nm', 'nm']
+
+
+def find_nm() -> Optional[str]:
+    """Find an nm that understands the ELF, preferring the Zephyr SDK's."""
+    sdk = os.environ.get('ZEPHYR_SDK_INSTALL_DIR')
+    if sdk:
+        path = os.path.join(sdk, 'arm-zephyr-eabi', 'bin', 'arm-zephyr-eabi-nm')
+        if os.path.exists(path):
+            return path
+    for name in NM_CANDIDATES:
+        path = shutil.which(name)
+        if path:
+            return path
+    return None
+
+
+def read_markers(elf: str) -> Dict[str, Dict[str, int]]:
+    """
+    Resolve marker function addresses.
+
+    Args:
+        elf: Path to zephyr.elf
+
+    Returns:
+        {stage: {'begin': addr, 'end': addr}}
+    """
+    nm = find_nm()
+    if nm is None:
+        raise RuntimeError("nm not found (set ZEPHYR_SDK_INSTALL_DIR)")
+
+    output = subprocess.run([nm, elf], capture_output=True, text=True,
+                            check=True).stdout
+    markers: Dict[str, Dict[str, int]] = defaultdict(dict)
+
+    for line in output.splitlines():
+        parts = line.split()
+        if len(parts) != 3 or not parts[2].startswith(MARK_PREFIX):
+            continue
+        point = parts[2][len(MARK_PREFIX):]
+        stage, _, edge = point.rpartition('_')
+        if edge in ('begin', 'end'):
+            markers[stage][edge] = int(parts[0], 16)
+
+    return {stage: m for stage, m in markers.items()
+            if 'begin' in m and 'end' in m}
+
+
+def build_plugin(include_dir: Optional[str], out_dir: str) -> str:
+    """
+    Compile the TCG plugin.
+
+    Args:
+        include_dir: Directory containing qemu-plugin.h (None: compiler default)
+        out_dir: Directory for the shared object
+
+    Returns:
+        Path to the plugin shared object
+    """
+    cflags = subprocess.run(['pkg-config', '--cflags', 'glib-2.0'],
+                            capture_output=True, text=True,
+                            check=True).stdout.split()
+    plugin = os.path.join(out_dir, 'libinsn_marks.so')
+    cmd = ['cc', '-shared', '-fPIC', '-O2', '-o', plugin, PLUGIN_SOURCE] + cflags
+    if include_dir:
+        cmd.insert(1, f'-I{include_dir}')
+    subprocess.run(cmd, check=True)
+    return plugin
+
+
+def run_qemu(args, elf: str, plugin: str,
+             markers: Dict[str, Dict[str, int]], samples_file: str) -> None:
+    """Run the firmware under QEMU with the plugin for args.duration seconds."""
+    plugin_args = [plugin]
+    for stage, m in sorted(markers.items()):
+        plugin_args.append(f"begin={stage}@{m['begin']:x}")
+        plugin_args.append(f"end={stage}@{m['end']:x}")
+    plugin_args.append(f"out={samples_file}")
+
+    cmd = [
+        args.qemu,
+        '-machine', args.machine,
+        '-cpu', args.cpu,
+        '-nographic',
+        # Virtual time follows the instruction count: repeatable runs
+        '-icount', 'shift=0,align=off,sleep=off',
+        '-plugin', ','.join(plugin_args),
+        '-kernel', elf,
+    ]
+
+    print(f"Running: {' '.join(cmd)}")
+    print(f"Duration: {args.duration}s")
+
+    proc = subprocess.Popen(cmd, stdin=subprocess.DEVNULL,
+                            stdout=subprocess.DEVNULL,
+                            stderr=subprocess.PIPE, text=True)
+    try:
+        proc.wait(timeout=args.duration)
+    except subprocess.TimeoutExpired:
+        # Normal: the firmware never exits. SIGTERM lets QEMU run atexit.
+        proc.terminate()
+        proc.wait(timeout=10)
+
+
+def summarize(samples_file: str) -> Dict[str, Dict[str, float]]:
+    """
+    Compute per-stage statistics from the plugin's sample lines.
+
+    Returns:
+        {stage: {'n', 'min', 'median', 'mean', 'max'}}
+    """
+    counts: Dict[str, List[int]] = defaultdict(list)
+
+    with open(samples_file, 'r') as f:
+        for line in f:
+            parts = line.split()
+            if len(parts) == 2:
+                counts[parts[0]].append(int(parts[1]))
+
+    return {
+        stage: {
+            'n': len(values),
+            'min': min(values),
+            'median': statistics.median(values),
+            'mean': round(statistics.mean(values), 1),
+            'max': max(values),
+        }
+        for stage, values in counts.items()
+    }
+
+
+def print_results(results: Dict[str, Dict[str, float]]):
+    """Print per-stage instruction counts."""
+    print()
+    print(f"{'stage':10s} {'n':>6s} {'min':>10s} {'median':>10s} "
+          f"{'mean':>12s} {'max':>10s}")
+    for stage in sorted(results):
+        r = results[stage]
+        print(f"{stage:10s} {r['n']:6d} {r['min']:10d} {r['median']:10.0f} "
+              f"{r['mean']:12.1f} {r['max']:10d}")
+
+
+def compare(results: Dict[str, Dict[str, float]], baseline_file: str,
+            tolerance: float) -> bool:
+    """
+    Compare median counts against a baseline.
+
+    Returns:
+        True if no stage regressed by more than tolerance percent
+    """
+    with open(baseline_file, 'r') as f:
+        baseline = json.load(f)
+
+    ok = True
+    print()
+    print(f"Against {baseline_file} (tolerance {tolerance:.1f}%):")
+    for stage in sorted(set(results) | set(baseline)):
+        if stage not in results or stage not in baseline:
+            print(f"  {stage:10s} missing in {'run' if stage not in results else 'baseline'}")
+            continue
+        old = baseline[stage]['median']
+        new = results[stage]['median']
+        change = (new - old) / old * 100 if old else 0.0
+        flag = ''
+        if change > tolerance:
+            flag = '  REGRESSION'
+            ok = False
+        print(f"  {stage:10s} {old:10.0f} -> {new:10.0f} ({change:+.2f}%){flag}")
+    return ok
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Per-stage instruction counts for Zephyr Edge AI Demo in QEMU"
+    )
+    parser.add_argument('--build-dir', default='build',
+                        help='Zephyr build directory (default: build)')
+    parser.add_argument('--duration', type=int, default=20,
+                        help='Seconds to run QEMU (default: 20)')
+    parser.add_argument('--qemu', default='qemu-system-arm',
+                        help='QEMU binary (default: qemu-system-arm)')
+    parser.add_argument('--machine', default='mps2-an385',
+                        help='QEMU machine (default: mps2-an385)')
+    parser.add_argument('--cpu', default='cortex-m3',
+                        help='QEMU CPU (default: cortex-m3)')
+    parser.add_argument('--plugin-include',
+                        help='Directory containing qemu-plugin.h')
+    parser.add_argument('--output', '-o',
+                        help='Write results as JSON')
+    parser.add_argument('--baseline',
+                        help='Baseline JSON from an earlier --output')
+    parser.add_argument('--tolerance', type=float, default=1.0,
+                        help='Allowed median increase in percent (default: 1)')
+
+    args = parser.parse_args()
+
+    elf = os.path.join(args.build_dir, 'zephyr', 'zephyr.elf')
+    if not os.path.exists(elf):
+        print(f"ELF not found: {elf}")
+        sys.exit(1)
+
+    markers = read_markers(elf)
+    if not markers:
+        print("No insn_mark_* symbols found (build with CONFIG_DEBUG_INSN_MARKERS=y)")
+        sys.exit(1)
+    print(f"Stages: {', '.join(sorted(markers))}")
+
+    with tempfile.TemporaryDirectory() as tmp:
+        plugin = build_plugin(args.plugin_include, tmp)
+        samples_file = os.path.join(tmp, 'samples.txt')
+        run_qemu(args, elf, plugin, markers, samples_file)
+
+        if not os.path.exists(samples_file):
+            print("Plugin produced no output")
+            sys.exit(1)
+        results = summarize(samples_file)
+
+    if not results:
+        print("No complete stage samples recorded; try a longer --duration")
+        sys.exit(1)
+
+    print_results(results)
+
+    if args.output:
+        with open(args.output, 'w') as f:
+            json.dump(results, f, indent=2, sort_keys=True)
+        print(f"\nResults written to {args.output}")
+
+    if args.baseline and not compare(results, args.baseline, args.tolerance):
+        sys.exit(1)
+
+
+if __name__ == '__main__':
+    main()
@@ -14,18 +14,40 @@ Features:
 - Gesture-specific breakdown
 - Memory usage correlation
 - Export to PDF/PNG
+- A/B comparison of two runs: per-stage and per-gesture median deltas
+  with bootstrap confidence intervals, Mann-Whitney U tests (Holm
+  corrected), throughput and drop-rate changes, regression flags
 
 Usage:
     python latency_analyzer.py --input results.csv --output report.png
+    python latency_analyzer.py --input run.log --save-baseline base.json
+    python latency_analyzer.py --compare base.json new.log
+    python latency_analyzer.py --compare before.csv after.csv --alpha 0.01
 """
 
 import argparse
 import csv
 import json
+import math
+import random
 import sys
 from collections import defaultdict
 from typing import List, Dict, Any, Optional, Tuple
 
+# Per-stage latency samples taken from JSON log records:
+# (record type, field) -> stage name. 'invoke' is the inference latency.
+# Every sample must cover its own inferences: wstream records are means
+# over one debug interval, not running means since boot.
+STAGE_FIELDS = {
+    ('inference', 'latency_us'): 'invoke',
+    ('event', 'delay_us'): 'event_delay',
+    ('wstream', 'read_us'): 'wstream_read',
+    ('wstream', 'stall_us'): 'wstream_stall',
+    ('wstream', 'compute_us'): 'wstream_compute',
+}
+
+BASELINE_VERSION = 1
+
 # Try to import matplotlib (optional)
 try:
     import matplotlib.pyplot as plt
@@ -42,6 +64,15 @@ class LatencyAnalyzer:
         self.latencies: List[int] = []
         self.gestures: Dict[str, List[int]] = defaultdict(list)
         self.memory_usage: List[Tuple[int, int]] = []  # (heap, stack)
+        self.stages: Dict[str, List[float]] = defaultdict(list)
+        self.timestamps: List[int] = []
+        self.sequences: List[int] = []
+        # Totals from summary records: (results, dropped windows + results)
+        self.summary_results = 0
+        self.summary_drops = 0
+        self.has_summary = False
+        # Throughput stored in a baseline (no timestamps there)
+        self.saved_throughput: Optional[float] = None
 
     def load_csv(self, filename: str) -> bool:
         """
@@ -62,6 +93,12 @@ class LatencyAnalyzer:
                     # Extract latency
                     latency = int(row.get('latency_us', 0))
                     self.latencies.append(latency)
+                    self.stages['invoke'].append(latency)
+
+                    if row.get('ts'):
+                        self.timestamps.append(int(row['ts']))
+                    if row.get('seq'):
+                        self.sequences.append(int(row['seq']))
 
                     # Group by gesture
                     gesture = row.get('gesture', 'UNKNOWN')
@@ -96,24 +133,126 @@ class LatencyAnalyzer:
 
             try:
                 msg = json.loads(line)
-                if msg.get('type') == 'inference':
-                    self.data.append(msg)
+            except json.JSONDecodeError:
+                continue
 
-                    latency = msg.get('latency_us', 0)
-                    self.latencies.append(latency)
+            msg_type = msg.get('type')
 
-                    gesture = msg.get('gesture', 'UNKNOWN')
-                    self.gestures[gesture].append(latency)
+            for (rec_type, field), stage in STAGE_FIELDS.items():
+                if msg_type == rec_type and field in msg:
+                    self.stages[stage].append(msg[field])
 
-                    heap = msg.get('heap', 0)
-                    stack = msg.get('stack', 0)
-                    self.memory_usage.append((heap, stack))
+            if msg_type == 'inference':
+                self.data.append(msg)
 
-            except json.JSONDecodeError:
-                pass
+                latency = msg.get('latency_us', 0)
+                self.latencies.append(latency)
+
+                gesture = msg.get('gesture', 'UNKNOWN')
+                self.gestures[gesture].append(latency)
+
+                heap = msg.get('heap', 0)
+                stack = msg.get('stack', 0)
+                self.memory_usage.append((heap, stack))
+
+                if 'ts' in msg:
+                    self.timestamps.append(msg['ts'])
+                if 'seq' in msg:
+                    self.sequences.append(msg['seq'])
+
+            elif msg_type == 'summary':
+                self.has_summary = True
+                self.summary_results += msg.get('n', 0)
+                self.summary_drops += sum(msg.get('drop', []))
 
         print(f"Loaded {len(self.data)} inference records")
 
+    def load_file(self, filename: str) -> bool:
+        """
+        Load a run from a CSV, a JSON-lines log or a saved baseline.
+
+        Args:
+            filename: Path to the run
+
+        Returns:
+            True if loaded successfully
+        """
+        if filename.endswith('.csv'):
+            return self.load_csv(filename)
+
+        try:
+            with open(filename, 'r') as f:
+                text = f.read()
+        except OSError as e:
+            print(f"Error loading {filename}: {e}")
+            return False
+
+        try:
+            doc = json.loads(text)
+        except json.JSONDecodeError:
+            doc = None
+
+        if isinstance(doc, dict) and 'stages' in doc:
+            self.load_baseline(doc)
+            print(f"Loaded baseline {filename}: "
+                  f"{len(self.latencies)} inference samples")
+        else:
+            self.load_json_stream(text.splitlines())
+        return True
+
+    def throughput(self) -> Optional[float]:
+        """Inference results per second over the run, from record timestamps."""
+        if len(self.timestamps) < 2:
+            return self.saved_throughput
+        span_us = max(self.timestamps) - min(self.timestamps)
+        if span_us <= 0:
+            return None
+        return (len(self.timestamps) - 1) * 1e6 / span_us
+
+    def drop_counts(self) -> Optional[Tuple[int, int]]:
+        """
+        Dropped and total results.
+
+        Summary records count device-side drops of windows and results;
+        without them, gaps in the inference sequence numbers count
+        records lost between formatting and the host.
+
+        Returns:
+            (dropped, total), or None without either source
+        """
+        if self.has_summary:
+            return (self.summary_drops,
+                    self.summary_results + self.summary_drops)
+        if len(self.sequences) >= 2:
+            expected = max(self.sequences) - min(self.sequences) + 1
+            return (max(0, expected - len(set(self.sequences))), expected)
+        return None
+
+    def to_baseline(self) -> Dict[str, Any]:
+        """Raw samples and counters for a later --compare."""
+        drops = self.drop_counts()
+        return {
+            'version': BASELINE_VERSION,
+            'stages': {k: v for k, v in self.stages.items() if v},
+            'gestures': dict(self.gestures),
+            'throughput': self.throughput(),
+            'drops': list(drops) if drops else None,
+        }
+
+    def load_baseline(self, doc: Dict[str, Any]):
+        """Restore a run saved with to_baseline()."""
+        for stage, values in doc.get('stages', {}).items():
+            self.stages[stage].extend(values)
+        for gesture, values in doc.get('gestures', {}).items():
+            self.gestures[gesture].extend(values)
+        self.latencies.extend(self.stages.get('invoke', []))
+        self.saved_throughput = doc.get('throughput')
+        drops = doc.get('drops')
+        if drops:
+            self.has_summary = True
+            self.summary_drops = drops[0]
+            self.summary_results = drops[1] - drops[0]
+
     def compute_percentile(self, values: List[int], p: float) -> int:
         """Compute the p-th percentile of values."""
         if not values:
@@ -182,13 +321,8 @@ class LatencyAnalyzer:
         # Per-gesture breakdown
         print("\n## Latency by Gesture (µs)")
         print("-" * 40)
-        print(
-            f"  {
-                'Gesture':<10} {
-                'Count':>8} {
-                'Avg':>10} {
-                    'P50':>10} {
-                        'P95':>10}")
+        print(f"  {'Gesture':<10} {'Count':>8} {'Avg':>10} "
+              f"{'P50':>10} {'P95':>10}")
         print("  " + "-" * 48)
 
         for gesture, latencies in sorted(self.gestures.items()):
@@ -339,6 +473,231 @@ class LatencyAnalyzer:
             plt.show()
 
 
+# =============================================================================
+# A/B comparison
+# =============================================================================
+
+def median(values: List[float]) -> float:
+    """Median of a non-empty list."""
+    v = sorted(values)
+    n = len(v)
+    mid = n // 2
+    return v[mid] if n % 2 else (v[mid - 1] + v[mid]) / 2
+
+
+def bootstrap_median_delta(a: List[float], b: List[float], resamples: int,
+                           confidence: float,
+                           rng: random.Random) -> Tuple[float, float]:
+    """
+    Percentile bootstrap CI for the relative change of the median, b vs a.
+
+    Each resample draws both runs with replacement, so the interval
+    reflects the noise of both.
+
+    Returns:
+        (low, high) in percent
+    """
+    deltas = []
+    for _ in range(resamples):
+        ma = median(rng.choices(a, k=len(a)))
+        mb = median(rng.choices(b, k=len(b)))
+        if ma > 0:
+            deltas.append((mb - ma) / ma * 100)
+    if not deltas:
+        return (0.0, 0.0)
+    deltas.sort()
+    tail = (1 - confidence) / 2
+    low = deltas[int(tail * (len(deltas) - 1))]
+    high = deltas[int(math.ceil((1 - tail) * (len(deltas) - 1)))]
+    return (low, high)
+
+
+def mann_whitney(a: List[float], b: List[float]) -> Tuple[float, float]:
+    """
+    Two-sided Mann-Whitney U test (normal approximation, tie corrected).
+
+    Returns:
+        (p_value, prob_b_greater): the probability that a random sample
+        of b exceeds one of a (ties count half), 0.5 for no shift
+    """
+    n1, n2 = len(a), len(b)
+    pooled = sorted([(x, 0) for x in a] + [(x, 1) for x in b])
+    ranks = [0.0] * len(pooled)
+    tie_term = 0.0
+
+    i = 0
+    while i < len(pooled):
+        j = i
+        while j + 1 < len(pooled) and pooled[j + 1][0] == pooled[i][0]:
+            j += 1
+        rank = (i + j) / 2 + 1
+        for k in range(i, j + 1):
+            ranks[k] = rank
+        t = j - i + 1
+        tie_term += t ** 3 - t
+        i = j + 1
+
+    rank_sum_b = sum(r for r, (_, g) in zip(ranks, pooled) if g == 1)
+    u_b = rank_sum_b - n2 * (n2 + 1) / 2
+    prob_b_greater = u_b / (n1 * n2)
+
+    n = n1 + n2
+    mean_u = n1 * n2 / 2
+    var_u = n1 * n2 / 12 * ((n + 1) - tie_term / (n * (n - 1)))
+    if var_u <= 0:
+        return (1.0, prob_b_greater)
+
+    # Continuity correction towards the mean
+    z = (abs(u_b - mean_u) - 0.5) / math.sqrt(var_u)
+    p_value = math.erfc(max(z, 0.0) / math.sqrt(2))
+    return (min(1.0, p_value), prob_b_greater)
+
+
+def holm(p_values: List[float]) -> List[float]:
+    """Holm-Bonferroni adjusted p-values, in input order."""
+    order = sorted(range(len(p_values)), key=lambda i: p_values[i])
+    adjusted = [1.0] * len(p_values)
+    running = 0.0
+    for rank, i in enumerate(order):
+        running = max(running, (len(p_values) - rank) * p_values[i])
+        adjusted[i] = min(1.0, running)
+    return adjusted
+
+
+def two_proportion_p(x1: int, n1: int, x2: int, n2: int) -> float:
+    """Two-sided p-value of a pooled two-proportion z-test."""
+    if n1 == 0 or n2 == 0:
+        return 1.0
+    pooled = (x1 + x2) / (n1 + n2)
+    se = math.sqrt(pooled * (1 - pooled) * (1 / n1 + 1 / n2))
+    if se == 0:
+        return 1.0
+    z = (x2 / n2 - x1 / n1) / se
+    return math.erfc(abs(z) / math.sqrt(2))
+
+
+def compare_runs(base: LatencyAnalyzer, new: LatencyAnalyzer,
+                 args) -> bool:
+    """
+    Print an A/B comparison of two runs.
+
+    A metric is a regression (improvement) when its Holm-adjusted
+    Mann-Whitney p-value is below alpha, the whole bootstrap CI of the
+    median change lies above (below) zero, and the median moved by more
+    than the tolerance. The CI keeps a significant but tiny shift from
+    being flagged twice over noise; the tolerance sets what is too small
+    to matter.
+
+    Returns:
+        True if nothing regressed
+    """
+    rng = random.Random(args.seed)
+    rows = []
+
+    for stage in sorted(set(base.stages) & set(new.stages)):
+        rows.append(('stage', stage, base.stages[stage], new.stages[stage]))
+    for gesture in sorted(set(base.gestures) & set(new.gestures)):
+        rows.append(('gesture', gesture, base.gestures[gesture],
+                     new.gestures[gesture]))
+
+    results = []
+    for kind, name, a, b in rows:
+        if len(a) < args.min_samples or len(b) < args.min_samples:
+            results.append((kind, name, a, b, None))
+            continue
+        p_value, prob = mann_whitney(a, b)
+        low, high = bootstrap_median_delta(a, b, args.bootstrap,
+                                           args.confidence, rng)
+        results.append((kind, name, a, b, [p_value, prob, low, high]))
+
+    tested = [r for r in results if r[4] is not None]
+    for r, p_adj in zip(tested, holm([r[4][0] for r in tested])):
+        r[4].append(p_adj)
+
+    ci_label = f"{args.confidence * 100:.0f}% CI"
+    print("\n" + "=" * 96)
+    print("A/B LATENCY COMPARISON")
+    print("=" * 96)
+    print(f"  Baseline: {args.compare[0]}")
+    print(f"  New:      {args.compare[1]}")
+    print(f"  Medians in µs; change of the median with bootstrap {ci_label} "
+          f"({args.bootstrap} resamples);")
+    print(f"  p: Mann-Whitney U, Holm-adjusted over {len(tested)} tests; "
+          f"P(new>base): probability of superiority")
+
+    regressions = []
+    last_kind = None
+    for kind, name, a, b, st in results:
+        if kind != last_kind:
+            title = 'Per-stage latency' if kind == 'stage' else 'Invoke latency by gesture'
+            print(f"\n## {title}")
+            print(f"  {'':<16} {'n':>11} {'median':>17} {'change':>8} "
+                  f"{ci_label:>18} {'p':>8} {'P(new>base)':>11}  verdict")
+            print("  " + "-" * 94)
+            last_kind = kind
+
+        ma, mb = median(a), median(b)
+        change = (mb - ma) / ma * 100 if ma else 0.0
+        counts = f"{len(a)}/{len(b)}"
+        medians = f"{ma:.0f} -> {mb:.0f}"
+
+        if st is None:
+            print(f"  {name:<16} {counts:>11} {medians:>17} {change:>+7.2f}% "
+                  f"{'':>18} {'':>8} {'':>11}  too few samples")
+            continue
+
+        _, prob, low, high, p_adj = st
+        verdict = 'no significant change'
+        if p_adj < args.alpha and low > 0 and change > args.tolerance:
+            verdict = 'REGRESSION'
+            regressions.append(f"{kind} {name}")
+        elif p_adj < args.alpha and high < 0 and change < -args.tolerance:
+            verdict = 'improvement'
+        elif p_adj < args.alpha:
+            verdict = 'shift within tolerance'
+
+        ci = f"[{low:+.2f}, {high:+.2f}]%"
+        print(f"  {name:<16} {counts:>11} {medians:>17} {change:>+7.2f}% "
+              f"{ci:>18} {p_adj:>8.2g} {prob:>11.3f}  {verdict}")
+
+    print("\n## Throughput and drops")
+    print("  " + "-" * 94)
+    tp_a, tp_b = base.throughput(), new.throughput()
+    if tp_a and tp_b:
+        tp_change = (tp_b - tp_a) / tp_a * 100
+        print(f"  Throughput: {tp_a:.2f} -> {tp_b:.2f} results/s "
+              f"({tp_change:+.2f}%)")
+    else:
+        print("  Throughput: not available (no timestamps)")
+
+    drops_a, drops_b = base.drop_counts(), new.drop_counts()
+    if drops_a and drops_b:
+        rate_a = drops_a[0] / drops_a[1] * 100 if drops_a[1] else 0.0
+        rate_b = drops_b[0] / drops_b[1] * 100 if drops_b[1] else 0.0
+        p_drop = two_proportion_p(drops_a[0], drops_a[1],
+                                  drops_b[0], drops_b[1])
+        verdict = ''
+        if p_drop < args.alpha and rate_b > rate_a:
+            verdict = '  REGRESSION'
+            regressions.append('drop rate')
+        elif p_drop < args.alpha:
+            verdict = '  improvement'
+        print(f"  Drop rate:  {rate_a:.2f}% ({drops_a[0]}/{drops_a[1]}) -> "
+              f"{rate_b:.2f}% ({drops_b[0]}/{drops_b[1]}), "
+              f"p={p_drop:.2g}{verdict}")
+    else:
+        print("  Drop rate:  not available (no summary records or sequence numbers)")
+
+    print()
+    if regressions:
+        print(f"Regressions: {', '.join(regressions)}")
+    else:
+        print("No significant regressions")
+    print("=" * 96)
+
+    return not regressions
+
+
 def main():
     parser = argparse.ArgumentParser(
         description="Analyze inference latency data from Zephyr Edge AI Demo"
@@ -356,13 +715,74 @@ def main():
         action='store_true',
         help='Skip plot generation (text report only)'
     )
+    parser.add_argument(
+        '--save-baseline',
+        metavar='JSON',
+        help='Save the run\'s samples for a later --compare'
+    )
+    parser.add_argument(
+        '--compare',
+        nargs=2,
+        metavar=('BASE', 'NEW'),
+        help='Compare two runs (CSV, JSON-lines log or saved baseline); '
+             'exits 1 on a significant regression'
+    )
+    parser.add_argument(
+        '--alpha',
+        type=float,
+        default=0.05,
+        help='Significance level after Holm correction (default: 0.05)'
+    )
+    parser.add_argument(
+        '--tolerance',
+        type=float,
+        default=0.0,
+        help='Median change in percent below which a significant shift '
+             'is not flagged (default: 0)'
+    )
+    parser.add_argument(
+        '--confidence',
+        type=float,
+        default=0.95,
+        help='Bootstrap confidence level (default: 0.95)'
+    )
+    parser.add_argument(
+        '--bootstrap',
+        type=int,
+        default=2000,
+        help='Bootstrap resamples (default: 2000)'
+    )
+    parser.add_argument(
+        '--min-samples',
+        type=int,
+        default=10,
+        help='Samples per run needed to test a metric (default: 10)'
+    )
+    parser.add_argument(
+        '--seed',
+        type=int,
+        default=1,
+        help='Bootstrap random seed (default: 1)'
+    )
 
     args = parser.parse_args()
 
+    if args.compare:
+        runs = []
+        for path in args.compare:
+            run = LatencyAnalyzer()
+            if not run.load_file(path):
+                sys.exit(1)
+            runs.append(run)
+        if not runs[0].stages or not runs[1].stages:
+            print("No latency data found")
+            sys.exit(1)
+        sys.exit(0 if compare_runs(runs[0], runs[1], args) else 1)
+
     analyzer = LatencyAnalyzer()
 
     if args.input:
-        if not analyzer.load_csv(args.input):
+        if not analyzer.load_file(args.input):
             sys.exit(1)
     else:
         # Read from stdin
@@ -378,6 +798,11 @@ def main():
     # Print text report
     analyzer.print_report()
 
+    if args.save_baseline:
+        with open(args.save_baseline, 'w') as f:
+            json.dump(analyzer.to_baseline(), f)
+        print(f"Baseline saved to {args.save_baseline}")
+
     # Generate plot
     if not args.no_plot:
         if HAS_MATPLOTLIB:
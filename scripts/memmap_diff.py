@@ -0,0 +1,153 @@
+#!/usr/bin/env python3
+"""
+SPDX-License-Identifier: MIT
+
+Zephyr Edge AI Demo - Memory Map Diff
+
+Compares the runtime memory map ("memmap" and "mem" records emitted with
+CONFIG_DEBUG_MEMMAP) between two UART captures, e.g. from two builds or
+two devices.
+
+Features:
+- Image section sizes (rom, ram, data, bss, noinit) side by side
+- Per-region size and usage with deltas
+- Regions using less than --headroom percent of their size are flagged
+- Non-zero exit on growth above --max-growth bytes (for CI)
+
+Usage:
+    python memmap_diff.py old_capture.log new_capture.log
+    python memmap_diff.py old.log new.log --max-growth 512
+"""
+
+import argparse
+import json
+import sys
+from typing import Any, Dict, Optional, Tuple
+
+IMAGE_FIELDS = ['rom', 'ram', 'data', 'bss', 'noinit']
+
+
+def load_memmap(filename: str) -> Tuple[Dict[str, Any], Dict[str, Dict[str, int]]]:
+    """
+    Extract the last memory map from a capture.
+
+    Args:
+        filename: UART capture (JSON lines, other text is ignored)
+
+    Returns:
+        (image record, regions by name)
+    """
+    image: Dict[str, Any] = {}
+    regions: Dict[str, Dict[str, int]] = {}
+
+    with open(filename, 'r', errors='replace') as f:
+        for line in f:
+            line = line.strip()
+            if not line.startswith('{'):
+                continue
+            try:
+                msg = json.loads(line)
+            except json.JSONDecodeError:
+                continue
+
+            if msg.get('type') == 'memmap':
+                # A new map starts: forget any earlier one (device reboot)
+                image = msg
+                regions = {}
+            elif msg.get('type') == 'mem' and 'name' in msg:
+                regions[msg['name']] = msg
+
+    return image, regions
+
+
+def fmt_delta(old: Optional[int], new: Optional[int]) -> str:
+    """Format a size change."""
+    if old is None or new is None:
+        return ''
+    delta = new - old
+    return f"{delta:+d}" if delta else '0'
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Diff runtime memory maps from two Zephyr Edge AI captures"
+    )
+    parser.add_argument('old', help='Baseline capture')
+    parser.add_argument('new', help='Capture to compare')
+    parser.add_argument(
+        '--headroom', type=float, default=50.0,
+        help='Flag regions using less than this percent of their size '
+             '(default: 50)'
+    )
+    parser.add_argument(
+        '--max-growth', type=int, default=None,
+        help='Exit with status 1 if static RAM grows by more than this '
+             'many bytes'
+    )
+
+    args = parser.parse_args()
+
+    old_image, old_regions = load_memmap(args.old)
+    new_image, new_regions = load_memmap(args.new)
+
+    if not old_image or not new_image:
+        missing = args.old if not old_image else args.new
+        print(f"No memmap record in {missing} (build with CONFIG_DEBUG_MEMMAP=y)")
+        sys.exit(1)
+
+    print(f"Image ({old_image.get('board', '?')} -> {new_image.get('board', '?')})")
+    print(f"  {'section':10s} {'old':>9s} {'new':>9s} {'delta':>8s}")
+    for field in IMAGE_FIELDS:
+        old = old_image.get(field)
+        new = new_image.get(field)
+        print(f"  {field:10s} {old if old is not None else '-':>9} "
+              f"{new if new is not None else '-':>9} {fmt_delta(old, new):>8s}")
+
+    ram_size = new_image.get('ram_size', 0)
+    if ram_size:
+        print(f"  RAM free: {ram_size - new_image.get('ram', 0)} of {ram_size} bytes")
+
+    print()
+    print("Regions")
+    print(f"  {'name':16s} {'size':>8s} {'delta':>8s} {'used':>8s} "
+          f"{'delta':>8s} {'use%':>5s}")
+
+    wasted = []
+    for name in sorted(set(old_regions) | set(new_regions)):
+        old = old_regions.get(name, {})
+        new = new_regions.get(name, {})
+        size = new.get('size')
+        used = new.get('used')
+        pct = ''
+        if size and used is not None:
+            pct = f"{used / size * 100:.0f}"
+            if used / size * 100 < args.headroom:
+                wasted.append((name, size - used))
+
+        status = ''
+        if not new:
+            status = ' (removed)'
+        elif not old:
+            status = ' (new)'
+
+        print(f"  {name:16s} {size if size is not None else '-':>8} "
+              f"{fmt_delta(old.get('size'), size):>8s} "
+              f"{used if used is not None else '-':>8} "
+              f"{fmt_delta(old.get('used'), used):>8s} {pct:>5s}{status}")
+
+    if wasted:
+        print()
+        print(f"Regions below {args.headroom:.0f}% use:")
+        for name, spare in wasted:
+            print(f"  {name}: {spare} bytes spare")
+
+    growth = new_image.get('ram', 0) - old_image.get('ram', 0)
+    if args.max_growth is not None and growth > args.max_growth:
+        print()
+        print(f"FAIL: static RAM grew by {growth} bytes "
+              f"(limit {args.max_growth})")
+        sys.exit(1)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,208 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Zephyr Edge AI Demo - QEMU TCG Instruction Count Plugin
+ *
+ * Counts guest instructions retired between pairs of marker addresses.
+ * Each translated block adds its instruction count to a counter when it
+ * executes; an exec callback on each marker address snapshots the
+ * counter. Every begin/end pair produces one sample line:
+ *
+ *   <stage> <instructions>
+ *
+ * Arguments (repeatable):
+ *   begin=<stage>@<hex address>
+ *   end=<stage>@<hex address>
+ *   out=<file>                   (default: stderr)
+ *
+ * Counts include anything that ran between the markers (interrupts,
+ * preempting threads) plus a constant marker overhead of a few
+ * instructions. Built by scripts/insn_bench.py against the QEMU
+ * plugin header.
+ */
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <qemu-plugin.h>
+
+QEMU_PLUGIN_EXPORT int qemu_plugin_version = QEMU_PLUGIN_VERSION;
+
+#define MAX_MARKS 32
+
+struct mark {
+    uint64_t vaddr;
+    int stage;
+    int is_end;
+};
+
+struct stage {
+    char name[32];
+    uint64_t start;
+    int open;
+};
+
+static struct mark marks[MAX_MARKS];
+static int mark_count;
+
+static struct stage stages[MAX_MARKS];
+static int stage_count;
+
+static FILE *out;
+
+#if QEMU_PLUGIN_VERSION >= 2
+static struct qemu_plugin_scoreboard *insn_board;
+static qemu_plugin_u64 insn_count;
+#define INSNS() qemu_plugin_u64_sum(insn_count)
+#else
+static uint64_t insn_count;
+#define INSNS() (insn_count)
+#endif
+
+static int stage_index(const char *name)
+{
+    for (int i = 0; i < stage_count; i++) {
+        if (strcmp(stages[i].name, name) == 0) {
+            return i;
+        }
+    }
+    if (stage_count == MAX_MARKS) {
+        return -1;
+    }
+    snprintf(stages[stage_count].name, sizeof(stages[0].name), "%s", name);
+    return stage_count++;
+}
+
+static void on_mark(unsigned int vcpu_index, void *udata)
+{
+    const struct mark *m = udata;
+    struct stage *s = &stages[m->stage];
+    uint64_t now = INSNS();
+
+    (void)vcpu_index;
+
+    if (!m->is_end) {
+        s->start = now;
+        s->open = 1;
+    } else if (s->open) {
+        fprintf(out, "%s %" PRIu64 "\n", s->name, now - s->start);
+        s->open = 0;
+    }
+}
+
+static void on_tb_translate(qemu_plugin_id_t id, struct qemu_plugin_tb *tb)
+{
+    size_t n = qemu_plugin_tb_n_insns(tb);
+
+    (void)id;
+
+#if QEMU_PLUGIN_VERSION >= 2
+    qemu_plugin_register_vcpu_tb_exec_inline_per_vcpu(
+        tb, QEMU_PLUGIN_INLINE_ADD_U64, insn_count, n);
+#else
+    qemu_plugin_register_vcpu_tb_exec_inline(
+        tb, QEMU_PLUGIN_INLINE_ADD_U64, &insn_count, n);
+#endif
+
+    for (size_t i = 0; i < n; i++) {
+        struct qemu_plugin_insn *insn = qemu_plugin_tb_get_insn(tb, i);
+        uint64_t vaddr = qemu_plugin_insn_vaddr(insn);
+
+        for (int m = 0; m < mark_count; m++) {
+            if (marks[m].vaddr == vaddr) {
+                qemu_plugin_register_vcpu_insn_exec_cb(
+                    insn, on_mark, QEMU_PLUGIN_CB_NO_REGS, &marks[m]);
+            }
+        }
+    }
+}
+
+static void on_plugin_exit(qemu_plugin_id_t id, void *p)
+{
+    (void)id;
+    (void)p;
+
+    fflush(out);
+    if (out != stderr) {
+        fclose(out);
+    }
+#if QEMU_PLUGIN_VERSION >= 2
+    qemu_plugin_scoreboard_free(insn_board);
+#endif
+}
+
+static int parse_mark(const char *value, int is_end)
+{
+    const char *at = strchr(value, '@');
+    char name[32];
+
+    if (at == NULL || mark_count == MAX_MARKS ||
+        (size_t)(at - value) >= sizeof(name)) {
+        return -1;
+    }
+
+    memcpy(name, value, at - value);
+    name[at - value] = '\0';
+
+    int stage = stage_index(name);
+
+    if (stage < 0) {
+        return -1;
+    }
+
+    /* Thumb symbols have bit 0 set; instruction addresses do not */
+    marks[mark_count].vaddr = strtoull(at + 1, NULL, 16) & ~1ULL;
+    marks[mark_count].stage = stage;
+    marks[mark_count].is_end = is_end;
+    mark_count++;
+    return 0;
+}
+
+QEMU_PLUGIN_EXPORT int qemu_plugin_install(qemu_plugin_id_t id,
+                                           const qemu_info_t *info,
+                                           int argc, char **argv)
+{
+    (void)info;
+
+    out = stderr;
+
+    for (int i = 0; i < argc; i++) {
+        char *arg = argv[i];
+        int ret = 0;
+
+        if (strncmp(arg, "begin=", 6) == 0) {
+            ret = parse_mark(arg + 6, 0);
+        } else if (strncmp(arg, "end=", 4) == 0) {
+            ret = parse_mark(arg + 4, 1);
+        } else if (strncmp(arg, "out=", 4) == 0) {
+            out = fopen(arg + 4, "w");
+            if (out == NULL) {
+                fprintf(stderr, "insn_marks: cannot open %s\n", arg + 4);
+                return -1;
+            }
+        } else {
+            ret = -1;
+        }
+
+        if (ret != 0) {
+            fprintf(stderr, "insn_marks: bad argument '%s'\n", arg);
+            return -1;
+        }
+    }
+
+    if (mark_count == 0) {
+        fprintf(stderr, "insn_marks: no markers given\n");
+        return -1;
+    }
+
+#if QEMU_PLUGIN_VERSION >= 2
+    insn_board = qemu_plugin_scoreboard_new(sizeof(uint64_t));
+    insn_count = qemu_plugin_scoreboard_u64(insn_board);
+#endif
+
+    qemu_plugin_register_vcpu_tb_trans_cb(id, on_tb_translate);
+    qemu_plugin_register_atexit_cb(id, on_plugin_exit, NULL);
+    return 0;
+}
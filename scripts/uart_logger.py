@@ -14,10 +14,12 @@ Features:
 - Real-time display with color formatting
 - CSV export for analysis
 - Statistics summary
+- Reliable link mode: CRC check, reordering, ACK/NACK to the device
 
 Usage:
     python uart_logger.py --port /dev/ttyACM0 --output results.csv
     python uart_logger.py --auto  # Auto-detect port
+    python uart_logger.py --auto --reliable  # CONFIG_OUTPUT_RELIABLE_LINK
 """
 
 import argparse
@@ -25,7 +27,7 @@ import csv
 import json
 import sys
 from datetime import datetime
-from typing import Optional, Dict, List, Any
+from typing import Callable, Optional, Dict, List, Any
 
 try:
     import serial
@@ -56,20 +58,160 @@ GESTURE_COLORS = {
 }
 
 
+def crc16_ccitt(data: bytes, crc: int = 0xFFFF) -> int:
+    """CRC16-CCITT (poly 0x1021, MSB first), matching Zephyr crc16_itu_t."""
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            if crc & 0x8000:
+                crc = ((crc << 1) ^ 0x1021) & 0xFFFF
+            else:
+                crc = (crc << 1) & 0xFFFF
+    return crc
+
+
+class ReliableReceiver:
+    """
+    Host side of the reliable telemetry link (CONFIG_OUTPUT_RELIABLE_LINK).
+
+    Verifies each frame's CRC, delivers frames in link sequence order,
+    acknowledges cumulatively and NACKs gaps so the device resends only
+    the missing frames.
+    """
+
+    CRC_TAG = ',"crc":"'
+
+    def __init__(self, send_command: Callable[[str], None], window: int = 16):
+        """
+        Initialize the receiver.
+
+        Args:
+            send_command: Callback writing one command line to the device
+            window: Device retransmit window (CONFIG_OUTPUT_RELIABLE_WINDOW)
+        """
+        self.send_command = send_command
+        self.window = window
+        self.reset()
+
+        self.frames = 0
+        self.duplicates = 0
+        self.crc_errors = 0
+        self.gaps = 0
+        self.recovered = 0
+        self.lost = 0
+
+    def reset(self):
+        """Forget sequence state (device restarted)."""
+        self.expected: Optional[int] = None
+        self.pending: Dict[int, str] = {}
+        self.requested: set = set()
+
+    def _nack_missing(self, upto: int):
+        """NACK every not yet requested frame in [expected, upto)."""
+        start = None
+        for seq in range(self.expected, upto + 1):
+            missing = (seq < upto and seq not in self.pending
+                       and seq not in self.requested)
+            if missing and start is None:
+                start = seq
+            elif not missing and start is not None:
+                last = seq - 1
+                self.send_command(f"NACK {start}" if start == last
+                                  else f"NACK {start}-{last}")
+                self.requested.update(range(start, seq))
+                self.gaps += 1
+                start = None
+
+    def _flush(self) -> List[str]:
+        """Deliver consecutive frames starting at expected."""
+        out = []
+        while self.expected in self.pending:
+            out.append(self.pending.pop(self.expected))
+            if self.expected in self.requested:
+                self.requested.discard(self.expected)
+                self.recovered += 1
+            self.expected += 1
+        return out
+
+    def receive(self, line: str) -> List[str]:
+        """
+        Process one raw line.
+
+        Args:
+            line: Line read from the UART
+
+        Returns:
+            Lines now deliverable in order (possibly none)
+        """
+        line = line.strip()
+        idx = line.rfind(self.CRC_TAG)
+        if not line.startswith('{"lseq":') or idx < 0:
+            return [line]  # Unframed (log output, banner)
+
+        crc_text = line[idx + len(self.CRC_TAG):idx + len(self.CRC_TAG) + 4]
+        try:
+            ok = int(crc_text, 16) == crc16_ccitt(line[:idx].encode('utf-8'))
+            seq = json.loads(line)['lseq']
+        except (ValueError, KeyError):
+            ok = False
+        if not ok:
+            # Sequence number untrusted: the gap is NACKed when the next
+            # good frame arrives
+            self.crc_errors += 1
+            return []
+
+        self.frames += 1
+
+        if seq == 1 and self.expected not in (None, 1):
+            self.reset()
+        if self.expected is None:
+            self.expected = seq
+
+        if seq < self.expected or seq in self.pending:
+            self.duplicates += 1
+            self.send_command(f"ACK {self.expected - 1}")
+            return []
+
+        self.pending[seq] = line
+
+        if seq > self.expected:
+            self._nack_missing(seq)
+
+            # Frames older than the device window can no longer be resent
+            oldest = seq - self.window + 1
+            if self.expected < oldest:
+                for s in range(self.expected, oldest):
+                    if s not in self.pending:
+                        self.lost += 1
+                        self.requested.discard(s)
+                self.expected = oldest
+
+        out = self._flush()
+        if out:
+            self.send_command(f"ACK {self.expected - 1}")
+        return out
+
+
 class UARTLogger:
     """Collects and processes UART output from the Zephyr demo."""
 
-    def __init__(self, port: str = None, baud: int = 115200):
+    def __init__(self, port: str = None, baud: int = 115200,
+                 reliable: bool = False, window: int = 16):
         """
         Initialize the UART logger.
 
         Args:
             port: Serial port path (e.g., /dev/ttyACM0, COM3)
             baud: Baud rate (default 115200)
+            reliable: Run the reliable link receiver (ACK/NACK)
+            window: Device retransmit window size
         """
         self.port = port
         self.baud = baud
         self.serial: Optional[serial.Serial] = None
+        self.link: Optional[ReliableReceiver] = None
+        if reliable:
+            self.link = ReliableReceiver(self.send_command, window)
 
         self.messages: List[Dict[str, Any]] = []
         self.inference_results: List[Dict[str, Any]] = []
@@ -149,6 +291,19 @@ class UARTLogger:
             self.serial.close()
             print("Disconnected")
 
+    def send_command(self, command: str):
+        """Send one reliable link command line to the device."""
+        if self.serial and self.serial.is_open:
+            self.serial.write((command + '\n').encode('ascii'))
+
+    def handle_line(self, line: str):
+        """Parse and process one raw line, through the link if enabled."""
+        lines = self.link.receive(line) if self.link else [line]
+        for text in lines:
+            msg = self.parse_message(text)
+            if msg:
+                self.process_message(msg)
+
     def parse_message(self, line: str) -> Optional[Dict[str, Any]]:
         """
         Parse a JSON message from the UART output.
@@ -192,6 +347,9 @@ class UARTLogger:
             self.inference_results.append(msg)
             self.print_inference(msg)
 
+        elif msg_type == 'event':
+            self.print_event(msg)
+
         elif msg_type == 'debug':
             self.debug_stats.append(msg)
             self.print_debug(msg)
@@ -203,6 +361,42 @@ class UARTLogger:
         elif msg_type == 'heartbeat':
             self.print_heartbeat(msg)
 
+        elif msg_type == 'link':
+            self.print_link(msg)
+
+        elif msg_type == 'outq':
+            self.print_outq(msg)
+
+        elif msg_type == 'summary':
+            self.print_summary(msg)
+
+        elif msg_type == 'lock':
+            self.print_lock(msg)
+
+        elif msg_type == 'bench':
+            self.print_bench(msg)
+
+        elif msg_type == 'sched':
+            self.print_sched(msg)
+
+        elif msg_type == 'ppbench':
+            self.print_ppbench(msg)
+
+        elif msg_type == 'energy':
+            self.print_energy(msg)
+
+        elif msg_type == 'wstream':
+            self.print_wstream(msg)
+
+        elif msg_type == 'fctune':
+            self.print_fctune(msg)
+
+        elif msg_type == 'memmap':
+            self.print_memmap(msg)
+
+        elif msg_type == 'mem':
+            self.print_mem(msg)
+
         elif msg_type == 'startup':
             self.print_startup(msg)
 
@@ -223,6 +417,22 @@ class UARTLogger:
               f"Conf: {conf:.2f} "
               f"Latency: {latency:5d} µs")
 
+    def print_event(self, msg: Dict[str, Any]):
+        """Print a gesture event from the temporal decoder."""
+        gesture = msg.get('gesture', 'UNKNOWN')
+        conf = msg.get('conf', 0)
+        frames = msg.get('frames', 0)
+        delay = msg.get('delay_us', 0)
+        seq = msg.get('seq', 0)
+
+        color = GESTURE_COLORS.get(gesture, Colors.RESET)
+
+        print(f"{Colors.BOLD}[E{seq:3d}]{Colors.RESET} "
+              f"Event:   {color}{gesture:6s}{Colors.RESET} "
+              f"Conf: {conf:.2f} "
+              f"Frames: {frames} "
+              f"Delay: {delay / 1000:.0f} ms")
+
     def print_debug(self, msg: Dict[str, Any]):
         """Print debug statistics."""
         heap_used = msg.get('heap_used', 0)
@@ -230,13 +440,20 @@ class UARTLogger:
         stack_used = msg.get('stack_used', 0)
         stack_size = msg.get('stack_size', 0)
         cpu = msg.get('cpu_usage', 0)
+        win_drop = msg.get('win_drop', 0)
+        res_drop = msg.get('res_drop', 0)
+        windows = msg.get('windows', 0)
+        rate_hz = msg.get('rate_hz', 0)
 
         stack_pct = (stack_used / stack_size * 100) if stack_size > 0 else 0
 
         print(f"{Colors.CYAN}[DEBUG]{Colors.RESET} "
               f"Heap: {heap_used}/{heap_used + heap_free} "
               f"Stack: {stack_used}/{stack_size} ({stack_pct:.0f}%) "
-              f"CPU: {cpu:.1f}%")
+              f"CPU: {cpu:.1f}% "
+              f"Rate: {rate_hz}Hz "
+              f"Windows: {windows} "
+              f"Drops: win={win_drop} res={res_drop}")
 
     def print_error(self, msg: Dict[str, Any]):
         """Print an error message."""
@@ -245,6 +462,142 @@ class UARTLogger:
 
         print(f"{Colors.RED}[ERROR]{Colors.RESET} Code {code}: {message}")
 
+    def print_link(self, msg: Dict[str, Any]):
+        """Print device-side reliable link counters."""
+        print(f"{Colors.CYAN}[LINK]{Colors.RESET} "
+              f"Sent: {msg.get('sent', 0)} "
+              f"Retx: {msg.get('retx', 0)} "
+              f"ACK/NACK: {msg.get('acks', 0)}/{msg.get('nacks', 0)} "
+              f"Evicted: {msg.get('evicted', 0)} "
+              f"Efficiency: {msg.get('eff', 100.0):.1f}%")
+
+    def print_summary(self, msg: Dict[str, Any]):
+        """Print an aggregated summary record."""
+        labels = ['IDLE', 'WAVE', 'TAP', 'CIRCLE']
+        counts = msg.get('g', [])
+        gestures = " ".join(f"{GESTURE_COLORS.get(name, Colors.RESET)}{name}"
+                            f"{Colors.RESET}={n}"
+                            for name, n in zip(labels, counts))
+
+        # Median latency bucket from the log2 histogram starting at lat_lo
+        lat = msg.get('lat', [])
+        lo = msg.get('lat_lo', 0)
+        median = 0
+        total = sum(lat)
+        seen = 0
+        for i, n in enumerate(lat):
+            seen += n
+            if total and seen * 2 >= total:
+                median = lo << i if lo else (1 << (i - 1) if i else 0)
+                break
+
+        win_drop, res_drop = msg.get('drop', [0, 0])
+        print(f"{Colors.BOLD}[SUMMARY]{Colors.RESET} "
+              f"{msg.get('dur_ms', 0) / 1000:.0f}s "
+              f"n={msg.get('n', 0)} {gestures} "
+              f"Latency: ~{median}+/max {msg.get('lat_max', 0)} µs "
+              f"Drops: win={win_drop} res={res_drop}")
+
+    def print_lock(self, msg: Dict[str, Any]):
+        """Print mutex contention counters."""
+        acq = msg.get('acq', 0)
+        cont = msg.get('cont', 0)
+        pct = (cont / acq * 100) if acq else 0
+        print(f"{Colors.CYAN}[LOCK]{Colors.RESET} "
+              f"{msg.get('name', '?'):18s} "
+              f"acq={acq} contended={cont} ({pct:.1f}%) "
+              f"wait max={msg.get('wait_max', 0)}µs "
+              f"hold max={msg.get('hold_max', 0)}µs "
+              f"by {msg.get('holder', '-')}")
+
+    def print_bench(self, msg: Dict[str, Any]):
+        """Print a scheduling latency benchmark result."""
+        print(f"{Colors.CYAN}[BENCH]{Colors.RESET} "
+              f"{msg.get('prim', '?'):5s} {msg.get('load', '?'):6s} "
+              f"n={msg.get('n', 0)} "
+              f"min={msg.get('min_ns', 0)} "
+              f"mean={msg.get('mean_ns', 0)} "
+              f"max={msg.get('max_ns', 0)} ns")
+
+    def print_sched(self, msg: Dict[str, Any]):
+        """Print a schedulability analysis."""
+        if not msg.get('ok', True):
+            color, status = Colors.RED, 'NOT SCHEDULABLE'
+        elif msg.get('risk'):
+            color, status = Colors.YELLOW, 'at risk'
+        else:
+            color, status = Colors.GREEN, 'ok'
+        tasks = ['sensor', 'ml', 'output', 'debug', 'ml_exec']
+        parts = []
+        for name, c, r, t in zip(tasks, msg.get('c', []), msg.get('r', []),
+                                 msg.get('t', [])):
+            resp = 'inf' if r < 0 else f"{r}"
+            parts.append(f"{name} C={c} R={resp}/{t}")
+        print(f"{color}[SCHED]{Colors.RESET} "
+              f"U={msg.get('u', 0)}% (bound {msg.get('ub', 0)}%) {status}: "
+              f"{', '.join(parts)} us")
+
+    def print_ppbench(self, msg: Dict[str, Any]):
+        """Print a preprocessing kernel benchmark result."""
+        gen = msg.get('gen_min', 0)
+        ker = msg.get('ker_min', 0)
+        speedup = gen / ker if ker else 0.0
+        print(f"{Colors.CYAN}[PPBENCH]{Colors.RESET} "
+              f"win={msg.get('win', 0):3d} {msg.get('scheme', '?'):7s} "
+              f"generic={gen} kernel={ker} cycles "
+              f"({speedup:.2f}x{'' if msg.get('spec') else ', generic'}) "
+              f"diff={msg.get('diff', 0)}")
+
+    def print_energy(self, msg: Dict[str, Any]):
+        """Print an energy estimate."""
+        print(f"{Colors.CYAN}[ENERGY]{Colors.RESET} "
+              f"Avg: {msg.get('avg_uw', 0) / 1000:.2f} mW "
+              f"Per inference: {msg.get('uj_inf', 0)} µJ "
+              f"(ML {msg.get('uj_ml', 0)} µJ) "
+              f"CPU active: {msg.get('active', 0)}% "
+              f"Total: {msg.get('total_mj', 0)} mJ")
+
+    def print_wstream(self, msg: Dict[str, Any]):
+        """Print weight streaming statistics (per-inference averages)."""
+        print(f"{Colors.CYAN}[WSTREAM]{Colors.RESET} "
+              f"{msg.get('layers', 0)} layers, {msg.get('image', 0)} B image, "
+              f"{msg.get('chunks', 0)} chunks/{msg.get('bytes', 0)} B per inference "
+              f"read={msg.get('read_us', 0)}us stall={msg.get('stall_us', 0)}us "
+              f"compute={msg.get('compute_us', 0)}us "
+              f"total={msg.get('total_us', 0)}us "
+              f"overlap={msg.get('overlap', 0)}%")
+
+    def print_fctune(self, msg: Dict[str, Any]):
+        """Print one FC kernel benchmark result."""
+        match = '' if msg.get('match') else f" {Colors.RED}MISMATCH{Colors.RESET}"
+        print(f"{Colors.CYAN}[FCTUNE]{Colors.RESET} "
+              f"layer {msg.get('layer', 0)} {msg.get('out', 0)}x{msg.get('in', 0)} "
+              f"{msg.get('variant', '?'):10s} {msg.get('cycles', 0):8d} cycles"
+              f"{match}")
+
+    def print_memmap(self, msg: Dict[str, Any]):
+        """Print image section sizes."""
+        print(f"{Colors.CYAN}[MEMMAP]{Colors.RESET} "
+              f"ROM: {msg.get('rom', 0)} RAM: {msg.get('ram', 0)}"
+              f"/{msg.get('ram_size', 0)} "
+              f"(data {msg.get('data', 0)}, bss {msg.get('bss', 0)}, "
+              f"noinit {msg.get('noinit', 0)})")
+
+    def print_mem(self, msg: Dict[str, Any]):
+        """Print one memory map region."""
+        used = msg.get('used')
+        usage = f", used {used}" if used is not None else ''
+        print(f"{Colors.CYAN}[MEM]{Colors.RESET} "
+              f"{msg.get('name', '?'):16s} {msg.get('size', 0):6d} B{usage}")
+
+    def print_outq(self, msg: Dict[str, Any]):
+        """Print per-class output queue counters."""
+        parts = []
+        for key in ('inf', 'err', 'hb', 'dbg'):
+            sent, dropped, depth, latency = msg.get(key, [0, 0, 0, 0])
+            parts.append(f"{key}={sent}/-{dropped} (d{depth}, {latency}µs)")
+        print(f"{Colors.CYAN}[OUTQ]{Colors.RESET} " + " ".join(parts))
+
     def print_heartbeat(self, msg: Dict[str, Any]):
         """Print a heartbeat message."""
         uptime = msg.get('uptime_ms', 0)
@@ -289,9 +642,7 @@ class UARTLogger:
                 if self.serial.in_waiting > 0:
                     try:
                         line = self.serial.readline().decode('utf-8', errors='replace')
-                        msg = self.parse_message(line)
-                        if msg:
-                            self.process_message(msg)
+                        self.handle_line(line)
                     except Exception as e:
                         print(f"Error reading line: {e}")
 
@@ -335,6 +686,15 @@ class UARTLogger:
         print(f"Debug stats:    {len(self.debug_stats)}")
         print(f"Errors:         {len(self.errors)}")
 
+        if self.link:
+            print("\nReliable Link (host side):")
+            print(f"  Frames:     {self.link.frames}")
+            print(f"  Gaps:       {self.link.gaps}")
+            print(f"  Recovered:  {self.link.recovered}")
+            print(f"  Lost:       {self.link.lost}")
+            print(f"  Duplicates: {self.link.duplicates}")
+            print(f"  CRC errors: {self.link.crc_errors}")
+
         if self.inference_results:
             # Gesture distribution
             gestures = {}
@@ -360,22 +720,23 @@ class UARTLogger:
                 print(f"  P95:  {latencies[int(len(latencies) * 0.95)]:8d}")
 
 
-def simulate_mode():
+def simulate_mode(reliable: bool = False):
     """
     Simulate UART input for testing without hardware.
 
-    Reads from stdin instead of serial port.
+    Reads from stdin instead of serial port. In reliable mode, link
+    commands are printed instead of sent.
     """
     print("Running in simulation mode (reading from stdin)")
     print("Paste JSON messages or press Ctrl+D to finish\n")
 
-    logger = UARTLogger()
+    logger = UARTLogger(reliable=reliable)
+    if logger.link:
+        logger.link.send_command = lambda cmd: print(f"  -> {cmd}")
 
     try:
         for line in sys.stdin:
-            msg = logger.parse_message(line)
-            if msg:
-                logger.process_message(msg)
+            logger.handle_line(line)
     except KeyboardInterrupt:
         pass
 
@@ -414,11 +775,22 @@ def main():
         action='store_true',
         help='Simulation mode (read from stdin)'
     )
+    parser.add_argument(
+        '--reliable', '-r',
+        action='store_true',
+        help='Reliable link mode: verify CRCs, reorder, send ACK/NACK '
+             '(device built with CONFIG_OUTPUT_RELIABLE_LINK)'
+    )
+    parser.add_argument(
+        '--window',
+        type=int, default=16,
+        help='Device retransmit window (CONFIG_OUTPUT_RELIABLE_WINDOW)'
+    )
 
     args = parser.parse_args()
 
     if args.simulate:
-        simulate_mode()
+        simulate_mode(args.reliable)
         return
 
     if not HAS_SERIAL:
@@ -428,7 +800,9 @@ def main():
 
     logger = UARTLogger(
         port=args.port if not args.auto else None,
-        baud=args.baud
+        baud=args.baud,
+        reliable=args.reliable,
+        window=args.window
     )
 
     if not logger.connect():
@@ -11,6 +11,13 @@
  * Cause: TFLite-Micro interpreter uses ~2.5KB stack space.
  * Fix: Increased ML_STACK_SIZE from 1024 to 4096 bytes.
  * Detection: Enabled STACK_SENTINEL and monitored stack_used metric.
+ *
+ * Stack scans and CPU accounting run only in debug_monitor_check(), on
+ * the debug thread's cadence. Each check publishes a snapshot, and
+ * debug_monitor_get_stats() copies it, so the output thread can attach
+ * health fields to every record without scanning stack memory. The scans
+ * themselves are incremental: a check examines at most STACK_SCAN_BUDGET
+ * bytes per thread (see update_watermark()).
  */
 
 #include "debug_monitor.h"
@@ -18,6 +25,7 @@
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
 #include <zephyr/sys/printk.h>
+#include <string.h>
 
 LOG_MODULE_REGISTER(debug_monitor, CONFIG_LOG_DEFAULT_LEVEL);
 
@@ -31,6 +39,16 @@ LOG_MODULE_REGISTER(debug_monitor, CONFIG_LOG_DEFAULT_LEVEL);
 /** Maximum threads to monitor */
 #define MAX_MONITORED_THREADS 4
 
+/** Stack bytes examined per thread and check */
+#define STACK_SCAN_BUDGET 512
+
+/** First scanned byte; the stack sentinel occupies the first word */
+#ifdef CONFIG_STACK_SENTINEL
+#define STACK_SCAN_START 4
+#else
+#define STACK_SCAN_START 0
+#endif
+
 /* ============================================================================
  * Private Data
  * ============================================================================ */
@@ -40,6 +58,10 @@ struct monitored_thread {
     const char *name;
     size_t stack_size;
     uint32_t peak_usage;
+    /** Next byte of the current watermark scan pass */
+    size_t scan_offset;
+    /** Execution cycles at the previous check */
+    uint64_t last_cycles;
 };
 
 static struct monitored_thread monitored[MAX_MONITORED_THREADS];
@@ -47,8 +69,102 @@ static int monitored_count = 0;
 
 static uint32_t total_stack_warnings = 0;
 static bool monitor_initialized = false;
+
+/** Result of the previous check, for debug_monitor_healthy() */
+static bool last_check_healthy = true;
+
+/* Written only by debug_monitor_check() */
 static uint32_t last_check_time = 0;
-static uint64_t last_cpu_cycles = 0;
+
+/**
+ * Latest published statistics. debug_monitor_check() builds a new
+ * snapshot privately and swaps it in under the lock; readers only copy.
+ */
+static debug_stats_t snapshot;
+static struct k_spinlock snapshot_lock;
+
+/* ============================================================================
+ * Private Functions
+ * ============================================================================ */
+
+/**
+ * @brief Advance a thread's stack watermark scan
+ *
+ * Unused stack still holds the 0xAA fill of CONFIG_INIT_STACKS, and the
+ * watermark is the first byte above the stack limit that does not.
+ * k_thread_stack_space_get() finds it by scanning all unused bytes at
+ * once; here each call examines at most STACK_SCAN_BUDGET bytes and the
+ * next call continues from there. A pass ends at the first used byte and
+ * the next one restarts at the limit, so a deeper watermark shows up
+ * within (unused bytes / STACK_SCAN_BUDGET) + 1 checks.
+ *
+ * @return Bytes used at the last completed pass, 0 if stack info is
+ *         unavailable
+ */
+static uint32_t update_watermark(struct monitored_thread *m)
+{
+#if defined(CONFIG_THREAD_STACK_INFO) && defined(CONFIG_INIT_STACKS)
+    const uint8_t *base = (const uint8_t *)m->thread->stack_info.start;
+    size_t size = m->thread->stack_info.size;
+    size_t end = MIN(m->scan_offset + STACK_SCAN_BUDGET, size);
+    size_t i = m->scan_offset;
+
+    while (i < end && base[i] == 0xAAU) {
+        i++;
+    }
+
+    m->stack_size = size;
+
+    if (i < end) {
+        m->peak_usage = MAX(m->peak_usage, (uint32_t)(size - i));
+        m->scan_offset = STACK_SCAN_START;
+    } else {
+        /* Budget spent, or the whole stack is unused */
+        m->scan_offset = (end < size) ? end : STACK_SCAN_START;
+    }
+
+    return m->peak_usage;
+#else
+    ARG_UNUSED(m);
+    return 0;
+#endif
+}
+
+/**
+ * @brief Monitored threads' share of the CPU since the previous check
+ */
+static float update_cpu_usage(uint32_t now)
+{
+    float usage = 0.0f;
+
+#ifdef CONFIG_SCHED_THREAD_USAGE
+    uint64_t busy = 0;
+    uint32_t delta_time = now - last_check_time;
+
+    for (int i = 0; i < monitored_count; i++) {
+        k_thread_runtime_stats_t rt_stats;
+
+        if (k_thread_runtime_stats_get(monitored[i].thread, &rt_stats) != 0) {
+            continue;
+        }
+        if (monitored[i].last_cycles > 0) {
+            busy += rt_stats.execution_cycles - monitored[i].last_cycles;
+        }
+        monitored[i].last_cycles = rt_stats.execution_cycles;
+    }
+
+    uint64_t total_cycles = (uint64_t)delta_time *
+                            (sys_clock_hw_cycles_per_sec() / 1000);
+    if (total_cycles > 0) {
+        usage = (float)(busy * 100) / (float)total_cycles;
+    }
+#else
+    ARG_UNUSED(now);
+#endif
+
+    last_check_time = now;
+    return usage;
+}
 
 /* ============================================================================
  * Public API Implementation
@@ -65,7 +181,7 @@ int debug_monitor_init(void)
     monitored_count = 0;
     total_stack_warnings = 0;
     last_check_time = k_uptime_get_32();
-    last_cpu_cycles = 0;
+    memset(&snapshot, 0, sizeof(snapshot));
     
     monitor_initialized = true;
     
@@ -88,6 +204,8 @@ int debug_monitor_register_thread(struct k_thread *thread, const char *name)
     monitored[monitored_count].name = name;
     monitored[monitored_count].stack_size = 0;  /* Will be detected */
     monitored[monitored_count].peak_usage = 0;
+    monitored[monitored_count].scan_offset = STACK_SCAN_START;
+    monitored[monitored_count].last_cycles = 0;
     
     monitored_count++;
     
@@ -101,131 +219,80 @@ int debug_monitor_get_stats(debug_stats_t *stats)
         return -EINVAL;
     }
     
-    /* Basic stats */
-    stats->uptime_ms = k_uptime_get_32();
-    
-    /* Heap statistics */
-#ifdef CONFIG_HEAP_MEM_POOL_SIZE
-    /* NOTE: System heap stats API is internal/private in recent Zephyr.
-     * Disabling runtime heap tracking to avoid build errors. 
-     * To use this, one would need to expose _system_heap or use a custom k_heap.
-     */
-    /* struct sys_memory_stats mem_stats;
-    sys_heap_runtime_stats_get(&_system_heap, &mem_stats);
-    stats->heap_used = mem_stats.allocated_bytes;
-    stats->heap_free = mem_stats.free_bytes; */
-    stats->heap_used = 0;
-    stats->heap_free = 0;
-#else
-    stats->heap_used = 0;
-    stats->heap_free = 0;
-#endif
-    
-    /* Get current thread stack info */
-    struct k_thread *current = k_current_get();
-    size_t unused = 0;
-    
-#ifdef CONFIG_THREAD_STACK_INFO
-    int ret = k_thread_stack_space_get(current, &unused);
-    if (ret == 0) {
-        size_t stack_size = current->stack_info.size;
-        stats->stack_size = stack_size;
-        stats->stack_used = stack_size - unused;
-    } else {
-        stats->stack_size = 0;
-        stats->stack_used = 0;
-    }
-#else
-    stats->stack_size = 0;
-    stats->stack_used = 0;
-#endif
-    
-    /* ML thread stack (if registered) */
-    stats->ml_stack_size = 0;
-    stats->ml_stack_used = 0;
-    
-    for (int i = 0; i < monitored_count; i++) {
-        if (monitored[i].thread != NULL) {
-            size_t unused_space = 0;
-#ifdef CONFIG_THREAD_STACK_INFO
-            ret = k_thread_stack_space_get(monitored[i].thread, &unused_space);
-            if (ret == 0) {
-                size_t size = monitored[i].thread->stack_info.size;
-                size_t used = size - unused_space;
-                
-                /* Track peak usage */
-                if (used > monitored[i].peak_usage) {
-                    monitored[i].peak_usage = used;
-                }
-                
-                /* Record ML thread stats */
-                if (strcmp(monitored[i].name, "ml_thread") == 0) {
-                    stats->ml_stack_size = size;
-                    stats->ml_stack_used = used;
-                }
-            }
-#endif
-        }
-    }
-    
-    /* CPU usage estimate (simplified) */
-#ifdef CONFIG_SCHED_THREAD_USAGE
-    k_thread_runtime_stats_t rt_stats;
-    int rv = k_thread_runtime_stats_get(current, &rt_stats);
-    if (rv == 0) {
-        uint32_t now = k_uptime_get_32();
-        uint32_t delta_time = now - last_check_time;
-        if (delta_time > 0 && last_cpu_cycles > 0) {
-            uint64_t delta_cycles = rt_stats.execution_cycles - last_cpu_cycles;
-            uint64_t total_cycles = (uint64_t)delta_time * 
-                                    (sys_clock_hw_cycles_per_sec() / 1000);
-            if (total_cycles > 0) {
-                stats->cpu_usage_percent = 
-                    (float)(delta_cycles * 100) / (float)total_cycles;
-            }
-        }
-        last_cpu_cycles = rt_stats.execution_cycles;
-        last_check_time = now;
-    } else {
-        stats->cpu_usage_percent = 0.0f;
-    }
-#else
-    stats->cpu_usage_percent = 0.0f;
-#endif
-    
-    stats->stack_warnings = total_stack_warnings;
+    k_spinlock_key_t key = k_spin_lock(&snapshot_lock);
+    *stats = snapshot;
+    k_spin_unlock(&snapshot_lock, key);
     
     return 0;
 }
 
 int debug_monitor_check(void)
 {
+    debug_stats_t next = {0};
+    uint32_t worst_permille = 0;
     int issues = 0;
     
     if (!monitor_initialized) {
         return -EINVAL;
     }
     
+    next.uptime_ms = k_uptime_get_32();
+    
+    /* Heap statistics */
+#ifdef CONFIG_HEAP_MEM_POOL_SIZE
+    /* NOTE: System heap stats API is internal/private in recent Zephyr.
+     * Disabling runtime heap tracking to avoid build errors. 
+     * To use this, one would need to expose _system_heap or use a custom k_heap.
+     */
+    /* struct sys_memory_stats mem_stats;
+    sys_heap_runtime_stats_get(&_system_heap, &mem_stats);
+    next.heap_used = mem_stats.allocated_bytes;
+    next.heap_free = mem_stats.free_bytes; */
+#endif
+    
     /* Check all monitored threads */
     for (int i = 0; i < monitored_count; i++) {
-        if (monitored[i].thread != NULL) {
-            int percent = debug_get_stack_percent(monitored[i].thread);
-            
-            if (percent > STACK_WARNING_THRESHOLD) {
-                LOG_WRN("Thread '%s' stack at %d%%", 
-                        monitored[i].name, percent);
-                total_stack_warnings++;
-                issues++;
-            }
-            
-            LOG_DBG("Thread '%s': stack %d%%, peak %u bytes",
-                    monitored[i].name, percent, monitored[i].peak_usage);
+        struct monitored_thread *m = &monitored[i];
+        uint32_t used = update_watermark(m);
+        
+        if (m->stack_size == 0) {
+            continue;
+        }
+        
+        uint32_t permille = (uint32_t)((uint64_t)used * 1000U / m->stack_size);
+        int percent = (int)(permille / 10);
+        
+        if (percent > STACK_WARNING_THRESHOLD) {
+            LOG_WRN("Thread '%s' stack at %d%%", m->name, percent);
+            total_stack_warnings++;
+            issues++;
+        }
+        
+        LOG_DBG("Thread '%s': stack %d%%, peak %u bytes",
+                m->name, percent, m->peak_usage);
+        
+        /* Report the thread closest to overflowing */
+        if (permille >= worst_permille) {
+            worst_permille = permille;
+            next.stack_used = used;
+            next.stack_size = m->stack_size;
+        }
+        
+        /* Record ML thread stats */
+        if (strcmp(m->name, "ml_thread") == 0) {
+            next.ml_stack_size = m->stack_size;
+            next.ml_stack_used = used;
         }
     }
     
-#ifdef CONFIG_HEAP_MEM_POOL_SIZE
-    /* Heap check disabled */
-#endif
+    next.cpu_usage_percent = update_cpu_usage(next.uptime_ms);
+    next.stack_warnings = total_stack_warnings;
+    
+    /* Publish */
+    k_spinlock_key_t key = k_spin_lock(&snapshot_lock);
+    snapshot = next;
+    last_check_healthy = (issues == 0);
+    k_spin_unlock(&snapshot_lock, key);
     
     return (issues > 0) ? -ENOSPC : 0;
 }
@@ -250,7 +317,7 @@ void debug_assert_handler(bool condition, const char *file,
 
 bool debug_monitor_healthy(void)
 {
-    return debug_monitor_check() == 0;
+    return last_check_healthy;
 }
 
 int debug_get_stack_percent(struct k_thread *thread)
@@ -23,9 +23,11 @@ extern "C" {
 
 /**
  * @brief Runtime debug statistics
+ *
+ * Snapshot taken by the most recent debug_monitor_check().
  */
 typedef struct {
-    /** System uptime in milliseconds */
+    /** System uptime when the snapshot was taken (ms) */
     uint32_t uptime_ms;
     
     /** Heap memory used (bytes) */
@@ -34,10 +36,10 @@ typedef struct {
     /** Heap memory free (bytes) */
     uint32_t heap_free;
     
-    /** Main thread stack used (bytes) */
+    /** Stack watermark of the monitored thread closest to overflow (bytes) */
     uint32_t stack_used;
     
-    /** Main thread stack size (bytes) */
+    /** Stack size of that thread (bytes) */
     uint32_t stack_size;
     
     /** ML thread stack used (bytes) */
@@ -46,7 +48,7 @@ typedef struct {
     /** ML thread stack size (bytes) */
     uint32_t ml_stack_size;
     
-    /** Approximate CPU usage (percent) */
+    /** CPU used by the monitored threads since the previous check (percent) */
     float cpu_usage_percent;
     
     /** Number of stack overflow warnings */
@@ -68,7 +70,11 @@ typedef struct {
 int debug_monitor_init(void);
 
 /**
- * @brief Collect current debug statistics
+ * @brief Get the latest debug statistics snapshot
+ *
+ * Copies the snapshot published by debug_monitor_check(); does no
+ * scanning, so it is cheap enough to call per output record from any
+ * thread. All fields are zero before the first check.
  *
  * @param stats Pointer to stats structure to fill
  * @return 0 on success
@@ -78,8 +84,9 @@ int debug_monitor_get_stats(debug_stats_t *stats);
 /**
  * @brief Run periodic monitoring check
  *
- * Should be called periodically (e.g., every 1 second) to
- * update statistics and check for issues.
+ * Should be called periodically (e.g., every 1 second), always from
+ * the same thread, to update stack watermarks and CPU usage, check for
+ * issues and publish a new statistics snapshot.
  *
  * @return 0 if all checks pass, negative if issues detected
  */
@@ -116,13 +123,15 @@ void debug_assert_handler(bool condition, const char *file,
 /**
  * @brief Check if system is healthy
  *
- * @return true if no issues detected
+ * @return true if the most recent debug_monitor_check() found no issues
  */
 bool debug_monitor_healthy(void);
 
 /**
  * @brief Get stack usage percentage for a thread
  *
+ * Scans the thread's stack; use debug_monitor_get_stats() on hot paths.
+ *
  * @param thread Thread to check
  * @return Stack usage as percentage (0-100)
  */
@@ -0,0 +1,158 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Zephyr Edge AI Demo - Energy Estimation
+ *
+ * All intermediate energies are in nJ (uW * us / 1000) in 64 bits, so
+ * a one-second interval at a few mW keeps full precision.
+ */
+
+#include "energy.h"
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <errno.h>
+
+LOG_MODULE_REGISTER(energy, CONFIG_LOG_DEFAULT_LEVEL);
+
+/* ============================================================================
+ * Configuration
+ * ============================================================================ */
+
+#ifndef CONFIG_DEBUG_ENERGY_ACTIVE_UW
+#define CONFIG_DEBUG_ENERGY_ACTIVE_UW 15000
+#endif
+
+#ifndef CONFIG_DEBUG_ENERGY_IDLE_UW
+#define CONFIG_DEBUG_ENERGY_IDLE_UW 1500
+#endif
+
+#ifndef CONFIG_DEBUG_ENERGY_BASE_UW
+#define CONFIG_DEBUG_ENERGY_BASE_UW 500
+#endif
+
+#ifndef CONFIG_DEBUG_ENERGY_UART_NJ_PER_BYTE
+#define CONFIG_DEBUG_ENERGY_UART_NJ_PER_BYTE 100
+#endif
+
+/* ============================================================================
+ * Private Data
+ * ============================================================================ */
+
+/**
+ * @brief Counter values at the start of the interval
+ */
+struct energy_snapshot {
+    uint64_t all_cycles;
+    uint64_t active_cycles;
+    uint64_t ml_cycles;
+    energy_inputs_t inputs;
+};
+
+static const struct k_thread *ml_tids[ENERGY_MAX_ML_THREADS];
+static int ml_tid_count = 0;
+static struct energy_snapshot last;
+static uint64_t total_nj = 0;
+
+/* ============================================================================
+ * Private Functions
+ * ============================================================================ */
+
+static void take_snapshot(struct energy_snapshot *snap)
+{
+    k_thread_runtime_stats_t all = {0};
+    
+    k_thread_runtime_stats_all_get(&all);
+    
+    snap->all_cycles = all.execution_cycles;
+    snap->active_cycles = all.total_cycles;
+    snap->ml_cycles = 0;
+    
+    for (int i = 0; i < ml_tid_count; i++) {
+        k_thread_runtime_stats_t ml = {0};
+        
+        k_thread_runtime_stats_get((k_tid_t)ml_tids[i], &ml);
+        snap->ml_cycles += ml.execution_cycles;
+    }
+}
+
+/**
+ * @brief Energy of a state held for a number of cycles (nJ)
+ */
+static uint64_t state_nj(uint64_t cycles, uint32_t power_uw)
+{
+    return k_cyc_to_us_floor64(cycles) * power_uw / 1000U;
+}
+
+/* ============================================================================
+ * Public API Implementation
+ * ============================================================================ */
+
+void energy_init(const struct k_thread *ml_thread)
+{
+    ml_tid_count = 0;
+    if (ml_thread != NULL) {
+        ml_tids[ml_tid_count++] = ml_thread;
+    }
+    total_nj = 0;
+    take_snapshot(&last);
+    last.inputs = (energy_inputs_t){0};
+    
+    LOG_INF("Energy model: active %d uW, idle %d uW, base %d uW, UART %d nJ/B",
+            CONFIG_DEBUG_ENERGY_ACTIVE_UW, CONFIG_DEBUG_ENERGY_IDLE_UW,
+            CONFIG_DEBUG_ENERGY_BASE_UW, CONFIG_DEBUG_ENERGY_UART_NJ_PER_BYTE);
+}
+
+int energy_add_ml_thread(const struct k_thread *thread)
+{
+    if (ml_tid_count >= ENERGY_MAX_ML_THREADS) {
+        return -ENOMEM;
+    }
+    
+    ml_tids[ml_tid_count++] = thread;
+    
+    /* Restart the interval so the new thread's past cycles do not count */
+    energy_inputs_t inputs = last.inputs;
+    
+    take_snapshot(&last);
+    last.inputs = inputs;
+    return 0;
+}
+
+void energy_update(const energy_inputs_t *inputs, energy_stats_t *stats)
+{
+    struct energy_snapshot now;
+    
+    if (inputs == NULL || stats == NULL) {
+        return;
+    }
+    
+    take_snapshot(&now);
+    now.inputs = *inputs;
+    
+    uint64_t all = now.all_cycles - last.all_cycles;
+    uint64_t active = MIN(now.active_cycles - last.active_cycles, all);
+    uint64_t ml = MIN(now.ml_cycles - last.ml_cycles, active);
+    uint32_t n = now.inputs.inferences - last.inputs.inferences;
+    uint32_t tx = now.inputs.uart_tx_bytes - last.inputs.uart_tx_bytes;
+    uint64_t wall_us = k_cyc_to_us_floor64(all);
+    
+    uint64_t nj = state_nj(active, CONFIG_DEBUG_ENERGY_ACTIVE_UW) +
+                  state_nj(all - active, CONFIG_DEBUG_ENERGY_IDLE_UW) +
+                  state_nj(all, CONFIG_DEBUG_ENERGY_BASE_UW) +
+                  (uint64_t)tx * CONFIG_DEBUG_ENERGY_UART_NJ_PER_BYTE;
+    uint64_t ml_nj = state_nj(ml, CONFIG_DEBUG_ENERGY_ACTIVE_UW);
+    
+    total_nj += nj;
+    
+    stats->interval_ms = (uint32_t)(wall_us / 1000U);
+    stats->avg_power_uw = (wall_us > 0) ? (uint32_t)(nj * 1000U / wall_us) : 0;
+    stats->uj_per_inference = (n > 0) ? (uint32_t)(nj / 1000U / n) : 0;
+    stats->ml_uj_per_inference = (n > 0) ? (uint32_t)(ml_nj / 1000U / n) : 0;
+    stats->active_permille = (all > 0) ? (uint32_t)(active * 1000U / all) : 0;
+    stats->inferences = n;
+    stats->uart_tx_bytes = tx;
+    stats->total_mj = (uint32_t)(total_nj / 1000000U);
+    
+    last = now;
+}
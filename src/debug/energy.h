@@ -0,0 +1,101 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Zephyr Edge AI Demo - Energy Estimation
+ *
+ * Estimates energy from CPU state accounting and a simple per-board
+ * power model (Kconfig):
+ *
+ *   E = P_active * t_active + P_idle * t_idle + P_base * t
+ *       + E_byte * uart_tx_bytes
+ *
+ * Active and idle time come from the scheduler's thread runtime
+ * statistics. The ML thread's own cycles give the marginal energy of an
+ * inference on top of the system's standing consumption.
+ */
+
+#ifndef ENERGY_H
+#define ENERGY_H
+
+#include <zephyr/kernel.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Threads whose cycles count as inference */
+#define ENERGY_MAX_ML_THREADS 2
+
+/**
+ * @brief Counters sampled by the caller for one interval
+ */
+typedef struct {
+    /** Cumulative inference count */
+    uint32_t inferences;
+    
+    /** Cumulative UART bytes transmitted */
+    uint32_t uart_tx_bytes;
+} energy_inputs_t;
+
+/**
+ * @brief Energy estimate for one interval
+ */
+typedef struct {
+    /** Interval length (ms) */
+    uint32_t interval_ms;
+    
+    /** Average power over the interval (uW) */
+    uint32_t avg_power_uw;
+    
+    /** System energy per inference, all consumers (uJ) */
+    uint32_t uj_per_inference;
+    
+    /** ML thread CPU energy per inference (uJ) */
+    uint32_t ml_uj_per_inference;
+    
+    /** CPU active share in tenths of a percent */
+    uint32_t active_permille;
+    
+    /** Inferences in the interval */
+    uint32_t inferences;
+    
+    /** UART bytes in the interval */
+    uint32_t uart_tx_bytes;
+    
+    /** Energy since init (mJ) */
+    uint32_t total_mj;
+} energy_stats_t;
+
+/**
+ * @brief Start accounting
+ *
+ * @param ml_thread Thread whose cycles are attributed to inference
+ */
+void energy_init(const struct k_thread *ml_thread);
+
+/**
+ * @brief Attribute another thread's cycles to inference
+ *
+ * For inference split across threads (the asynchronous executor runs
+ * the model while the ML thread prepares windows). Call after
+ * energy_init().
+ *
+ * @param thread Additional ML thread
+ * @return 0 on success, -ENOMEM if ENERGY_MAX_ML_THREADS are registered
+ */
+int energy_add_ml_thread(const struct k_thread *thread);
+
+/**
+ * @brief Close the current interval and estimate its energy
+ *
+ * @param inputs Cumulative counters at the end of the interval
+ * @param[out] stats Estimate for the interval
+ */
+void energy_update(const energy_inputs_t *inputs, energy_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ENERGY_H */
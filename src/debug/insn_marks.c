@@ -0,0 +1,26 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Zephyr Edge AI Demo - Instruction Count Markers
+ *
+ * The plugin matches on each function's entry address, found by symbol
+ * name in zephyr.elf. The empty asm with a memory clobber keeps the
+ * compiler from treating the functions as pure and dropping the calls.
+ */
+
+#include "insn_marks.h"
+
+#include <zephyr/kernel.h>
+
+#define DEFINE_INSN_MARK(point)                          \
+    __noinline void insn_mark_##point(void)              \
+    {                                                    \
+        __asm__ volatile("" ::: "memory");               \
+    }
+
+DEFINE_INSN_MARK(preproc_begin)
+DEFINE_INSN_MARK(preproc_end)
+DEFINE_INSN_MARK(invoke_begin)
+DEFINE_INSN_MARK(invoke_end)
+DEFINE_INSN_MARK(output_begin)
+DEFINE_INSN_MARK(output_end)
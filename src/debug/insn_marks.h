@@ -0,0 +1,46 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Zephyr Edge AI Demo - Instruction Count Markers
+ *
+ * Empty, never-inlined functions called at pipeline stage boundaries.
+ * Under QEMU, scripts/insn_bench.py loads a TCG plugin that counts the
+ * instructions retired between each stage's begin and end marker, which
+ * is independent of host load and timer jitter. On hardware the markers
+ * cost one call each; without CONFIG_DEBUG_INSN_MARKERS they compile
+ * away.
+ *
+ * Stages: preproc (window normalization and quantization), invoke
+ * (model or synthetic inference) and output (result formatting).
+ */
+
+#ifndef INSN_MARKS_H
+#define INSN_MARKS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef CONFIG_DEBUG_INSN_MARKERS
+
+void insn_mark_preproc_begin(void);
+void insn_mark_preproc_end(void);
+void insn_mark_invoke_begin(void);
+void insn_mark_invoke_end(void);
+void insn_mark_output_begin(void);
+void insn_mark_output_end(void);
+
+/** Call the marker for a stage boundary, e.g. INSN_MARK(invoke_begin) */
+#define INSN_MARK(point) insn_mark_##point()
+
+#else
+
+#define INSN_MARK(point) do { } while (0)
+
+#endif /* CONFIG_DEBUG_INSN_MARKERS */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INSN_MARKS_H */
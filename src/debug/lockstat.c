@@ -0,0 +1,146 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Zephyr Edge AI Demo - Mutex Contention Profiler
+ *
+ * Every lock attempt first tries K_NO_WAIT; only a failed try counts as
+ * contended and is timed while blocking. Hold time is measured from the
+ * outermost lock to the matching unlock (k_mutex is recursive).
+ * Statistics are updated while the mutex is held, so no extra lock is
+ * needed on the fast path.
+ */
+
+#include "lockstat.h"
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+
+LOG_MODULE_REGISTER(lockstat, CONFIG_LOG_DEFAULT_LEVEL);
+
+/* ============================================================================
+ * Private Data
+ * ============================================================================ */
+
+/** Registered locks, most recently first used at the head */
+static struct lockstat_mutex *registry = NULL;
+static struct k_spinlock registry_lock;
+
+/* ============================================================================
+ * Private Functions
+ * ============================================================================ */
+
+/**
+ * @brief Add a lock to the registry on its first acquisition
+ *
+ * Caller holds m->mutex.
+ */
+static void register_lock(struct lockstat_mutex *m)
+{
+    k_spinlock_key_t key = k_spin_lock(&registry_lock);
+    
+    m->next = registry;
+    registry = m;
+    m->registered = true;
+    
+    k_spin_unlock(&registry_lock, key);
+}
+
+/**
+ * @brief Name of the current thread for holder reporting
+ */
+static const char *current_thread_name(void)
+{
+    const char *name = k_thread_name_get(k_current_get());
+    
+    return (name != NULL && name[0] != '\0') ? name : "?";
+}
+
+/* ============================================================================
+ * Public API Implementation
+ * ============================================================================ */
+
+int lockstat_mutex_lock(struct lockstat_mutex *m, k_timeout_t timeout)
+{
+    uint32_t wait_us = 0;
+    bool contended = false;
+    int ret = k_mutex_lock(&m->mutex, K_NO_WAIT);
+    
+    if (ret != 0 && !K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+        uint32_t start = k_cycle_get_32();
+        
+        contended = true;
+        ret = k_mutex_lock(&m->mutex, timeout);
+        wait_us = k_cyc_to_us_floor32(k_cycle_get_32() - start);
+    }
+    
+    if (ret != 0) {
+        /* Not holding the mutex: racy, but timeouts are rare and only
+         * used for reporting */
+        m->timeouts++;
+        return ret;
+    }
+    
+    if (!m->registered) {
+        register_lock(m);
+    }
+    
+    m->acquisitions++;
+    if (contended) {
+        m->contended++;
+        profile_hist_record(&m->wait_us, wait_us);
+    }
+    
+    if (m->mutex.lock_count == 1) {
+        m->hold_start = k_cycle_get_32();
+    }
+    
+    return 0;
+}
+
+int lockstat_mutex_unlock(struct lockstat_mutex *m)
+{
+    if (m->mutex.lock_count == 1 && m->mutex.owner == k_current_get()) {
+        uint32_t hold_us = k_cyc_to_us_floor32(k_cycle_get_32() - m->hold_start);
+        
+        if (hold_us > m->max_hold_us) {
+            m->max_hold_us = hold_us;
+            m->max_holder = current_thread_name();
+        }
+    }
+    
+    return k_mutex_unlock(&m->mutex);
+}
+
+bool lockstat_get(int index, lockstat_info_t *info)
+{
+    struct lockstat_mutex *m;
+    
+    if (info == NULL || index < 0) {
+        return false;
+    }
+    
+    k_spinlock_key_t key = k_spin_lock(&registry_lock);
+    m = registry;
+    while (m != NULL && index-- > 0) {
+        m = m->next;
+    }
+    k_spin_unlock(&registry_lock, key);
+    
+    if (m == NULL) {
+        return false;
+    }
+    
+    /* Take the raw mutex so the copy is consistent without being
+     * counted as an acquisition */
+    k_mutex_lock(&m->mutex, K_FOREVER);
+    info->name = m->name;
+    info->acquisitions = m->acquisitions;
+    info->contended = m->contended;
+    info->timeouts = m->timeouts;
+    info->wait_us = m->wait_us;
+    info->max_hold_us = m->max_hold_us;
+    info->max_holder = (m->max_holder != NULL) ? m->max_holder : "-";
+    k_mutex_unlock(&m->mutex);
+    
+    return true;
+}
@@ -0,0 +1,129 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Zephyr Edge AI Demo - Mutex Contention Profiler
+ *
+ * Drop-in wrapper for the pipeline's shared mutexes. With
+ * CONFIG_DEBUG_LOCKSTAT each lock records acquisitions, contended
+ * acquisitions, a log2 wait-time histogram and its longest hold with
+ * the holding thread; without it the wrapper compiles to plain
+ * k_mutex calls.
+ *
+ * Usage:
+ *   static LOCKSTAT_MUTEX_DEFINE(my_mutex);
+ *   lockstat_mutex_lock(&my_mutex, K_FOREVER);
+ *   lockstat_mutex_unlock(&my_mutex);
+ */
+
+#ifndef LOCKSTAT_H
+#define LOCKSTAT_H
+
+#include "timing.h"
+#include <zephyr/kernel.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef CONFIG_DEBUG_LOCKSTAT
+
+/**
+ * @brief Instrumented mutex
+ */
+struct lockstat_mutex {
+    /** Underlying kernel mutex */
+    struct k_mutex mutex;
+    
+    /** Lock name used in telemetry */
+    const char *name;
+    
+    /** Next registered lock */
+    struct lockstat_mutex *next;
+    
+    /** Set once the lock is on the registry list */
+    bool registered;
+    
+    /** Cycle count when the current outermost hold started */
+    uint32_t hold_start;
+    
+    /** Successful acquisitions */
+    uint32_t acquisitions;
+    
+    /** Acquisitions that had to wait */
+    uint32_t contended;
+    
+    /** Lock attempts that timed out */
+    uint32_t timeouts;
+    
+    /** Wait time of contended acquisitions (us) */
+    profile_hist_t wait_us;
+    
+    /** Longest hold (us) */
+    uint32_t max_hold_us;
+    
+    /** Thread that held the lock longest */
+    const char *max_holder;
+};
+
+/**
+ * @brief Snapshot of one lock's statistics
+ */
+typedef struct {
+    const char *name;
+    uint32_t acquisitions;
+    uint32_t contended;
+    uint32_t timeouts;
+    profile_hist_t wait_us;
+    uint32_t max_hold_us;
+    const char *max_holder;
+} lockstat_info_t;
+
+#define LOCKSTAT_MUTEX_DEFINE(var)                      \
+    struct lockstat_mutex var = {                       \
+        .mutex = Z_MUTEX_INITIALIZER(var.mutex),        \
+        .name = #var,                                   \
+    }
+
+/**
+ * @brief Lock an instrumented mutex
+ *
+ * @param m Mutex
+ * @param timeout Maximum wait
+ * @return 0 on success, negative error code as k_mutex_lock()
+ */
+int lockstat_mutex_lock(struct lockstat_mutex *m, k_timeout_t timeout);
+
+/**
+ * @brief Unlock an instrumented mutex
+ *
+ * @param m Mutex
+ * @return 0 on success, negative error code as k_mutex_unlock()
+ */
+int lockstat_mutex_unlock(struct lockstat_mutex *m);
+
+/**
+ * @brief Get statistics of the n-th lock used so far
+ *
+ * Locks appear once they have been acquired at least once.
+ *
+ * @param index Lock index (0-based)
+ * @param[out] info Statistics snapshot
+ * @return true if the lock exists
+ */
+bool lockstat_get(int index, lockstat_info_t *info);
+
+#else /* !CONFIG_DEBUG_LOCKSTAT */
+
+#define LOCKSTAT_MUTEX_DEFINE(var) K_MUTEX_DEFINE(var)
+#define lockstat_mutex_lock(m, timeout) k_mutex_lock(m, timeout)
+#define lockstat_mutex_unlock(m) k_mutex_unlock(m)
+
+#endif /* CONFIG_DEBUG_LOCKSTAT */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LOCKSTAT_H */
@@ -0,0 +1,158 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Zephyr Edge AI Demo - Runtime Memory Map
+ *
+ * Section sizes come from the linker symbols in linker-defs.h. Everything
+ * between _image_ram_start and _image_ram_end that is neither data nor
+ * bss is counted as noinit (thread stacks, tensor arena alignment pads).
+ */
+
+#include "memmap.h"
+
+#include <zephyr/kernel.h>
+#include <zephyr/linker/linker-defs.h>
+#include <zephyr/logging/log.h>
+#include <string.h>
+
+LOG_MODULE_REGISTER(memmap, CONFIG_LOG_DEFAULT_LEVEL);
+
+/* ============================================================================
+ * Private Data
+ * ============================================================================ */
+
+/**
+ * @brief Registry entry
+ */
+struct region_entry {
+    memmap_region_t region;
+    /** Thread whose stack high-water mark is the usage (may be NULL) */
+    const struct k_thread *thread;
+};
+
+static struct region_entry regions[MEMMAP_MAX_REGIONS];
+static int region_count = 0;
+
+static K_MUTEX_DEFINE(memmap_mutex);
+
+/* ============================================================================
+ * Private Functions
+ * ============================================================================ */
+
+/**
+ * @brief Find or allocate a registry entry (caller holds memmap_mutex)
+ */
+static struct region_entry *lookup(const char *name)
+{
+    for (int i = 0; i < region_count; i++) {
+        if (strcmp(regions[i].region.name, name) == 0) {
+            return &regions[i];
+        }
+    }
+    
+    if (region_count == MEMMAP_MAX_REGIONS) {
+        LOG_WRN("Memory map full, %s not tracked", name);
+        return NULL;
+    }
+    
+    return &regions[region_count++];
+}
+
+/**
+ * @brief Stack high-water mark of a thread
+ */
+static uint32_t stack_used(const struct k_thread *thread)
+{
+#ifdef CONFIG_THREAD_STACK_INFO
+    size_t unused = 0;
+    
+    if (k_thread_stack_space_get(thread, &unused) == 0) {
+        return (uint32_t)(thread->stack_info.size - unused);
+    }
+#else
+    ARG_UNUSED(thread);
+#endif
+    return MEMMAP_USED_UNKNOWN;
+}
+
+/* ============================================================================
+ * Public API Implementation
+ * ============================================================================ */
+
+void memmap_add(const char *name, size_t size, size_t used)
+{
+    k_mutex_lock(&memmap_mutex, K_FOREVER);
+    
+    struct region_entry *e = lookup(name);
+    
+    if (e != NULL) {
+        e->region.name = name;
+        e->region.size = (uint32_t)size;
+        e->region.used = (used == MEMMAP_USED_UNKNOWN) ?
+                         MEMMAP_USED_UNKNOWN : (uint32_t)used;
+        e->thread = NULL;
+    }
+    
+    k_mutex_unlock(&memmap_mutex);
+}
+
+void memmap_add_thread(const char *name, const struct k_thread *thread)
+{
+    k_mutex_lock(&memmap_mutex, K_FOREVER);
+    
+    struct region_entry *e = lookup(name);
+    
+    if (e != NULL) {
+        e->region.name = name;
+#ifdef CONFIG_THREAD_STACK_INFO
+        e->region.size = (uint32_t)thread->stack_info.size;
+#else
+        e->region.size = 0;
+#endif
+        e->region.used = MEMMAP_USED_UNKNOWN;
+        e->thread = thread;
+    }
+    
+    k_mutex_unlock(&memmap_mutex);
+}
+
+bool memmap_get(int index, memmap_region_t *region)
+{
+    bool found = false;
+    
+    if (region == NULL) {
+        return false;
+    }
+    
+    k_mutex_lock(&memmap_mutex, K_FOREVER);
+    
+    if (index >= 0 && index < region_count) {
+        *region = regions[index].region;
+        if (regions[index].thread != NULL) {
+            region->used = stack_used(regions[index].thread);
+        }
+        found = true;
+    }
+    
+    k_mutex_unlock(&memmap_mutex);
+    
+    return found;
+}
+
+void memmap_get_image(memmap_image_t *image)
+{
+    if (image == NULL) {
+        return;
+    }
+    
+    image->rom = (uint32_t)(__rom_region_end - __rom_region_start);
+    image->ram = (uint32_t)(_image_ram_end - _image_ram_start);
+    image->data = (uint32_t)(__data_region_end - __data_region_start);
+    image->bss = (uint32_t)(__bss_end - __bss_start);
+    image->noinit = image->ram - MIN(image->ram, image->data + image->bss);
+#ifdef CONFIG_SRAM_SIZE
+    image->ram_size = CONFIG_SRAM_SIZE * 1024U;
+#else
+    image->ram_size = 0;
+#endif
+}
@@ -0,0 +1,128 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Zephyr Edge AI Demo - Runtime Memory Map
+ *
+ * Image section sizes from linker symbols plus a registry of the
+ * application's large RAM objects (tensor arena, sample windows, rings,
+ * queues, thread stacks). Modules register their objects at init;
+ * thread stacks report their high-water mark when the map is read.
+ */
+
+#ifndef MEMMAP_H
+#define MEMMAP_H
+
+#include <zephyr/kernel.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Maximum number of registered regions */
+#define MEMMAP_MAX_REGIONS 24
+
+/** Region usage is not tracked */
+#define MEMMAP_USED_UNKNOWN UINT32_MAX
+
+/**
+ * @brief One registered RAM region
+ */
+typedef struct {
+    /** Region name, stable across builds */
+    const char *name;
+    
+    /** Reserved size (bytes) */
+    uint32_t size;
+    
+    /** Bytes used (high-water mark for stacks), or MEMMAP_USED_UNKNOWN */
+    uint32_t used;
+} memmap_region_t;
+
+/**
+ * @brief Image section sizes from linker symbols (bytes)
+ */
+typedef struct {
+    /** Flash image */
+    uint32_t rom;
+    
+    /** Statically allocated RAM (data + bss + noinit) */
+    uint32_t ram;
+    
+    /** Initialized data */
+    uint32_t data;
+    
+    /** Zero-initialized data */
+    uint32_t bss;
+    
+    /** Uninitialized data, mostly thread stacks */
+    uint32_t noinit;
+    
+    /** Total SRAM on the target, 0 if unknown */
+    uint32_t ram_size;
+} memmap_image_t;
+
+#ifdef CONFIG_DEBUG_MEMMAP
+
+/**
+ * @brief Register or update a RAM region
+ *
+ * A second call with the same name updates the size and usage.
+ *
+ * @param name Region name (string literal)
+ * @param size Reserved size (bytes)
+ * @param used Bytes used, or MEMMAP_USED_UNKNOWN
+ */
+void memmap_add(const char *name, size_t size, size_t used);
+
+/**
+ * @brief Register a thread stack
+ *
+ * Usage is read from the stack high-water mark when the map is read.
+ *
+ * @param name Region name (string literal)
+ * @param thread Thread owning the stack
+ */
+void memmap_add_thread(const char *name, const struct k_thread *thread);
+
+/**
+ * @brief Get the n-th registered region
+ *
+ * @param index Region index (0-based)
+ * @param[out] region Region snapshot
+ * @return true if the region exists
+ */
+bool memmap_get(int index, memmap_region_t *region);
+
+/**
+ * @brief Get image section sizes
+ *
+ * @param[out] image Section sizes
+ */
+void memmap_get_image(memmap_image_t *image);
+
+#else /* !CONFIG_DEBUG_MEMMAP */
+
+static inline void memmap_add(const char *name, size_t size, size_t used)
+{
+    ARG_UNUSED(name);
+    ARG_UNUSED(size);
+    ARG_UNUSED(used);
+}
+
+static inline void memmap_add_thread(const char *name,
+                                     const struct k_thread *thread)
+{
+    ARG_UNUSED(name);
+    ARG_UNUSED(thread);
+}
+
+#endif /* CONFIG_DEBUG_MEMMAP */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MEMMAP_H */
@@ -0,0 +1,160 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Zephyr Edge AI Demo - Preprocessing Kernel Benchmark
+ *
+ * The ring is filled with deterministic pseudo-random samples around a
+ * 1 g Z offset. Each conversion is timed with interrupts locked, so the
+ * minimum and mean are the conversion alone; the pipeline has not
+ * started when this runs.
+ */
+
+#include "preproc_bench.h"
+#include "preprocess_kernels.h"
+#include "inference.h"
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <stdlib.h>
+
+LOG_MODULE_REGISTER(preproc_bench, CONFIG_LOG_DEFAULT_LEVEL);
+
+/* ============================================================================
+ * Configuration
+ * ============================================================================ */
+
+#ifndef CONFIG_DEBUG_PREPROC_BENCH_ITERATIONS
+#define CONFIG_DEBUG_PREPROC_BENCH_ITERATIONS 50
+#endif
+
+/** Ring slack beyond the longest window, as in preprocessing.c */
+#define BENCH_RING_SIZE (PREPROC_BENCH_MAX_WINDOW + 16)
+
+/** Ring offset step between iterations (coprime with the ring size) */
+#define OFFSET_STEP 37
+
+BUILD_ASSERT(CONFIG_ML_INFERENCE_WINDOW_SIZE <= PREPROC_BENCH_MAX_WINDOW,
+             "Configured window exceeds the benchmark ring");
+
+/* ============================================================================
+ * Private Data
+ * ============================================================================ */
+
+static const size_t bench_windows[] = { PREPROC_BENCH_WINDOWS };
+
+BUILD_ASSERT(ARRAY_SIZE(bench_windows) == PREPROC_BENCH_COUNT,
+             "PREPROC_BENCH_COUNT does not match PREPROC_BENCH_WINDOWS");
+
+static struct accel_sample bench_ring[BENCH_RING_SIZE];
+
+static int8_t generic_out[PREPROC_BENCH_MAX_WINDOW * ML_INPUT_AXES];
+static int8_t kernel_out[PREPROC_BENCH_MAX_WINDOW * ML_INPUT_AXES];
+
+/** DC offsets as the EMA would hold them (non-integer on purpose) */
+static const float bench_dc[3] = { 120.4f, -87.6f, 8191.5f };
+
+/* ============================================================================
+ * Private Functions
+ * ============================================================================ */
+
+static void fill_ring(void)
+{
+    uint32_t state = 0x2545F491;
+
+    for (size_t i = 0; i < BENCH_RING_SIZE; i++) {
+        int16_t axis[3];
+
+        for (int a = 0; a < 3; a++) {
+            state = state * 1664525U + 1013904223U;
+            /* ±20000 so some samples saturate */
+            axis[a] = (int16_t)((int32_t)((state >> 16) % 40001) - 20000);
+        }
+
+        bench_ring[i].x = axis[0];
+        bench_ring[i].y = axis[1];
+        bench_ring[i].z = (int16_t)(axis[2] / 2 + 8192);
+        bench_ring[i].timestamp_us = i * 10000U;
+    }
+}
+
+/**
+ * @brief Time one conversion with interrupts locked
+ *
+ * @return Elapsed cycles
+ */
+static uint32_t time_conversion(bool kernel, size_t start, size_t window)
+{
+    unsigned int key = irq_lock();
+    uint32_t t0 = k_cycle_get_32();
+
+    if (kernel) {
+        preprocess_quantize(bench_ring, BENCH_RING_SIZE, start, window,
+                            bench_dc, kernel_out);
+    } else {
+        preprocess_quantize_generic(bench_ring, BENCH_RING_SIZE, start,
+                                    window, bench_dc, generic_out);
+    }
+
+    uint32_t elapsed = k_cycle_get_32() - t0;
+
+    irq_unlock(key);
+
+    return elapsed;
+}
+
+static void run_window(size_t window, preproc_bench_result_t *result)
+{
+    uint64_t generic_total = 0;
+    uint64_t kernel_total = 0;
+
+    result->window = window;
+    result->specialized = preprocess_kernel_specialized(window);
+    result->generic_min_cyc = UINT32_MAX;
+    result->kernel_min_cyc = UINT32_MAX;
+    result->max_diff = 0;
+
+    for (int i = 0; i < CONFIG_DEBUG_PREPROC_BENCH_ITERATIONS; i++) {
+        size_t start = ((size_t)i * OFFSET_STEP) % BENCH_RING_SIZE;
+        uint32_t generic = time_conversion(false, start, window);
+        uint32_t kernel = time_conversion(true, start, window);
+
+        generic_total += generic;
+        kernel_total += kernel;
+        result->generic_min_cyc = MIN(result->generic_min_cyc, generic);
+        result->kernel_min_cyc = MIN(result->kernel_min_cyc, kernel);
+
+        for (size_t j = 0; j < window * ML_INPUT_AXES; j++) {
+            uint32_t diff = abs(generic_out[j] - kernel_out[j]);
+
+            result->max_diff = MAX(result->max_diff, diff);
+        }
+    }
+
+    result->generic_mean_cyc =
+        (uint32_t)(generic_total / CONFIG_DEBUG_PREPROC_BENCH_ITERATIONS);
+    result->kernel_mean_cyc =
+        (uint32_t)(kernel_total / CONFIG_DEBUG_PREPROC_BENCH_ITERATIONS);
+}
+
+/* ============================================================================
+ * Public API Implementation
+ * ============================================================================ */
+
+int preproc_bench_run(preproc_bench_result_t results[PREPROC_BENCH_COUNT])
+{
+    if (results == NULL) {
+        return -EINVAL;
+    }
+
+    fill_ring();
+
+    for (int i = 0; i < PREPROC_BENCH_COUNT; i++) {
+        run_window(bench_windows[i], &results[i]);
+
+        LOG_INF("Preprocessing %u samples: generic %u, %s kernel %u cycles (min)",
+                results[i].window, results[i].generic_min_cyc,
+                preprocess_kernel_scheme(), results[i].kernel_min_cyc);
+    }
+
+    return 0;
+}
@@ -0,0 +1,76 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Zephyr Edge AI Demo - Preprocessing Kernel Benchmark
+ *
+ * Times the generic window quantization loop against the specialized
+ * kernels (see preprocess_kernels.cpp) at several window lengths and
+ * checks that both produce the same output.
+ */
+
+#ifndef PREPROC_BENCH_H
+#define PREPROC_BENCH_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Window lengths measured. Each gets a kernel instance, so keep the
+ * list short; the configured window comes first.
+ */
+#define PREPROC_BENCH_WINDOWS CONFIG_ML_INFERENCE_WINDOW_SIZE, 16, 32, 64, 128, 256
+
+/** Number of entries in PREPROC_BENCH_WINDOWS */
+#define PREPROC_BENCH_COUNT 6
+
+/** Longest window in PREPROC_BENCH_WINDOWS */
+#define PREPROC_BENCH_MAX_WINDOW 256
+
+/**
+ * @brief Result for one window length
+ */
+typedef struct {
+    /** Window length in samples */
+    uint32_t window;
+
+    /** A specialized kernel was used (false: both paths are generic) */
+    bool specialized;
+
+    /** Fastest generic conversion (cycles) */
+    uint32_t generic_min_cyc;
+
+    /** Mean generic conversion (cycles) */
+    uint32_t generic_mean_cyc;
+
+    /** Fastest kernel conversion (cycles) */
+    uint32_t kernel_min_cyc;
+
+    /** Mean kernel conversion (cycles) */
+    uint32_t kernel_mean_cyc;
+
+    /** Largest absolute output difference between the two paths */
+    uint32_t max_diff;
+} preproc_bench_result_t;
+
+/**
+ * @brief Run the benchmark at every window length
+ *
+ * Uses a private synthetic sample ring; the pipeline's preprocessing
+ * state is not touched. Each length is converted
+ * CONFIG_DEBUG_PREPROC_BENCH_ITERATIONS times per path at varying ring
+ * offsets, so wrapped and contiguous windows are both included.
+ *
+ * @param[out] results One result per window length
+ * @return 0 on success, negative error code otherwise
+ */
+int preproc_bench_run(preproc_bench_result_t results[PREPROC_BENCH_COUNT]);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PREPROC_BENCH_H */
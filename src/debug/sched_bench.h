@@ -0,0 +1,86 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Zephyr Edge AI Demo - Scheduling Latency Microbenchmarks
+ *
+ * Measures the kernel primitives the pipeline is built on:
+ *   - sem:   k_sem_give() in one thread to the waiting thread running
+ *   - timer: k_usleep() wake-up lateness versus the requested time
+ *   - isr:   k_sem_give() from interrupt context to the thread running
+ *
+ * Each run is taken either before the pipeline threads start
+ * (unloaded) or while they are running (loaded).
+ */
+
+#ifndef SCHED_BENCH_H
+#define SCHED_BENCH_H
+
+#include "timing.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Measured primitives
+ */
+typedef enum {
+    SCHED_BENCH_SEM = 0,
+    SCHED_BENCH_TIMER,
+    SCHED_BENCH_ISR,
+    SCHED_BENCH_COUNT
+} sched_bench_prim_t;
+
+/**
+ * @brief Result of one primitive in one run
+ */
+typedef struct {
+    /** Primitive measured */
+    sched_bench_prim_t prim;
+    
+    /** Pipeline threads were running */
+    bool loaded;
+    
+    /** Number of samples */
+    uint32_t samples;
+    
+    /** Smallest latency (ns) */
+    uint32_t min_ns;
+    
+    /** Largest latency (ns) */
+    uint32_t max_ns;
+    
+    /** Sum of latencies for the mean (ns) */
+    uint64_t total_ns;
+    
+    /** Latency histogram (us, so that it spans up to 2^18 us) */
+    profile_hist_t hist;
+} sched_bench_result_t;
+
+/**
+ * @brief Run all microbenchmarks
+ *
+ * Blocks the calling thread for the duration of the run. The caller's
+ * priority is temporarily lowered below the benchmark thread.
+ *
+ * @param loaded true if the pipeline threads are running
+ * @param[out] results One result per primitive
+ * @return 0 on success, negative error code otherwise
+ */
+int sched_bench_run(bool loaded, sched_bench_result_t results[SCHED_BENCH_COUNT]);
+
+/**
+ * @brief Get a primitive's short name
+ *
+ * @param prim Primitive
+ * @return Name string
+ */
+const char *sched_bench_prim_name(sched_bench_prim_t prim);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SCHED_BENCH_H */
@@ -0,0 +1,246 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Zephyr Edge AI Demo - Runtime Schedulability Check
+ *
+ * Execution time is taken from the scheduler's per-thread runtime
+ * statistics, so time spent preempted is not charged to the job. The
+ * analysis is the classic fixed-priority response-time iteration
+ *
+ *     R = C_i + sum over higher or equal priority j of ceil(R / T_j) * C_j
+ *
+ * with implicit deadlines (D = T). Equal priorities are counted as
+ * interference in both directions, which is pessimistic but safe for
+ * Zephyr's FIFO ordering within a priority. Blocking on shared mutexes
+ * and interrupt load are not modeled; CONFIG_DEBUG_LOCKSTAT reports the
+ * lock hold times needed to judge the former.
+ */
+
+#include "sched_check.h"
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <string.h>
+
+LOG_MODULE_REGISTER(sched_check, CONFIG_LOG_DEFAULT_LEVEL);
+
+/* ============================================================================
+ * Configuration
+ * ============================================================================ */
+
+#ifndef CONFIG_DEBUG_SCHED_CHECK_MARGIN_PERCENT
+#define CONFIG_DEBUG_SCHED_CHECK_MARGIN_PERCENT 80
+#endif
+
+/** Iteration limit for the response-time recurrence */
+#define RTA_MAX_ITERATIONS 64
+
+/** Liu & Layland bound n(2^(1/n) - 1) for n = 1..5 tasks (permille) */
+static const uint16_t ll_bound_permille[] = { 1000, 828, 779, 756, 743 };
+
+BUILD_ASSERT(SCHED_TASK_COUNT <= ARRAY_SIZE(ll_bound_permille),
+             "Extend the Liu & Layland bound table");
+
+/* ============================================================================
+ * Private Data
+ * ============================================================================ */
+
+/**
+ * @brief Registered task and its observations
+ */
+struct task_state {
+    const char *name;
+    int priority;
+    uint32_t period_us;
+    uint32_t jobs;
+    uint32_t wcet_us;
+    uint32_t max_response_us;
+    uint32_t overruns;
+};
+
+static struct task_state tasks[SCHED_TASK_COUNT];
+
+static K_MUTEX_DEFINE(check_mutex);
+
+/** Result of the previous analysis, for warning on changes only */
+static bool last_schedulable = true;
+static bool last_at_risk = false;
+
+/* ============================================================================
+ * Private Functions
+ * ============================================================================ */
+
+static uint64_t thread_exec_cycles(void)
+{
+    k_thread_runtime_stats_t rt = {0};
+
+    k_thread_runtime_stats_get(k_current_get(), &rt);
+    return rt.execution_cycles;
+}
+
+/**
+ * @brief Worst-case response time of one task
+ *
+ * Caller holds check_mutex.
+ *
+ * @return Response time (us), or SCHED_CHECK_UNBOUNDED if it exceeds
+ *         the task's period
+ */
+static uint32_t response_time(int i)
+{
+    const struct task_state *t = &tasks[i];
+    uint64_t r = t->wcet_us;
+
+    for (int iter = 0; iter < RTA_MAX_ITERATIONS; iter++) {
+        uint64_t next = t->wcet_us;
+
+        for (int j = 0; j < SCHED_TASK_COUNT; j++) {
+            const struct task_state *hp = &tasks[j];
+
+            if (j == i || hp->period_us == 0 || hp->priority > t->priority) {
+                continue;
+            }
+            next += DIV_ROUND_UP(r, hp->period_us) * hp->wcet_us;
+        }
+
+        if (next > t->period_us) {
+            return SCHED_CHECK_UNBOUNDED;
+        }
+        if (next == r) {
+            break;
+        }
+        r = next;
+    }
+
+    return (uint32_t)r;
+}
+
+/* ============================================================================
+ * Public API Implementation
+ * ============================================================================ */
+
+void sched_check_register(sched_task_t task, const char *name, int priority,
+                          uint32_t period_us)
+{
+    if (task >= SCHED_TASK_COUNT) {
+        return;
+    }
+
+    k_mutex_lock(&check_mutex, K_FOREVER);
+    memset(&tasks[task], 0, sizeof(tasks[task]));
+    tasks[task].name = name;
+    tasks[task].priority = priority;
+    tasks[task].period_us = period_us;
+    k_mutex_unlock(&check_mutex);
+
+    LOG_INF("Task %s: priority %d, period %u us", name, priority, period_us);
+}
+
+void sched_check_job_begin(sched_job_t *job)
+{
+    job->start_cyc = k_cycle_get_32();
+    job->start_exec = thread_exec_cycles();
+}
+
+void sched_check_job_end(sched_task_t task, const sched_job_t *job)
+{
+    uint32_t exec_us = (uint32_t)k_cyc_to_us_floor64(
+        thread_exec_cycles() - job->start_exec);
+    uint32_t response_us = k_cyc_to_us_floor32(k_cycle_get_32() -
+                                               job->start_cyc);
+
+    if (task >= SCHED_TASK_COUNT) {
+        return;
+    }
+
+    k_mutex_lock(&check_mutex, K_FOREVER);
+
+    struct task_state *t = &tasks[task];
+
+    t->jobs++;
+    t->wcet_us = MAX(t->wcet_us, exec_us);
+    t->max_response_us = MAX(t->max_response_us, response_us);
+    if (t->period_us != 0 && response_us > t->period_us) {
+        t->overruns++;
+    }
+
+    k_mutex_unlock(&check_mutex);
+}
+
+void sched_check_analyze(sched_report_t *report)
+{
+    uint32_t util = 0;
+    uint32_t worst_permille = 0;
+    const char *worst = "?";
+    int registered = 0;
+
+    if (report == NULL) {
+        return;
+    }
+
+    memset(report, 0, sizeof(*report));
+    report->schedulable = true;
+
+    k_mutex_lock(&check_mutex, K_FOREVER);
+
+    for (int i = 0; i < SCHED_TASK_COUNT; i++) {
+        const struct task_state *t = &tasks[i];
+        sched_task_report_t *out = &report->task[i];
+
+        out->name = t->name;
+        out->priority = t->priority;
+        out->period_us = t->period_us;
+        out->jobs = t->jobs;
+        out->wcet_us = t->wcet_us;
+        out->max_response_us = t->max_response_us;
+        out->overruns = t->overruns;
+
+        if (t->period_us == 0) {
+            continue;
+        }
+
+        registered++;
+        util += (uint32_t)((uint64_t)t->wcet_us * 1000U / t->period_us);
+        out->rta_us = response_time(i);
+
+        uint32_t load = out->rta_us == SCHED_CHECK_UNBOUNDED ? UINT32_MAX :
+                        (uint32_t)((uint64_t)out->rta_us * 1000U / t->period_us);
+
+        if (load >= worst_permille) {
+            worst_permille = load;
+            worst = t->name;
+        }
+
+        if (out->rta_us == SCHED_CHECK_UNBOUNDED) {
+            report->schedulable = false;
+            report->at_risk = true;
+        } else if ((uint64_t)out->rta_us * 100U >
+                   (uint64_t)t->period_us *
+                   CONFIG_DEBUG_SCHED_CHECK_MARGIN_PERCENT) {
+            report->at_risk = true;
+        }
+    }
+
+    k_mutex_unlock(&check_mutex);
+
+    report->util_permille = util;
+    report->bound_permille = registered > 0 ?
+                             ll_bound_permille[registered - 1] : 1000;
+
+    if (!report->schedulable && last_schedulable) {
+        LOG_WRN("Task set not schedulable at observed WCETs: %s misses "
+                "its deadline (utilization %u.%u%%)",
+                worst, util / 10, util % 10);
+    } else if (report->at_risk && !last_at_risk) {
+        LOG_WRN("%s response time above %d%% of its period "
+                "(utilization %u.%u%%, bound %u.%u%%)",
+                worst, CONFIG_DEBUG_SCHED_CHECK_MARGIN_PERCENT,
+                util / 10, util % 10,
+                report->bound_permille / 10, report->bound_permille % 10);
+    } else if (!report->at_risk && last_at_risk) {
+        LOG_INF("Task set back within the response time margin");
+    }
+
+    last_schedulable = report->schedulable;
+    last_at_risk = report->at_risk;
+}
@@ -0,0 +1,169 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Zephyr Edge AI Demo - Runtime Schedulability Check
+ *
+ * Each pipeline thread brackets one job (one loop iteration doing
+ * work) with sched_check_job_begin()/sched_check_job_end(). The
+ * observed worst-case execution time per task feeds a fixed-priority
+ * response-time analysis against the configured periods, so a task set
+ * that is drifting towards missed deadlines is reported before it
+ * misses them.
+ */
+
+#ifndef SCHED_CHECK_H
+#define SCHED_CHECK_H
+
+#include <zephyr/kernel.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Analyzed tasks, one per pipeline thread
+ */
+typedef enum {
+    SCHED_TASK_SENSOR = 0,
+    SCHED_TASK_ML,
+    SCHED_TASK_OUTPUT,
+    SCHED_TASK_DEBUG,
+#ifdef CONFIG_ML_ASYNC
+    SCHED_TASK_ML_EXEC,     /* Inference executor (ml_exec) */
+#endif
+    SCHED_TASK_COUNT
+} sched_task_t;
+
+/** Response time did not converge within the period */
+#define SCHED_CHECK_UNBOUNDED UINT32_MAX
+
+/**
+ * @brief Job in progress
+ */
+typedef struct {
+    /** Cycle counter at job start */
+    uint32_t start_cyc;
+
+    /** Thread execution cycles at job start */
+    uint64_t start_exec;
+} sched_job_t;
+
+/**
+ * @brief Per-task analysis result
+ */
+typedef struct {
+    /** Task name */
+    const char *name;
+
+    /** Thread priority */
+    int priority;
+
+    /** Period and implicit deadline (us), 0 if not registered */
+    uint32_t period_us;
+
+    /** Completed jobs */
+    uint32_t jobs;
+
+    /** Observed worst-case execution time (us) */
+    uint32_t wcet_us;
+
+    /** Longest observed job start to job end, including preemption (us) */
+    uint32_t max_response_us;
+
+    /** Analyzed worst-case response time (us), or SCHED_CHECK_UNBOUNDED */
+    uint32_t rta_us;
+
+    /** Jobs whose observed response exceeded the period */
+    uint32_t overruns;
+} sched_task_report_t;
+
+/**
+ * @brief Task set analysis result
+ */
+typedef struct {
+    /** Per-task results, indexed by sched_task_t */
+    sched_task_report_t task[SCHED_TASK_COUNT];
+
+    /** Total utilization, sum of WCET / period (permille) */
+    uint32_t util_permille;
+
+    /** Liu & Layland bound for the registered task count (permille) */
+    uint32_t bound_permille;
+
+    /** Every analyzed response time is within its period */
+    bool schedulable;
+
+    /** Some response time exceeds CONFIG_DEBUG_SCHED_CHECK_MARGIN_PERCENT
+     *  of its period */
+    bool at_risk;
+} sched_report_t;
+
+#ifdef CONFIG_DEBUG_SCHED_CHECK
+
+/**
+ * @brief Register a task with its priority and period
+ *
+ * @param task Task slot
+ * @param name Task name (string literal)
+ * @param priority Thread priority (lower value preempts higher)
+ * @param period_us Release period, used as the deadline (us)
+ */
+void sched_check_register(sched_task_t task, const char *name, int priority,
+                          uint32_t period_us);
+
+/**
+ * @brief Mark the start of a job in the calling thread
+ *
+ * @param[out] job Job state to pass to sched_check_job_end()
+ */
+void sched_check_job_begin(sched_job_t *job);
+
+/**
+ * @brief Mark the end of a job and record its execution time
+ *
+ * @param task Task the calling thread runs
+ * @param job Job state from sched_check_job_begin()
+ */
+void sched_check_job_end(sched_task_t task, const sched_job_t *job);
+
+/**
+ * @brief Run the response-time analysis on the current WCETs
+ *
+ * Logs a warning when the result changes to at risk or unschedulable.
+ *
+ * @param[out] report Analysis result
+ */
+void sched_check_analyze(sched_report_t *report);
+
+#else /* !CONFIG_DEBUG_SCHED_CHECK */
+
+static inline void sched_check_register(sched_task_t task, const char *name,
+                                        int priority, uint32_t period_us)
+{
+    ARG_UNUSED(task);
+    ARG_UNUSED(name);
+    ARG_UNUSED(priority);
+    ARG_UNUSED(period_us);
+}
+
+static inline void sched_check_job_begin(sched_job_t *job)
+{
+    ARG_UNUSED(job);
+}
+
+static inline void sched_check_job_end(sched_task_t task,
+                                       const sched_job_t *job)
+{
+    ARG_UNUSED(task);
+    ARG_UNUSED(job);
+}
+
+#endif /* CONFIG_DEBUG_SCHED_CHECK */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SCHED_CHECK_H */
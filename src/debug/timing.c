@@ -10,6 +10,7 @@
 
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
+#include <string.h>
 
 LOG_MODULE_REGISTER(timing, CONFIG_LOG_DEFAULT_LEVEL);
 
@@ -104,6 +105,40 @@ void profile_timing_stats_reset(timing_stats_t *stats)
     stats->total_us = 0;
 }
 
+void profile_hist_record(profile_hist_t *hist, uint32_t value)
+{
+    if (hist == NULL) {
+        return;
+    }
+    
+    /* Bucket index is the bit length of the value */
+    int bucket = (value == 0) ? 0 : 32 - __builtin_clz(value);
+    
+    if (bucket >= PROFILE_HIST_BUCKETS) {
+        bucket = PROFILE_HIST_BUCKETS - 1;
+    }
+    
+    hist->bucket[bucket]++;
+    
+    if (value > hist->max) {
+        hist->max = value;
+    }
+}
+
+void profile_hist_reset(profile_hist_t *hist)
+{
+    if (hist == NULL) {
+        return;
+    }
+    
+    memset(hist, 0, sizeof(*hist));
+}
+
+uint32_t profile_hist_bucket_floor(int bucket)
+{
+    return (bucket <= 0) ? 0 : (1U << (bucket - 1));
+}
+
 uint32_t profile_timing_get_us(void)
 {
     return (uint32_t)(k_uptime_get() * 1000);
@@ -24,6 +24,20 @@ typedef struct {
     uint64_t total_us;
 } timing_stats_t;
 
+/** Number of log2 histogram buckets */
+#define PROFILE_HIST_BUCKETS 20
+
+/**
+ * @brief Log2 histogram
+ *
+ * Bucket 0 counts zero values; bucket i (i >= 1) counts values in
+ * [2^(i-1), 2^i). The last bucket also takes everything larger.
+ */
+typedef struct {
+    uint32_t bucket[PROFILE_HIST_BUCKETS];
+    uint32_t max;
+} profile_hist_t;
+
 /**
  * @brief Initialize the timing module
  */
@@ -59,6 +73,29 @@ void profile_timing_record(timing_stats_t *stats, uint32_t duration_us);
  */
 void profile_timing_stats_reset(timing_stats_t *stats);
 
+/**
+ * @brief Add a value to a log2 histogram
+ *
+ * @param hist Histogram to update
+ * @param value Value to record (e.g. microseconds)
+ */
+void profile_hist_record(profile_hist_t *hist, uint32_t value);
+
+/**
+ * @brief Reset a log2 histogram
+ *
+ * @param hist Histogram to reset
+ */
+void profile_hist_reset(profile_hist_t *hist);
+
+/**
+ * @brief Get the lower bound of a histogram bucket
+ *
+ * @param bucket Bucket index
+ * @return Smallest value counted in the bucket
+ */
+uint32_t profile_hist_bucket_floor(int bucket);
+
 /**
  * @brief Get current timestamp in microseconds
  *
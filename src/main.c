@@ -36,10 +36,21 @@
 #include "sensor/sensor_hal.h"
 #include "ml/inference.h"
 #include "ml/preprocessing.h"
+#include "ml/resampler.h"
+#include "ml/inference_async.h"
+#include "ml/temporal_decoder.h"
+#include "ml/weight_stream.h"
 #include "output/uart_protocol.h"
 #include "output/ring_buffer.h"
+#include "output/output_queue.h"
 #include "debug/debug_monitor.h"
 #include "debug/timing.h"
+#include "debug/sched_bench.h"
+#include "debug/sched_check.h"
+#include "debug/preproc_bench.h"
+#include "debug/memmap.h"
+#include "debug/energy.h"
+#include "debug/insn_marks.h"
 
 LOG_MODULE_REGISTER(main, CONFIG_LOG_DEFAULT_LEVEL);
 
@@ -47,12 +58,12 @@ LOG_MODULE_REGISTER(main, CONFIG_LOG_DEFAULT_LEVEL);
  * Configuration
  * ============================================================================ */
 
-/** Sensor sampling period in milliseconds */
-#define SENSOR_SAMPLE_PERIOD_MS (1000 / CONFIG_SENSOR_SAMPLE_RATE_HZ)
-
 /** Debug monitor period in milliseconds */
 #define DEBUG_MONITOR_PERIOD_MS CONFIG_DEBUG_MONITOR_INTERVAL_MS
 
+/** Output thread polling period in milliseconds */
+#define OUTPUT_POLL_PERIOD_MS 10
+
 /** Stack sizes - IMPORTANT: See DEBUGGING.md for stack overflow fix */
 #define SENSOR_STACK_SIZE 1024
 #define ML_STACK_SIZE     4096  /* Increased from 1024 due to TFLite stack usage */
@@ -103,12 +114,20 @@ static void sensor_thread_fn(void *p1, void *p2, void *p3)
     ARG_UNUSED(p3);
     
     struct accel_sample sample;
+    sched_job_t job;
     int ret;
     uint32_t sample_count = 0;
+    uint32_t rate_hz = sensor_hal_get_rate();
     
-    LOG_INF("Sensor thread started (period: %d ms)", SENSOR_SAMPLE_PERIOD_MS);
+#ifdef CONFIG_SENSOR_ADAPTIVE_RATE
+    LOG_INF("Sensor thread started (%u Hz, adaptive)", rate_hz);
+#else
+    LOG_INF("Sensor thread started (%u Hz)", rate_hz);
+#endif
     
     while (running) {
+        sched_check_job_begin(&job);
+        
         /* Read sensor sample */
         ret = sensor_hal_read(&sample);
         
@@ -126,8 +145,17 @@ static void sensor_thread_fn(void *p1, void *p2, void *p3)
             LOG_WRN("Sensor read failed: %d", ret);
         }
         
+        /* Follow runtime rate changes (motion-adaptive sampling) */
+        if (sensor_hal_get_rate() != rate_hz) {
+            rate_hz = sensor_hal_get_rate();
+            preprocessing_set_source_rate(rate_hz);
+            LOG_INF("Sample rate changed to %u Hz", rate_hz);
+        }
+        
+        sched_check_job_end(SCHED_TASK_SENSOR, &job);
+        
         /* Sleep until next sample */
-        k_msleep(SENSOR_SAMPLE_PERIOD_MS);
+        k_usleep(1000000 / rate_hz);
     }
     
     LOG_INF("Sensor thread exiting (samples: %u)", sample_count);
@@ -140,6 +168,32 @@ static void sensor_thread_fn(void *p1, void *p2, void *p3)
  * and queues the result for output.
  * ============================================================================ */
 
+/**
+ * @brief Log a result and queue it for output
+ */
+static void publish_result(const inference_result_t *result)
+{
+    LOG_INF("Detected: %s (%.2f) in %u us",
+            ml_gesture_to_string(result->gesture),
+            (double)result->confidence,
+            result->inference_time_us);
+    
+    /* Queue result for output */
+    result_buffer_push(result);
+    
+#ifdef CONFIG_ML_TEMPORAL_DECODER
+    decoder_event_t event;
+    
+    if (temporal_decoder_push(result, &event)) {
+        LOG_INF("Event: %s (%.2f, %u frames)",
+                ml_gesture_to_string(event.gesture),
+                (double)event.confidence, event.frames);
+        uart_output_event(&event);
+    }
+#endif
+}
+
+#ifndef CONFIG_ML_ASYNC
 static void ml_thread_fn(void *p1, void *p2, void *p3)
 {
     ARG_UNUSED(p1);
@@ -148,6 +202,7 @@ static void ml_thread_fn(void *p1, void *p2, void *p3)
     
     int8_t input_buffer[ML_INPUT_SIZE];
     inference_result_t result;
+    sched_job_t job;
     int ret;
     
     LOG_INF("ML thread started");
@@ -157,33 +212,108 @@ static void ml_thread_fn(void *p1, void *p2, void *p3)
         ret = k_sem_take(&ml_sem, K_MSEC(1000));
         
         if (ret == 0) {
+            sched_check_job_begin(&job);
+            
             /* Get preprocessed input */
+            INSN_MARK(preproc_begin);
             ret = preprocessing_get_input(input_buffer, sizeof(input_buffer));
+            INSN_MARK(preproc_end);
             
             if (ret == 0) {
                 /* Run inference */
                 ret = ml_run_inference(input_buffer, &result);
                 
                 if (ret == ML_STATUS_OK) {
-                    LOG_INF("Detected: %s (%.2f) in %u us",
-                            ml_gesture_to_string(result.gesture),
-                            (double)result.confidence,
-                            result.inference_time_us);
-                    
-                    /* Queue result for output */
-                    result_buffer_push(&result);
+                    publish_result(&result);
                 } else {
                     LOG_ERR("Inference failed: %d", ret);
                 }
             } else {
                 LOG_WRN("Failed to get preprocessed input: %d", ret);
             }
+            
+            sched_check_job_end(SCHED_TASK_ML, &job);
         }
         /* Timeout is normal - just keep waiting */
     }
     
     LOG_INF("ML thread exiting");
 }
+#else /* CONFIG_ML_ASYNC */
+/**
+ * @brief Completion callback, runs in the ML thread from ml_poll()
+ */
+static void ml_result_ready(const inference_result_t *result,
+                            ml_status_t status, void *user_data)
+{
+    ARG_UNUSED(user_data);
+    
+    if (status == ML_STATUS_OK) {
+        publish_result(result);
+    } else {
+        LOG_ERR("Inference failed: %d", status);
+    }
+}
+
+/*
+ * Asynchronous variant: windows are submitted to the inference executor
+ * and results delivered as they finish, so the next window is prepared
+ * while the previous one is still being classified. A window that finds
+ * every executor slot busy is dropped (counted as rejected) rather than
+ * stalling the ML thread.
+ */
+static void ml_thread_fn(void *p1, void *p2, void *p3)
+{
+    ARG_UNUSED(p1);
+    ARG_UNUSED(p2);
+    ARG_UNUSED(p3);
+    
+    int8_t input_buffer[ML_INPUT_SIZE];
+    struct k_poll_event events[2];
+    sched_job_t job;
+    int ret;
+    
+    LOG_INF("ML thread started (async, depth %d)", CONFIG_ML_ASYNC_DEPTH);
+    
+    k_poll_event_init(&events[0], K_POLL_TYPE_SEM_AVAILABLE,
+                      K_POLL_MODE_NOTIFY_ONLY, &ml_sem);
+    ml_poll_event_init(&events[1]);
+    
+    while (running) {
+        /* Wait for a window or a finished inference */
+        (void)k_poll(events, ARRAY_SIZE(events), K_MSEC(1000));
+        events[0].state = K_POLL_STATE_NOT_READY;
+        events[1].state = K_POLL_STATE_NOT_READY;
+        
+        /* Deliver first: it frees executor slots */
+        ml_poll(K_NO_WAIT);
+        
+        if (k_sem_take(&ml_sem, K_NO_WAIT) != 0) {
+            continue;
+        }
+        
+        sched_check_job_begin(&job);
+        
+        /* Get preprocessed input */
+        INSN_MARK(preproc_begin);
+        ret = preprocessing_get_input(input_buffer, sizeof(input_buffer));
+        INSN_MARK(preproc_end);
+        
+        if (ret == 0) {
+            ret = ml_submit(input_buffer, ml_result_ready, NULL, K_NO_WAIT);
+            if (ret == -EAGAIN) {
+                LOG_DBG("Executor full, window dropped");
+            }
+        } else {
+            LOG_WRN("Failed to get preprocessed input: %d", ret);
+        }
+        
+        sched_check_job_end(SCHED_TASK_ML, &job);
+    }
+    
+    LOG_INF("ML thread exiting");
+}
+#endif /* CONFIG_ML_ASYNC */
 
 /* ============================================================================
  * Output Thread
@@ -198,25 +328,66 @@ static void output_thread_fn(void *p1, void *p2, void *p3)
     ARG_UNUSED(p3);
     
     inference_result_t result;
+#ifndef CONFIG_OUTPUT_SUMMARY_ONLY
     debug_stats_t debug_stats;
+#endif
+#ifdef CONFIG_OUTPUT_SUMMARY
+    summary_t summary;
+#endif
+    sched_job_t job;
     int ret;
     
     LOG_INF("Output thread started");
     
+#ifdef CONFIG_OUTPUT_SUMMARY
+    summary_init();
+#endif
+    
+#ifdef CONFIG_OUTPUT_PRIORITY_QUEUES
+    /* From here on other threads queue their lines for this thread */
+    output_queue_start();
+#endif
+    
     while (running) {
+        sched_check_job_begin(&job);
+        
         /* Check for results to output */
         ret = result_buffer_pop(&result);
         
         if (ret == 0) {
-            /* Get current debug stats */
+#ifdef CONFIG_OUTPUT_SUMMARY
+            summary_record(&result);
+#endif
+#ifndef CONFIG_OUTPUT_SUMMARY_ONLY
+            /* Latest health snapshot from the debug thread */
             debug_monitor_get_stats(&debug_stats);
             
             /* Output the result */
+            INSN_MARK(output_begin);
             uart_output_inference(&result, &debug_stats);
+            INSN_MARK(output_end);
+#endif
         }
         
+#ifdef CONFIG_OUTPUT_SUMMARY
+        if (summary_due()) {
+            summary_take(&summary);
+            uart_output_summary(&summary);
+        }
+#endif
+        
+        /* Transmit queued lines, host ACK/NACK handling and retransmissions */
+        uart_protocol_poll();
+        
+        sched_check_job_end(SCHED_TASK_OUTPUT, &job);
+        
+#ifdef CONFIG_OUTPUT_PRIORITY_QUEUES
+        /* Wake early when another thread queues a line */
+        output_queue_wait(K_MSEC(OUTPUT_POLL_PERIOD_MS));
+#else
         /* Small sleep to prevent busy-waiting */
-        k_msleep(10);
+        k_msleep(OUTPUT_POLL_PERIOD_MS);
+#endif
     }
     
     LOG_INF("Output thread exiting");
@@ -236,11 +407,43 @@ static void debug_thread_fn(void *p1, void *p2, void *p3)
     
     debug_stats_t stats;
     ml_stats_t ml_stats;
+#ifdef CONFIG_ML_ASYNC
+    ml_async_stats_t async_stats;
+#endif
+#ifdef CONFIG_ML_TEMPORAL_DECODER
+    decoder_stats_t decoder_stats;
+#endif
+#ifdef CONFIG_ML_WEIGHT_STREAM
+    weight_stream_stats_t wstream_stats;
+    weight_stream_stats_t wstream_now;
+    weight_stream_stats_t wstream_prev = {0};
+#endif
+#ifdef CONFIG_ML_RESAMPLE
+    resampler_stats_t rs_stats;
+#endif
+#ifdef CONFIG_DEBUG_ENERGY
+    energy_stats_t energy;
+    energy_inputs_t energy_in;
+#endif
+#ifdef CONFIG_DEBUG_SCHED_CHECK
+    sched_report_t sched_report;
+#endif
+    sched_job_t job;
     int check_result;
     
     LOG_INF("Debug thread started (period: %d ms)", DEBUG_MONITOR_PERIOD_MS);
     
+#ifdef CONFIG_DEBUG_ENERGY
+    energy_init(&ml_thread_data);
+#ifdef CONFIG_ML_ASYNC
+    /* The executor runs the model; the ML thread only prepares windows */
+    (void)energy_add_ml_thread(ml_async_thread());
+#endif
+#endif
+    
     while (running) {
+        sched_check_job_begin(&job);
+        
         /* Run health checks */
         check_result = debug_monitor_check();
         
@@ -259,9 +462,59 @@ static void debug_thread_fn(void *p1, void *p2, void *p3)
                 stats.stack_used, stats.stack_size,
                 ml_stats.inference_count);
         
+#ifdef CONFIG_ML_TEMPORAL_DECODER
+        temporal_decoder_get_stats(&decoder_stats);
+        LOG_INF("Decoder: frames=%u, events=%u, smoothed=%u",
+                decoder_stats.frames, decoder_stats.events,
+                decoder_stats.smoothed);
+#endif
+#ifdef CONFIG_ML_ASYNC
+        ml_async_get_stats(&async_stats);
+        LOG_INF("Async: submitted=%u, completed=%u, rejected=%u, "
+                "in flight=%u (max %u), max latency=%u us",
+                async_stats.submitted, async_stats.completed,
+                async_stats.rejected, async_stats.in_flight,
+                async_stats.max_in_flight, async_stats.max_latency_us);
+#endif
+        
+#ifdef CONFIG_ML_RESAMPLE
+        resampler_get_stats(&rs_stats);
+        LOG_INF("Resampler: in=%u, out=%u, gaps=%u (missing %u), resets=%u",
+                rs_stats.samples_in, rs_stats.samples_out, rs_stats.gaps,
+                rs_stats.samples_missing, rs_stats.resets);
+#endif
+        
 #ifdef CONFIG_DEBUG_MONITOR_ENABLE
         uart_output_debug(&stats);
 #endif
+#ifdef CONFIG_OUTPUT_RELIABLE_LINK
+        uart_output_link_stats();
+#endif
+#ifdef CONFIG_OUTPUT_PRIORITY_QUEUES
+        uart_output_queue_stats();
+#endif
+#ifdef CONFIG_DEBUG_LOCKSTAT
+        uart_output_lock_stats();
+#endif
+#ifdef CONFIG_ML_WEIGHT_STREAM
+        /* One record per interval, so that records are independent samples */
+        weight_stream_get_stats(&wstream_now);
+        weight_stream_stats_interval(&wstream_now, &wstream_prev, &wstream_stats);
+        wstream_prev = wstream_now;
+        uart_output_wstream(&wstream_stats);
+#endif
+#ifdef CONFIG_DEBUG_ENERGY
+        energy_in.inferences = ml_stats.inference_count;
+        energy_in.uart_tx_bytes = uart_protocol_get_tx_bytes();
+        energy_update(&energy_in, &energy);
+        uart_output_energy(&energy);
+#endif
+#ifdef CONFIG_DEBUG_SCHED_CHECK
+        sched_check_analyze(&sched_report);
+        uart_output_sched(&sched_report);
+#endif
+        
+        sched_check_job_end(SCHED_TASK_DEBUG, &job);
         
         k_msleep(DEBUG_MONITOR_PERIOD_MS);
     }
@@ -269,6 +522,124 @@ static void debug_thread_fn(void *p1, void *p2, void *p3)
     LOG_INF("Debug thread exiting");
 }
 
+#ifdef CONFIG_DEBUG_MEMMAP
+/**
+ * @brief Register stacks and kernel pools with the memory map
+ *
+ * Module buffers (arena, rings, queues) register themselves at init.
+ */
+static void register_memory_regions(void)
+{
+    memmap_add_thread("stack_main", k_current_get());
+    memmap_add_thread("stack_sensor", &sensor_thread_data);
+    memmap_add_thread("stack_ml", &ml_thread_data);
+    memmap_add_thread("stack_output", &output_thread_data);
+    memmap_add_thread("stack_debug", &debug_thread_data);
+    memmap_add_thread("stack_workq", &k_sys_work_q.thread);
+    memmap_add("stack_isr", CONFIG_ISR_STACK_SIZE, MEMMAP_USED_UNKNOWN);
+#ifdef CONFIG_HEAP_MEM_POOL_SIZE
+    memmap_add("heap", CONFIG_HEAP_MEM_POOL_SIZE, MEMMAP_USED_UNKNOWN);
+#endif
+#ifdef CONFIG_LOG_MODE_DEFERRED
+    memmap_add("log_buffer", CONFIG_LOG_BUFFER_SIZE, MEMMAP_USED_UNKNOWN);
+#endif
+}
+#endif
+
+#ifdef CONFIG_DEBUG_SCHED_CHECK
+/**
+ * @brief Register the pipeline threads with their configured periods
+ *
+ * The sensor period is the full configured rate (the worst case with
+ * adaptive sampling). The ML thread is released once per primary
+ * window, or at most once per refractory period in onset mode. The
+ * output thread polls more often, but its real work is released by
+ * inference results, so it is analyzed as sporadic at the ML period
+ * (a 10 ms deadline would be missed by every inference by design).
+ */
+static void register_sched_tasks(void)
+{
+    uint32_t sample_period_us = 1000000U / CONFIG_SENSOR_SAMPLE_RATE_HZ;
+    
+#ifdef CONFIG_ML_WINDOW_TRIGGER_ONSET
+    uint32_t ml_period_us = CONFIG_ML_ONSET_REFRACTORY_MS * 1000U;
+#else
+    uint32_t ml_period_us = CONFIG_ML_INFERENCE_WINDOW_SIZE * sample_period_us;
+#endif
+    
+    sched_check_register(SCHED_TASK_SENSOR, "sensor", SENSOR_PRIORITY,
+                         sample_period_us);
+    sched_check_register(SCHED_TASK_ML, "ml", ML_PRIORITY, ml_period_us);
+    sched_check_register(SCHED_TASK_OUTPUT, "output", OUTPUT_PRIORITY,
+                         ml_period_us);
+    sched_check_register(SCHED_TASK_DEBUG, "debug", DEBUG_PRIORITY,
+                         DEBUG_MONITOR_PERIOD_MS * 1000U);
+#ifdef CONFIG_ML_ASYNC
+    /* Inference itself runs here, released by each submitted window */
+    sched_check_register(SCHED_TASK_ML_EXEC, "ml_exec",
+                         CONFIG_ML_ASYNC_PRIORITY, ml_period_us);
+#endif
+}
+#endif
+
+#ifdef CONFIG_DEBUG_SCHED_BENCH
+/**
+ * @brief Run the scheduling microbenchmarks and report the results
+ */
+static void run_sched_bench(bool loaded)
+{
+    sched_bench_result_t results[SCHED_BENCH_COUNT];
+    
+    if (sched_bench_run(loaded, results) != 0) {
+        return;
+    }
+    
+    for (int i = 0; i < SCHED_BENCH_COUNT; i++) {
+        uart_output_bench(&results[i]);
+    }
+}
+#endif
+
+#ifdef CONFIG_DEBUG_PREPROC_BENCH
+/**
+ * @brief Run the preprocessing kernel benchmark and report the results
+ */
+static void run_preproc_bench(void)
+{
+    preproc_bench_result_t results[PREPROC_BENCH_COUNT];
+    
+    if (preproc_bench_run(results) != 0) {
+        return;
+    }
+    
+    for (int i = 0; i < PREPROC_BENCH_COUNT; i++) {
+        uart_output_preproc_bench(&results[i]);
+    }
+}
+#endif
+
+#ifdef CONFIG_ML_FC_TUNE
+/**
+ * @brief Benchmark the FC kernel variants and report the results
+ *
+ * Consumed by scripts/fc_autotune.py, which writes src/ml/fc_tuning.h.
+ */
+static void run_fc_tune(void)
+{
+    fc_tune_result_t results[WEIGHT_STREAM_MAX_LAYERS * FC_VARIANT_COUNT];
+    int count = weight_stream_autotune(results, ARRAY_SIZE(results));
+    
+    if (count < 0) {
+        LOG_ERR("FC kernel tuning failed: %d", count);
+        return;
+    }
+    
+    for (int i = 0; i < count; i++) {
+        uart_output_fctune(&results[i]);
+    }
+}
+#endif
+
 /* ============================================================================
  * Main Entry Point
  * ============================================================================ */
@@ -308,6 +679,12 @@ int main(void)
     /* Initialize preprocessing */
     preprocessing_init();
     
+#ifdef CONFIG_ML_TEMPORAL_DECODER
+    /* One decoder frame per primary window */
+    temporal_decoder_init(CONFIG_ML_INFERENCE_WINDOW_SIZE * 1000U /
+                          CONFIG_SENSOR_SAMPLE_RATE_HZ);
+#endif
+    
     /* Initialize ML inference engine */
     LOG_INF("Initializing ML inference engine...");
     ret = ml_inference_init();
@@ -319,6 +696,29 @@ int main(void)
     
     LOG_INF("Tensor arena used: %zu bytes", ml_get_arena_used());
     
+#ifdef CONFIG_ML_ASYNC
+    ml_async_init();
+#endif
+    
+#ifdef CONFIG_DEBUG_SCHED_BENCH
+    /* Baseline before any pipeline thread competes for the CPU */
+    run_sched_bench(false);
+#endif
+    
+#ifdef CONFIG_DEBUG_PREPROC_BENCH
+    /* Interrupts are locked per conversion; run before the sensor starts */
+    run_preproc_bench();
+#endif
+    
+#ifdef CONFIG_ML_FC_TUNE
+    /* Interrupts are locked per kernel run; run before the sensor starts */
+    run_fc_tune();
+#endif
+    
+#ifdef CONFIG_DEBUG_SCHED_CHECK
+    register_sched_tasks();
+#endif
+    
     /* Create sensor thread */
     k_thread_create(&sensor_thread_data, sensor_stack,
                     K_THREAD_STACK_SIZEOF(sensor_stack),
@@ -326,6 +726,7 @@ int main(void)
                     NULL, NULL, NULL,
                     SENSOR_PRIORITY, 0, K_NO_WAIT);
     k_thread_name_set(&sensor_thread_data, "sensor");
+    debug_monitor_register_thread(&sensor_thread_data, "sensor");
     
     /* Create ML thread */
     k_thread_create(&ml_thread_data, ml_stack,
@@ -345,6 +746,7 @@ int main(void)
                     NULL, NULL, NULL,
                     OUTPUT_PRIORITY, 0, K_NO_WAIT);
     k_thread_name_set(&output_thread_data, "output");
+    debug_monitor_register_thread(&output_thread_data, "output");
     
     /* Create debug thread */
     k_thread_create(&debug_thread_data, debug_stack,
@@ -353,8 +755,24 @@ int main(void)
                     NULL, NULL, NULL,
                     DEBUG_PRIORITY, 0, K_NO_WAIT);
     k_thread_name_set(&debug_thread_data, "debug");
+    debug_monitor_register_thread(&debug_thread_data, "debug");
     
     LOG_INF("All threads started successfully");
+    
+#ifdef CONFIG_DEBUG_SCHED_BENCH
+    /* Same measurements with the pipeline running */
+    k_msleep(1000);
+    run_sched_bench(true);
+#endif
+    
+#ifdef CONFIG_DEBUG_MEMMAP
+    register_memory_regions();
+    
+    /* Let the stacks reach their steady-state high-water marks */
+    k_msleep(CONFIG_DEBUG_MEMMAP_DELAY_MS);
+    uart_output_memmap();
+#endif
+    
     LOG_INF("System ready - waiting for gestures...");
     
     /* Main thread can now sleep or monitor */
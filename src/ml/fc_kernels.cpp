@@ -0,0 +1,305 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Zephyr Edge AI Demo - Fully-Connected Kernel Variants
+ *
+ * Every variant accumulates the same integer products (only the order
+ * differs, and int32 addition is associative) and requantizes like the
+ * TFLite reference kernel, so all of them are bit-exact. What changes is
+ * how many loads, loop branches and accumulators the core juggles:
+ *
+ *   reference - one accumulator, one MAC per iteration
+ *   row4      - four rows at once, each input byte loaded once per four
+ *               MACs; best when loads are expensive
+ *   coltile   - walks the weights in column tiles over all rows, keeping
+ *               the input tile hot; helps cores with a small cache
+ *   unroll4   - four MACs per loop iteration, fewer branches
+ *   dualmac   - inputs offset and packed as 16-bit pairs once per call,
+ *               weights sign-extended two at a time; one SMLAD per two
+ *               MACs on cores with the DSP extension, portable C
+ *               emulation elsewhere
+ */
+
+#include "fc_kernels.h"
+#include "fc_tuning.h"
+
+#include <zephyr/kernel.h>
+#include <string.h>
+
+#include <tensorflow/lite/kernels/internal/common.h>
+
+#if defined(__ARM_FEATURE_DSP) && __ARM_FEATURE_DSP
+#include <arm_acle.h>
+#endif
+
+/* ============================================================================
+ * Configuration
+ * ============================================================================ */
+
+/** Columns per tile of the column-blocked kernel */
+#define COL_TILE 32
+
+/* ============================================================================
+ * Private Data
+ * ============================================================================ */
+
+/** Row accumulators of the column-blocked kernel */
+static int32_t col_acc[FC_MAX_DIM];
+
+/** Offset inputs of the dual-MAC kernel, pair-interleaved per 4 columns */
+static int16_t packed_input[FC_MAX_DIM] __aligned(4);
+
+static const char *const variant_names[FC_VARIANT_COUNT] = {
+    "reference",
+    "row4",
+    "coltile",
+    "unroll4",
+    "dualmac",
+};
+
+/* ============================================================================
+ * Private Functions
+ * ============================================================================ */
+
+static inline int8_t requantize(const struct fc_params *p, int32_t acc,
+                                int32_t bias)
+{
+    acc = tflite::MultiplyByQuantizedMultiplier(acc + bias, p->multiplier,
+                                                p->shift);
+    acc += p->output_zp;
+    return (int8_t)CLAMP(acc, p->act_min, p->act_max);
+}
+
+static inline int32_t dot_row(const struct fc_params *p, const int8_t *w,
+                              const int8_t *in)
+{
+    int32_t acc = 0;
+
+    for (uint16_t c = 0; c < p->in_dim; c++) {
+        acc += (int32_t)w[c] * ((int32_t)in[c] + p->input_offset);
+    }
+
+    return acc;
+}
+
+#if defined(__ARM_FEATURE_DSP) && __ARM_FEATURE_DSP
+static inline int32_t sxtb16(uint32_t v)
+{
+    return __sxtb16((int32_t)v);
+}
+
+static inline int32_t sxtb16_odd(uint32_t v)
+{
+    return __sxtb16((int32_t)__ror(v, 8));
+}
+
+static inline int32_t smlad(int32_t a, int32_t b, int32_t acc)
+{
+    return __smlad(a, b, acc);
+}
+#else
+/** Bytes 0 and 2, sign-extended to halfwords */
+static inline int32_t sxtb16(uint32_t v)
+{
+    return (int32_t)(((uint32_t)(uint16_t)(int16_t)(int8_t)(v & 0xFF)) |
+                     ((uint32_t)(uint16_t)(int16_t)(int8_t)((v >> 16) & 0xFF) << 16));
+}
+
+/** Bytes 1 and 3, sign-extended to halfwords */
+static inline int32_t sxtb16_odd(uint32_t v)
+{
+    return sxtb16(v >> 8);
+}
+
+static inline int32_t smlad(int32_t a, int32_t b, int32_t acc)
+{
+    return acc + (int32_t)(int16_t)a * (int16_t)b +
+           (int32_t)(int16_t)(a >> 16) * (int16_t)(b >> 16);
+}
+#endif
+
+static void fc_reference(const struct fc_params *p, const int32_t *bias,
+                         const int8_t *weights, uint16_t rows,
+                         const int8_t *in, int8_t *out)
+{
+    for (uint16_t r = 0; r < rows; r++) {
+        out[r] = requantize(p, dot_row(p, weights + (size_t)r * p->in_dim, in),
+                            bias[r]);
+    }
+}
+
+static void fc_row_blocked(const struct fc_params *p, const int32_t *bias,
+                           const int8_t *weights, uint16_t rows,
+                           const int8_t *in, int8_t *out)
+{
+    const size_t stride = p->in_dim;
+    uint16_t r = 0;
+
+    for (; r + 4 <= rows; r += 4) {
+        const int8_t *w0 = weights + r * stride;
+        const int8_t *w1 = w0 + stride;
+        const int8_t *w2 = w1 + stride;
+        const int8_t *w3 = w2 + stride;
+        int32_t a0 = 0, a1 = 0, a2 = 0, a3 = 0;
+
+        for (uint16_t c = 0; c < p->in_dim; c++) {
+            int32_t x = (int32_t)in[c] + p->input_offset;
+
+            a0 += (int32_t)w0[c] * x;
+            a1 += (int32_t)w1[c] * x;
+            a2 += (int32_t)w2[c] * x;
+            a3 += (int32_t)w3[c] * x;
+        }
+
+        out[r] = requantize(p, a0, bias[r]);
+        out[r + 1] = requantize(p, a1, bias[r + 1]);
+        out[r + 2] = requantize(p, a2, bias[r + 2]);
+        out[r + 3] = requantize(p, a3, bias[r + 3]);
+    }
+
+    for (; r < rows; r++) {
+        out[r] = requantize(p, dot_row(p, weights + r * stride, in), bias[r]);
+    }
+}
+
+static void fc_col_blocked(const struct fc_params *p, const int32_t *bias,
+                           const int8_t *weights, uint16_t rows,
+                           const int8_t *in, int8_t *out)
+{
+    memset(col_acc, 0, rows * sizeof(col_acc[0]));
+
+    for (uint16_t c0 = 0; c0 < p->in_dim; c0 += COL_TILE) {
+        uint16_t c_end = MIN((uint16_t)(c0 + COL_TILE), p->in_dim);
+
+        for (uint16_t r = 0; r < rows; r++) {
+            const int8_t *w = weights + (size_t)r * p->in_dim;
+            int32_t acc = col_acc[r];
+
+            for (uint16_t c = c0; c < c_end; c++) {
+                acc += (int32_t)w[c] * ((int32_t)in[c] + p->input_offset);
+            }
+            col_acc[r] = acc;
+        }
+    }
+
+    for (uint16_t r = 0; r < rows; r++) {
+        out[r] = requantize(p, col_acc[r], bias[r]);
+    }
+}
+
+static void fc_unroll4(const struct fc_params *p, const int32_t *bias,
+                       const int8_t *weights, uint16_t rows,
+                       const int8_t *in, int8_t *out)
+{
+    const int32_t off = p->input_offset;
+
+    for (uint16_t r = 0; r < rows; r++) {
+        const int8_t *w = weights + (size_t)r * p->in_dim;
+        int32_t acc = 0;
+        uint16_t c = 0;
+
+        for (; c + 4 <= p->in_dim; c += 4) {
+            acc += (int32_t)w[c] * ((int32_t)in[c] + off);
+            acc += (int32_t)w[c + 1] * ((int32_t)in[c + 1] + off);
+            acc += (int32_t)w[c + 2] * ((int32_t)in[c + 2] + off);
+            acc += (int32_t)w[c + 3] * ((int32_t)in[c + 3] + off);
+        }
+        for (; c < p->in_dim; c++) {
+            acc += (int32_t)w[c] * ((int32_t)in[c] + off);
+        }
+
+        out[r] = requantize(p, acc, bias[r]);
+    }
+}
+
+static void fc_dual_mac(const struct fc_params *p, const int32_t *bias,
+                        const int8_t *weights, uint16_t rows,
+                        const int8_t *in, int8_t *out)
+{
+    const uint16_t n = p->in_dim;
+    const uint16_t n4 = n & ~3U;
+    uint16_t c;
+
+    /* Offset inputs fit int16 (|x - zp| <= 255). Order x0 x2 x1 x3 per
+     * group of four to match the even/odd byte split of the weights. */
+    for (c = 0; c < n4; c += 4) {
+        packed_input[c] = (int16_t)(in[c] + p->input_offset);
+        packed_input[c + 1] = (int16_t)(in[c + 2] + p->input_offset);
+        packed_input[c + 2] = (int16_t)(in[c + 1] + p->input_offset);
+        packed_input[c + 3] = (int16_t)(in[c + 3] + p->input_offset);
+    }
+    for (; c < n; c++) {
+        packed_input[c] = (int16_t)(in[c] + p->input_offset);
+    }
+
+    for (uint16_t r = 0; r < rows; r++) {
+        const int8_t *w = weights + (size_t)r * n;
+        int32_t acc = 0;
+
+        for (c = 0; c < n4; c += 4) {
+            uint32_t w4;
+            int32_t x02;
+            int32_t x13;
+
+            memcpy(&w4, w + c, sizeof(w4));
+            memcpy(&x02, &packed_input[c], sizeof(x02));
+            memcpy(&x13, &packed_input[c + 2], sizeof(x13));
+
+            acc = smlad(sxtb16(w4), x02, acc);
+            acc = smlad(sxtb16_odd(w4), x13, acc);
+        }
+        for (; c < n; c++) {
+            acc += (int32_t)w[c] * packed_input[c];
+        }
+
+        out[r] = requantize(p, acc, bias[r]);
+    }
+}
+
+/* ============================================================================
+ * Public API Implementation
+ * ============================================================================ */
+
+void fc_kernel_run(fc_variant_t variant, const struct fc_params *params,
+                   const int32_t *bias, const int8_t *weights, uint16_t rows,
+                   const int8_t *input, int8_t *output)
+{
+    switch (variant) {
+    case FC_VARIANT_ROW_BLOCKED:
+        fc_row_blocked(params, bias, weights, rows, input, output);
+        break;
+    case FC_VARIANT_COL_BLOCKED:
+        fc_col_blocked(params, bias, weights, rows, input, output);
+        break;
+    case FC_VARIANT_UNROLL4:
+        fc_unroll4(params, bias, weights, rows, input, output);
+        break;
+    case FC_VARIANT_DUAL_MAC:
+        fc_dual_mac(params, bias, weights, rows, input, output);
+        break;
+    default:
+        fc_reference(params, bias, weights, rows, input, output);
+        break;
+    }
+}
+
+fc_variant_t fc_tuning_lookup(uint16_t in_dim, uint16_t out_dim)
+{
+    const struct fc_tuning_entry *e = fc_tuning_table;
+
+    /* The table ends with the default, a { 0, 0, variant } entry */
+    while (e->in_dim != 0 &&
+           (e->in_dim != in_dim || e->out_dim != out_dim)) {
+        e++;
+    }
+
+    return e->variant;
+}
+
+const char *fc_variant_name(fc_variant_t variant)
+{
+    if ((unsigned)variant >= FC_VARIANT_COUNT) {
+        return "unknown";
+    }
+    return variant_names[variant];
+}
@@ -0,0 +1,112 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Zephyr Edge AI Demo - Fully-Connected Kernel Variants
+ *
+ * int8 fully-connected kernels used by the weight streaming backend.
+ * All variants compute the TFLite reference arithmetic and give
+ * identical output; they differ in loop structure, and which one is
+ * fastest depends on the core. scripts/fc_autotune.py benchmarks them
+ * on the target (CONFIG_ML_FC_TUNE) and writes the winner per layer
+ * shape to fc_tuning.h.
+ */
+
+#ifndef FC_KERNELS_H
+#define FC_KERNELS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Widest layer input or output the kernels handle */
+#define FC_MAX_DIM 512
+
+/**
+ * @brief Kernel variants
+ */
+typedef enum {
+    FC_VARIANT_REFERENCE,   /* One row, one column at a time */
+    FC_VARIANT_ROW_BLOCKED, /* Four rows share each input load */
+    FC_VARIANT_COL_BLOCKED, /* Column tiles across all rows */
+    FC_VARIANT_UNROLL4,     /* Inner loop unrolled 4x */
+    FC_VARIANT_DUAL_MAC,    /* Paired 16-bit MACs (SMLAD on DSP cores) */
+    FC_VARIANT_COUNT
+} fc_variant_t;
+
+/**
+ * @brief Per-layer quantization parameters
+ */
+struct fc_params {
+    uint16_t in_dim;
+    /** Negated input zero point */
+    int32_t input_offset;
+    int32_t output_zp;
+    int32_t multiplier;
+    int shift;
+    int32_t act_min;
+    int32_t act_max;
+};
+
+/**
+ * @brief Tuning table entry (see fc_tuning.h)
+ */
+struct fc_tuning_entry {
+    uint16_t in_dim;
+    uint16_t out_dim;
+    fc_variant_t variant;
+};
+
+/**
+ * @brief Benchmark result for one layer and variant
+ */
+typedef struct {
+    uint8_t layer;
+    uint8_t layers;
+    uint16_t in_dim;
+    uint16_t out_dim;
+    /** Rows per benchmarked chunk */
+    uint16_t rows;
+    fc_variant_t variant;
+    /** Cycles per chunk (minimum over the iterations) */
+    uint32_t cycles;
+    /** Output identical to the reference variant */
+    bool match;
+} fc_tune_result_t;
+
+/**
+ * @brief Compute rows of a fully-connected layer
+ *
+ * @param variant Kernel variant
+ * @param params Layer parameters
+ * @param bias Bias per row (rows entries)
+ * @param weights Row-major weights, rows x params->in_dim
+ * @param rows Rows to compute
+ * @param input Layer input (params->in_dim values)
+ * @param[out] output One value per row
+ */
+void fc_kernel_run(fc_variant_t variant, const struct fc_params *params,
+                   const int32_t *bias, const int8_t *weights, uint16_t rows,
+                   const int8_t *input, int8_t *output);
+
+/**
+ * @brief Variant for a layer shape from the generated tuning table
+ *
+ * @param in_dim Layer input width
+ * @param out_dim Layer output width
+ * @return Tuned variant, or the table default for unknown shapes
+ */
+fc_variant_t fc_tuning_lookup(uint16_t in_dim, uint16_t out_dim);
+
+/**
+ * @brief Short variant name, as used in fc_tuning.h and fctune records
+ */
+const char *fc_variant_name(fc_variant_t variant);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FC_KERNELS_H */
@@ -0,0 +1,24 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Zephyr Edge AI Demo - Fully-Connected Kernel Tuning Table
+ *
+ * Generated by scripts/fc_autotune.py; regenerate rather than edit.
+ * Maps layer shapes (input width, output width) to the fastest kernel
+ * variant measured on the tuning board. The last entry is the default
+ * for shapes that were not tuned.
+ *
+ * Board: untuned
+ * Source: none
+ */
+
+#ifndef FC_TUNING_H
+#define FC_TUNING_H
+
+#include "fc_kernels.h"
+
+static const struct fc_tuning_entry fc_tuning_table[] = {
+    { 0, 0, FC_VARIANT_REFERENCE },
+};
+
+#endif /* FC_TUNING_H */
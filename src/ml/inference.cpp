@@ -9,15 +9,33 @@
  */
 
 #include "inference.h"
-#include "gesture_model.h"
+#include "synthetic_inference.h"
+#include "lockstat.h"
+#include "memmap.h"
+#include "insn_marks.h"
+
+#ifdef CONFIG_ML_WEIGHT_STREAM
+#include "weight_stream.h"
+#endif
 
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
+#include <math.h>
+
+#ifdef CONFIG_ML_TREE_CLASSIFIER
+#include "tree_classifier.h"
+#endif
+
+/* The interpreter and its model are left out when another backend
+ * replaces the network (trees, or weight streaming without fallback) */
+#ifdef CONFIG_ML_TFLM
+#include "gesture_model.h"
 
 /* TensorFlow Lite Micro headers */
 #include <tensorflow/lite/micro/micro_interpreter.h>
 #include <tensorflow/lite/micro/micro_mutable_op_resolver.h>
 #include <tensorflow/lite/schema/schema_generated.h>
+#endif
 
 LOG_MODULE_REGISTER(ml_inference, CONFIG_LOG_DEFAULT_LEVEL);
 
@@ -33,6 +51,7 @@ LOG_MODULE_REGISTER(ml_inference, CONFIG_LOG_DEFAULT_LEVEL);
  * Private Data
  * ============================================================================ */
 
+#ifdef CONFIG_ML_TFLM
 /** Tensor arena for TFLite-Micro allocations */
 static uint8_t tensor_arena[CONFIG_ML_TENSOR_ARENA_SIZE] __aligned(16);
 
@@ -43,11 +62,25 @@ static tflite::MicroInterpreter *interpreter = nullptr;
 /** Input/output tensor pointers */
 static TfLiteTensor *input_tensor = nullptr;
 static TfLiteTensor *output_tensor = nullptr;
+#endif
 
 /** Initialization flag */
 static bool ml_initialized = false;
 static bool use_mock_inference = false;
 
+/** Output tensor holds logits (trailing softmax stripped at export) */
+static bool output_is_logits = false;
+
+/** Model runs from flash through the weight streaming backend */
+static bool use_weight_stream = false;
+
+#ifdef CONFIG_ML_WEIGHT_STREAM
+static int8_t stream_output[GESTURE_COUNT];
+#endif
+
+/** Windows are classified by the gradient-boosted tree backend */
+static bool use_tree_classifier = false;
+
 /** Statistics */
 static ml_stats_t ml_stats = {0};
 
@@ -55,7 +88,7 @@ static ml_stats_t ml_stats = {0};
 static uint32_t inference_sequence = 0;
 
 /** Mutex for thread safety */
-static K_MUTEX_DEFINE(ml_mutex);
+static LOCKSTAT_MUTEX_DEFINE(ml_mutex);
 
 /* ============================================================================
  * Gesture Labels
@@ -75,6 +108,7 @@ static const char *gesture_names[GESTURE_COUNT] = {
  * This is determined by the model's converter output.
  * ============================================================================ */
 
+#ifdef CONFIG_ML_TFLM
 static tflite::MicroMutableOpResolver<12> *resolver = nullptr;
 
 static int setup_op_resolver()
@@ -162,21 +196,124 @@ static int setup_op_resolver()
     return 0;
 }
 
+/* ============================================================================
+ * Output Post-processing
+ * ============================================================================ */
+
+/**
+ * @brief Check whether the output tensor carries softmax probabilities
+ *
+ * TFLite requires an int8 SOFTMAX output to use scale 1/256 and zero
+ * point -128. Any other quantization means the export pipeline stripped
+ * the softmax (see model/optimize_tflite.py) and the output is logits.
+ */
+static bool output_is_probability(const TfLiteTensor *tensor)
+{
+    return tensor->params.zero_point == -128 &&
+           fabsf(tensor->params.scale - (1.0f / 256.0f)) < 1e-6f;
+}
+#endif /* CONFIG_ML_TFLM */
+
+/**
+ * @brief In-place softmax over the per-class scores
+ *
+ * Only runs on the device when the model was exported without its
+ * trailing SOFTMAX op; 4 expf() calls are far cheaper than the op.
+ */
+static void scores_softmax(float *scores)
+{
+    float max_logit = scores[0];
+    float sum = 0.0f;
+    
+    for (int i = 1; i < GESTURE_COUNT; i++) {
+        if (scores[i] > max_logit) {
+            max_logit = scores[i];
+        }
+    }
+    
+    for (int i = 0; i < GESTURE_COUNT; i++) {
+        scores[i] = expf(scores[i] - max_logit);
+        sum += scores[i];
+    }
+    
+    for (int i = 0; i < GESTURE_COUNT; i++) {
+        scores[i] /= sum;
+    }
+}
+
 /* ============================================================================
  * Public API Implementation
  * ============================================================================ */
 
 ml_status_t ml_inference_init(void)
 {
-    k_mutex_lock(&ml_mutex, K_FOREVER);
+    lockstat_mutex_lock(&ml_mutex, K_FOREVER);
     
     if (ml_initialized) {
         LOG_WRN("ML inference already initialized");
-        k_mutex_unlock(&ml_mutex);
+        lockstat_mutex_unlock(&ml_mutex);
         return ML_STATUS_OK;
     }
     
     LOG_INF("Initializing ML inference engine...");
+    
+    /* Initialize statistics (shared by the model and synthetic paths) */
+    ml_stats.inference_count = 0;
+    ml_stats.min_time_us = UINT32_MAX;
+    ml_stats.max_time_us = 0;
+    ml_stats.total_time_us = 0;
+    ml_stats.invoke_failures = 0;
+    
+    inference_sequence = 0;
+    
+    /* Synthetic backend is always ready; it doubles as the load fallback */
+    synthetic_inference_init();
+    
+#ifdef CONFIG_ML_SYNTHETIC_INFERENCE
+    LOG_WRN("Synthetic inference forced by configuration");
+    use_mock_inference = true;
+    ml_initialized = true;
+    lockstat_mutex_unlock(&ml_mutex);
+    return ML_STATUS_OK;
+#endif
+    
+#ifdef CONFIG_ML_TREE_CLASSIFIER
+    /* The trees are compiled in; there is no model to load */
+    use_tree_classifier = true;
+    output_is_logits = true;
+    ml_initialized = true;
+    LOG_INF("ML inference engine ready (%d trees)",
+            tree_classifier_tree_count());
+    lockstat_mutex_unlock(&ml_mutex);
+    return ML_STATUS_OK;
+#endif
+    
+#ifdef CONFIG_ML_WEIGHT_STREAM
+    /* Stream the weights from flash; the interpreter, if built, is the
+     * fallback for models or partitions the streaming backend cannot use */
+    int stream_ret = weight_stream_init();
+    if (stream_ret == 0) {
+        use_weight_stream = true;
+        output_is_logits = true;  /* Last FC output, softmax is skipped */
+        ml_initialized = true;
+        LOG_INF("ML inference engine ready (weight streaming)");
+        lockstat_mutex_unlock(&ml_mutex);
+        return ML_STATUS_OK;
+    }
+#ifdef CONFIG_ML_TFLM
+    LOG_WRN("Weight streaming unavailable (%d), using the interpreter",
+            stream_ret);
+#else
+    LOG_ERR("Weight streaming unavailable (%d)", stream_ret);
+    LOG_WRN("Falling back to MOCK inference mode");
+    use_mock_inference = true;
+    ml_initialized = true;
+    lockstat_mutex_unlock(&ml_mutex);
+    return ML_STATUS_OK;
+#endif
+#endif
+    
+#ifdef CONFIG_ML_TFLM
     LOG_INF("  Tensor arena size: %d bytes", CONFIG_ML_TENSOR_ARENA_SIZE);
     LOG_INF("  Model size: %d bytes", gesture_model_data_len);
     
@@ -187,7 +324,7 @@ ml_status_t ml_inference_init(void)
         LOG_WRN("Falling back to MOCK inference mode");
         use_mock_inference = true;
         ml_initialized = true;
-        k_mutex_unlock(&ml_mutex);
+        lockstat_mutex_unlock(&ml_mutex);
         return ML_STATUS_OK;
     }
     
@@ -197,7 +334,7 @@ ml_status_t ml_inference_init(void)
         LOG_WRN("Falling back to MOCK inference mode");
         use_mock_inference = true;
         ml_initialized = true;
-        k_mutex_unlock(&ml_mutex);
+        lockstat_mutex_unlock(&ml_mutex);
         return ML_STATUS_OK;
     }
     
@@ -207,7 +344,7 @@ ml_status_t ml_inference_init(void)
         LOG_WRN("Falling back to MOCK inference mode");
         use_mock_inference = true;
         ml_initialized = true;
-        k_mutex_unlock(&ml_mutex);
+        lockstat_mutex_unlock(&ml_mutex);
         return ML_STATUS_OK;
     }
     
@@ -220,7 +357,7 @@ ml_status_t ml_inference_init(void)
     TfLiteStatus status = interpreter->AllocateTensors();
     if (status != kTfLiteOk) {
         LOG_ERR("Failed to allocate tensors");
-        k_mutex_unlock(&ml_mutex);
+        lockstat_mutex_unlock(&ml_mutex);
         return ML_STATUS_ALLOC_FAILED;
     }
     
@@ -230,7 +367,7 @@ ml_status_t ml_inference_init(void)
     
     if (input_tensor == nullptr || output_tensor == nullptr) {
         LOG_ERR("Failed to get input/output tensors");
-        k_mutex_unlock(&ml_mutex);
+        lockstat_mutex_unlock(&ml_mutex);
         return ML_STATUS_ERROR;
     }
     
@@ -244,28 +381,27 @@ ml_status_t ml_inference_init(void)
             output_tensor->bytes,
             output_tensor->type);
     
-    /* Initialize statistics */
-    ml_stats.inference_count = 0;
-    ml_stats.min_time_us = UINT32_MAX;
-    ml_stats.max_time_us = 0;
-    ml_stats.total_time_us = 0;
-    ml_stats.invoke_failures = 0;
+    output_is_logits = !output_is_probability(output_tensor);
+    if (output_is_logits) {
+        LOG_INF("  Output is logits (softmax stripped), applying on device");
+    }
     
-    inference_sequence = 0;
     ml_initialized = true;
     
     size_t arena_used = interpreter->arena_used_bytes();
     LOG_INF("ML inference engine ready (arena used: %zu/%d bytes)",
             arena_used, CONFIG_ML_TENSOR_ARENA_SIZE);
+    memmap_add("tensor_arena", sizeof(tensor_arena), arena_used);
     
-    k_mutex_unlock(&ml_mutex);
+    lockstat_mutex_unlock(&ml_mutex);
     return ML_STATUS_OK;
+#endif /* CONFIG_ML_TFLM */
 }
 
 ml_status_t ml_run_inference(const int8_t *input_data, inference_result_t *result)
 {
     uint32_t start_time, end_time;
-    TfLiteStatus status;
+    bool invoke_ok;
     
     if (!ml_initialized) {
         return ML_STATUS_NOT_INITIALIZED;
@@ -275,10 +411,11 @@ ml_status_t ml_run_inference(const int8_t *input_data, inference_result_t *resul
         return ML_STATUS_INVALID_INPUT;
     }
     
-    k_mutex_lock(&ml_mutex, K_FOREVER);
+    lockstat_mutex_lock(&ml_mutex, K_FOREVER);
     
+#ifdef CONFIG_ML_TFLM
     /* Copy input data to tensor */
-    if (!use_mock_inference) {
+    if (!use_mock_inference && !use_weight_stream) {
         size_t input_size = input_tensor->bytes;
         int8_t *input_ptr = input_tensor->data.int8;
         
@@ -286,17 +423,38 @@ ml_status_t ml_run_inference(const int8_t *input_data, inference_result_t *resul
             input_ptr[i] = input_data[i];
         }
     }
+#endif
     
     /* Run inference with timing */
     start_time = k_cycle_get_32();
     
+    gesture_label_t synth_gesture = GESTURE_IDLE;
+    
+    INSN_MARK(invoke_begin);
     if (use_mock_inference) {
-        /* Mock inference simulation */
-        k_busy_wait(5000); /* Simulate 5ms load */
-        status = kTfLiteOk;
+        /* Synthetic load model (see synthetic_inference.c) */
+        synth_gesture = synthetic_inference_run(result->class_scores);
+        invoke_ok = true;
+#ifdef CONFIG_ML_WEIGHT_STREAM
+    } else if (use_weight_stream) {
+        invoke_ok = weight_stream_run(input_data, stream_output,
+                                      sizeof(stream_output)) == 0;
+#endif
+#ifdef CONFIG_ML_TREE_CLASSIFIER
+    } else {
+        invoke_ok = tree_classifier_run(input_data, ML_INPUT_SIZE,
+                                        result->class_scores) == 0;
+    }
+#elif defined(CONFIG_ML_TFLM)
     } else {
-        status = interpreter->Invoke();
+        invoke_ok = interpreter->Invoke() == kTfLiteOk;
     }
+#else
+    } else {
+        invoke_ok = false;  /* Streaming is the only backend */
+    }
+#endif
+    INSN_MARK(invoke_end);
     
     end_time = k_cycle_get_32();
     
@@ -305,59 +463,55 @@ ml_status_t ml_run_inference(const int8_t *input_data, inference_result_t *resul
     uint32_t freq_mhz = sys_clock_hw_cycles_per_sec() / 1000000;
     uint32_t inference_time_us = (freq_mhz > 0) ? (cycles / freq_mhz) : 0;
     
-    if (status != kTfLiteOk) {
+    if (!invoke_ok) {
         LOG_ERR("Inference invoke failed");
         ml_stats.invoke_failures++;
-        k_mutex_unlock(&ml_mutex);
+        lockstat_mutex_unlock(&ml_mutex);
         return ML_STATUS_INVOKE_FAILED;
     }
     
-    /* Extract output probabilities */
     /* Extract output probabilities */
     int8_t *output_ptr = nullptr;
     float scale = 0.0f;
     int32_t zero_point = 0;
     
-    if (!use_mock_inference) {
+#ifdef CONFIG_ML_WEIGHT_STREAM
+    if (use_weight_stream) {
+        output_ptr = stream_output;
+        weight_stream_output_quant(&scale, &zero_point);
+    }
+#endif
+#ifdef CONFIG_ML_TFLM
+    if (!use_mock_inference && !use_weight_stream) {
         output_ptr = output_tensor->data.int8;
         scale = output_tensor->params.scale;
         zero_point = output_tensor->params.zero_point;
     }
+#endif
     
     float max_score = -1000.0f;
     gesture_label_t best_gesture = GESTURE_IDLE;
     
     if (use_mock_inference) {
-        /* Generate synthetic confidence scores */
-        /* Default to IDLE */
-        best_gesture = GESTURE_IDLE;
-        max_score = 0.95f;
-        
-        result->class_scores[0] = 0.95f;
-        result->class_scores[1] = 0.02f;
-        result->class_scores[2] = 0.02f;
-        result->class_scores[3] = 0.01f;
+        /* Scores were filled in by the synthetic backend */
+        best_gesture = synth_gesture;
+        max_score = result->class_scores[synth_gesture];
+    } else {
+        /* The tree backend wrote its logits directly */
+        if (!use_tree_classifier) {
+            for (int i = 0; i < GESTURE_COUNT; i++) {
+                /* Dequantize output */
+                result->class_scores[i] = (output_ptr[i] - zero_point) * scale;
+            }
+        }
         
-        /* Occasionally detect a gesture based on sequence */
-        if (inference_sequence % 50 == 25) {
-            best_gesture = GESTURE_WAVE;
-            max_score = 0.85f;
-            result->class_scores[1] = 0.85f;
-            result->class_scores[0] = 0.10f;
-        } else if (inference_sequence % 50 == 35) {
-            best_gesture = GESTURE_TAP;
-            max_score = 0.90f;
-            result->class_scores[2] = 0.90f;
-            result->class_scores[0] = 0.05f;
+        if (output_is_logits) {
+            scores_softmax(result->class_scores);
         }
-    } else {
+        
         for (int i = 0; i < GESTURE_COUNT; i++) {
-            /* Dequantize output */
-            float score = (output_ptr[i] - zero_point) * scale;
-            result->class_scores[i] = score;
-            
-            if (score > max_score) {
-                max_score = score;
+            if (result->class_scores[i] > max_score) {
+                max_score = result->class_scores[i];
                 best_gesture = (gesture_label_t)i;
             }
         }
@@ -387,7 +541,7 @@ ml_status_t ml_run_inference(const int8_t *input_data, inference_result_t *resul
             max_score,
             inference_time_us);
     
-    k_mutex_unlock(&ml_mutex);
+    lockstat_mutex_unlock(&ml_mutex);
     return ML_STATUS_OK;
 }
 
@@ -397,16 +551,16 @@ ml_status_t ml_get_stats(ml_stats_t *stats)
         return ML_STATUS_INVALID_INPUT;
     }
     
-    k_mutex_lock(&ml_mutex, K_FOREVER);
+    lockstat_mutex_lock(&ml_mutex, K_FOREVER);
     *stats = ml_stats;
-    k_mutex_unlock(&ml_mutex);
+    lockstat_mutex_unlock(&ml_mutex);
     
     return ML_STATUS_OK;
 }
 
 void ml_reset_stats(void)
 {
-    k_mutex_lock(&ml_mutex, K_FOREVER);
+    lockstat_mutex_lock(&ml_mutex, K_FOREVER);
     
     ml_stats.inference_count = 0;
     ml_stats.min_time_us = UINT32_MAX;
@@ -414,7 +568,7 @@ void ml_reset_stats(void)
     ml_stats.total_time_us = 0;
     ml_stats.invoke_failures = 0;
     
-    k_mutex_unlock(&ml_mutex);
+    lockstat_mutex_unlock(&ml_mutex);
     
     LOG_INF("ML statistics reset");
 }
@@ -429,10 +583,14 @@ const char *ml_gesture_to_string(gesture_label_t gesture)
 
 size_t ml_get_arena_used(void)
 {
+#ifndef CONFIG_ML_TFLM
+    return 0;
+#else
     if (!ml_initialized || interpreter == nullptr) {
         return 0;
     }
     return interpreter->arena_used_bytes();
+#endif
 }
 
 bool ml_is_ready(void)
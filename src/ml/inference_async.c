@@ -0,0 +1,219 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Zephyr Edge AI Demo - Asynchronous Inference Executor
+ *
+ * Slots form a ring walked by three indices: submitters fill at
+ * submit_idx, the executor thread runs at exec_idx and pollers deliver
+ * at deliver_idx. Three semaphores count the slots between them (free,
+ * queued for the executor, finished), so every hand-off is a semaphore
+ * give/take and the same code is correct on single-core and SMP
+ * builds. There is one executor because the interpreter is a single
+ * instance; on SMP it runs inferences on one core while the submitting
+ * thread prepares the next window on another.
+ */
+
+#include "inference_async.h"
+#include "memmap.h"
+#include "sched_check.h"
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <string.h>
+
+LOG_MODULE_REGISTER(ml_async, CONFIG_LOG_DEFAULT_LEVEL);
+
+/* ============================================================================
+ * Configuration
+ * ============================================================================ */
+
+#ifndef CONFIG_ML_ASYNC_DEPTH
+#define CONFIG_ML_ASYNC_DEPTH 2
+#endif
+
+#ifndef CONFIG_ML_ASYNC_PRIORITY
+#define CONFIG_ML_ASYNC_PRIORITY 8
+#endif
+
+#ifndef CONFIG_ML_ASYNC_STACK_SIZE
+#define CONFIG_ML_ASYNC_STACK_SIZE 4096
+#endif
+
+/* ============================================================================
+ * Private Data
+ * ============================================================================ */
+
+/**
+ * @brief In-flight window
+ */
+struct ml_job {
+    int8_t input[ML_INPUT_SIZE];
+    inference_result_t result;
+    ml_status_t status;
+    ml_complete_cb_t cb;
+    void *user_data;
+    /** Cycle counter at submission */
+    uint32_t submit_cyc;
+};
+
+static struct ml_job jobs[CONFIG_ML_ASYNC_DEPTH];
+
+/** Next slot to fill (submit_mutex) */
+static uint32_t submit_idx = 0;
+
+/** Next slot to deliver (poll_mutex) */
+static uint32_t deliver_idx = 0;
+
+static K_SEM_DEFINE(free_sem, CONFIG_ML_ASYNC_DEPTH, CONFIG_ML_ASYNC_DEPTH);
+static K_SEM_DEFINE(work_sem, 0, CONFIG_ML_ASYNC_DEPTH);
+static K_SEM_DEFINE(done_sem, 0, CONFIG_ML_ASYNC_DEPTH);
+
+static K_MUTEX_DEFINE(submit_mutex);
+static K_MUTEX_DEFINE(poll_mutex);
+
+static ml_async_stats_t stats = {0};
+static struct k_spinlock stats_lock;
+
+static K_THREAD_STACK_DEFINE(executor_stack, CONFIG_ML_ASYNC_STACK_SIZE);
+static struct k_thread executor_thread;
+
+/* ============================================================================
+ * Private Functions
+ * ============================================================================ */
+
+/**
+ * @brief Executor thread: run queued windows in submission order
+ */
+static void executor_fn(void *p1, void *p2, void *p3)
+{
+    ARG_UNUSED(p1);
+    ARG_UNUSED(p2);
+    ARG_UNUSED(p3);
+
+    uint32_t exec_idx = 0;
+    sched_job_t sched_job;
+
+    for (;;) {
+        k_sem_take(&work_sem, K_FOREVER);
+
+        struct ml_job *job = &jobs[exec_idx];
+
+        sched_check_job_begin(&sched_job);
+        job->status = ml_run_inference(job->input, &job->result);
+        sched_check_job_end(SCHED_TASK_ML_EXEC, &sched_job);
+        exec_idx = (exec_idx + 1) % CONFIG_ML_ASYNC_DEPTH;
+
+        k_sem_give(&done_sem);
+    }
+}
+
+/* ============================================================================
+ * Public API Implementation
+ * ============================================================================ */
+
+int ml_async_init(void)
+{
+    k_thread_create(&executor_thread, executor_stack,
+                    K_THREAD_STACK_SIZEOF(executor_stack),
+                    executor_fn, NULL, NULL, NULL,
+                    CONFIG_ML_ASYNC_PRIORITY, 0, K_NO_WAIT);
+    k_thread_name_set(&executor_thread, "ml_exec");
+
+    memmap_add("ml_async_slots", sizeof(jobs), MEMMAP_USED_UNKNOWN);
+    memmap_add_thread("stack_ml_exec", &executor_thread);
+
+    LOG_INF("Async inference: depth %d, executor priority %d",
+            CONFIG_ML_ASYNC_DEPTH, CONFIG_ML_ASYNC_PRIORITY);
+    return 0;
+}
+
+int ml_submit(const int8_t *window, ml_complete_cb_t cb, void *user_data,
+              k_timeout_t timeout)
+{
+    if (window == NULL || cb == NULL) {
+        return -EINVAL;
+    }
+
+    if (k_sem_take(&free_sem, timeout) != 0) {
+        k_spinlock_key_t key = k_spin_lock(&stats_lock);
+        stats.rejected++;
+        k_spin_unlock(&stats_lock, key);
+        return -EAGAIN;
+    }
+
+    /* Claim, fill and queue under one lock so the executor sees slots
+     * in the order they were claimed */
+    k_mutex_lock(&submit_mutex, K_FOREVER);
+
+    struct ml_job *job = &jobs[submit_idx];
+
+    memcpy(job->input, window, sizeof(job->input));
+    job->cb = cb;
+    job->user_data = user_data;
+    job->submit_cyc = k_cycle_get_32();
+    submit_idx = (submit_idx + 1) % CONFIG_ML_ASYNC_DEPTH;
+
+    k_spinlock_key_t key = k_spin_lock(&stats_lock);
+    stats.submitted++;
+    stats.in_flight++;
+    stats.max_in_flight = MAX(stats.max_in_flight, stats.in_flight);
+    k_spin_unlock(&stats_lock, key);
+
+    k_sem_give(&work_sem);
+
+    k_mutex_unlock(&submit_mutex);
+
+    return 0;
+}
+
+int ml_poll(k_timeout_t timeout)
+{
+    int delivered = 0;
+
+    k_mutex_lock(&poll_mutex, K_FOREVER);
+
+    while (k_sem_take(&done_sem, delivered == 0 ? timeout : K_NO_WAIT) == 0) {
+        struct ml_job *job = &jobs[deliver_idx];
+        uint32_t latency_us = k_cyc_to_us_floor32(k_cycle_get_32() -
+                                                  job->submit_cyc);
+
+        job->cb(&job->result, job->status, job->user_data);
+        deliver_idx = (deliver_idx + 1) % CONFIG_ML_ASYNC_DEPTH;
+
+        k_spinlock_key_t key = k_spin_lock(&stats_lock);
+        stats.completed++;
+        stats.in_flight--;
+        stats.max_latency_us = MAX(stats.max_latency_us, latency_us);
+        k_spin_unlock(&stats_lock, key);
+
+        /* Slot is reusable only after its callback returned */
+        k_sem_give(&free_sem);
+        delivered++;
+    }
+
+    k_mutex_unlock(&poll_mutex);
+
+    return delivered;
+}
+
+void ml_poll_event_init(struct k_poll_event *event)
+{
+    k_poll_event_init(event, K_POLL_TYPE_SEM_AVAILABLE,
+                      K_POLL_MODE_NOTIFY_ONLY, &done_sem);
+}
+
+void ml_async_get_stats(ml_async_stats_t *out)
+{
+    if (out == NULL) {
+        return;
+    }
+
+    k_spinlock_key_t key = k_spin_lock(&stats_lock);
+    *out = stats;
+    k_spin_unlock(&stats_lock, key);
+}
+
+const struct k_thread *ml_async_thread(void)
+{
+    return &executor_thread;
+}
@@ -0,0 +1,126 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Zephyr Edge AI Demo - Asynchronous Inference Executor
+ *
+ * ml_submit() copies a window into one of CONFIG_ML_ASYNC_DEPTH
+ * in-flight slots and returns; an executor thread runs the inferences
+ * in submission order. ml_poll() delivers finished results to their
+ * completion callbacks, in submission order, from the polling thread.
+ * A full set of slots is backpressure: ml_submit() waits up to its
+ * timeout for a slot and then fails instead of queueing without bound.
+ */
+
+#ifndef INFERENCE_ASYNC_H
+#define INFERENCE_ASYNC_H
+
+#include "inference.h"
+
+#include <zephyr/kernel.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Completion callback
+ *
+ * Runs in the thread that called ml_poll().
+ *
+ * @param result Inference result (valid only during the call)
+ * @param status Inference status; result is meaningful only if ML_STATUS_OK
+ * @param user_data Pointer passed to ml_submit()
+ */
+typedef void (*ml_complete_cb_t)(const inference_result_t *result,
+                                 ml_status_t status, void *user_data);
+
+/**
+ * @brief Executor statistics
+ */
+typedef struct {
+    /** Windows accepted by ml_submit() */
+    uint32_t submitted;
+
+    /** Results delivered by ml_poll() */
+    uint32_t completed;
+
+    /** Submissions refused because every slot was in flight */
+    uint32_t rejected;
+
+    /** Windows submitted but not yet delivered */
+    uint32_t in_flight;
+
+    /** Highest in_flight seen */
+    uint32_t max_in_flight;
+
+    /** Longest submit-to-delivery time (us) */
+    uint32_t max_latency_us;
+} ml_async_stats_t;
+
+/**
+ * @brief Start the executor thread
+ *
+ * Call after ml_inference_init().
+ *
+ * @return 0 on success
+ */
+int ml_async_init(void);
+
+/**
+ * @brief Submit a window for inference
+ *
+ * The window is copied, so the caller may reuse its buffer at once.
+ *
+ * @param window Preprocessed input (ML_INPUT_SIZE, INT8)
+ * @param cb Completion callback
+ * @param user_data Passed to cb
+ * @param timeout How long to wait for a free slot
+ * @return 0 on success, -EINVAL on bad arguments, -EAGAIN if no slot
+ *         became free within the timeout
+ */
+int ml_submit(const int8_t *window, ml_complete_cb_t cb, void *user_data,
+              k_timeout_t timeout);
+
+/**
+ * @brief Deliver finished results to their callbacks
+ *
+ * Waits up to the timeout for the oldest in-flight window to finish,
+ * then delivers it and every other result already finished, in
+ * submission order.
+ *
+ * @param timeout How long to wait for the first result
+ * @return Number of results delivered
+ */
+int ml_poll(k_timeout_t timeout);
+
+/**
+ * @brief Initialize a k_poll event that is ready when ml_poll() has a
+ *        result to deliver
+ *
+ * Lets a thread wait for new windows and finished inferences together.
+ * Reset the event state to K_POLL_STATE_NOT_READY after each k_poll().
+ *
+ * @param[out] event Event to initialize
+ */
+void ml_poll_event_init(struct k_poll_event *event);
+
+/**
+ * @brief Get executor statistics
+ *
+ * @param[out] stats Statistics
+ */
+void ml_async_get_stats(ml_async_stats_t *stats);
+
+/**
+ * @brief Executor thread, which runs the inferences
+ *
+ * For per-thread accounting (scheduling analysis, energy).
+ */
+const struct k_thread *ml_async_thread(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INFERENCE_ASYNC_H */
@@ -0,0 +1,149 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Zephyr Edge AI Demo - Streaming Gesture Onset Detector
+ *
+ * Integer-only segmenter run once per sample:
+ *   1. Energy = L1 magnitude of the DC-removed sample
+ *   2. Envelope = fast exponential moving average of the energy
+ *   3. Noise floor = slow moving average of the envelope, only updated
+ *      while below threshold so gestures do not raise it
+ *   4. Onset when the envelope crosses
+ *      max(noise_floor * ratio, min_level) outside the refractory period
+ *   5. Offset when the envelope falls back below 3/4 of the threshold;
+ *      a new onset requires a preceding offset so a long gesture cannot
+ *      re-trigger once the refractory period expires
+ */
+
+#include "onset_detector.h"
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+
+LOG_MODULE_REGISTER(onset_detector, CONFIG_LOG_DEFAULT_LEVEL);
+
+/* ============================================================================
+ * Configuration
+ * ============================================================================ */
+
+#ifndef CONFIG_SENSOR_SAMPLE_RATE_HZ
+#define CONFIG_SENSOR_SAMPLE_RATE_HZ 100
+#endif
+
+#ifndef CONFIG_ML_ONSET_THRESHOLD_RATIO
+#define CONFIG_ML_ONSET_THRESHOLD_RATIO 300
+#endif
+
+#ifndef CONFIG_ML_ONSET_MIN_LEVEL
+#define CONFIG_ML_ONSET_MIN_LEVEL 500
+#endif
+
+#ifndef CONFIG_ML_ONSET_REFRACTORY_MS
+#define CONFIG_ML_ONSET_REFRACTORY_MS 500
+#endif
+
+/** Envelope smoothing: alpha = 1/4 (~4 sample time constant) */
+#define ENVELOPE_SHIFT 2
+
+/** Noise floor smoothing: alpha = 1/64 */
+#define FLOOR_SHIFT 6
+
+/** Fixed-point fraction bits kept in the filter states */
+#define STATE_FRAC_BITS 8
+
+/** Refractory period in samples */
+#define REFRACTORY_SAMPLES \
+    ((CONFIG_ML_ONSET_REFRACTORY_MS * CONFIG_SENSOR_SAMPLE_RATE_HZ) / 1000)
+
+/* ============================================================================
+ * Private Data
+ * ============================================================================ */
+
+/** Filter states in Q(STATE_FRAC_BITS) raw units */
+static int32_t envelope_q = 0;
+static int32_t floor_q = 0;
+
+static uint32_t refractory_left = 0;
+static bool active = false;
+static onset_stats_t stats = {0};
+
+/* ============================================================================
+ * Private Functions
+ * ============================================================================ */
+
+static inline int32_t abs32(int32_t v)
+{
+    return (v < 0) ? -v : v;
+}
+
+static uint32_t current_threshold(void)
+{
+    uint32_t floor_raw = (uint32_t)(floor_q >> STATE_FRAC_BITS);
+    uint32_t threshold = (floor_raw * CONFIG_ML_ONSET_THRESHOLD_RATIO) / 100;
+
+    return (threshold > CONFIG_ML_ONSET_MIN_LEVEL) ?
+           threshold : CONFIG_ML_ONSET_MIN_LEVEL;
+}
+
+/* ============================================================================
+ * Public API Implementation
+ * ============================================================================ */
+
+void onset_detector_init(void)
+{
+    envelope_q = 0;
+    floor_q = 0;
+    refractory_left = 0;
+    active = false;
+    stats = (onset_stats_t){0};
+
+    LOG_INF("Onset detector: ratio %d%%, min level %d, refractory %d samples",
+            CONFIG_ML_ONSET_THRESHOLD_RATIO, CONFIG_ML_ONSET_MIN_LEVEL,
+            REFRACTORY_SAMPLES);
+}
+
+bool onset_detector_update(int32_t dx, int32_t dy, int32_t dz)
+{
+    int32_t energy_q = (abs32(dx) + abs32(dy) + abs32(dz)) << STATE_FRAC_BITS;
+    bool onset = false;
+
+    envelope_q += (energy_q - envelope_q) >> ENVELOPE_SHIFT;
+
+    uint32_t envelope = (uint32_t)(envelope_q >> STATE_FRAC_BITS);
+    uint32_t threshold = current_threshold();
+
+    if (active) {
+        if (envelope < (threshold * 3) / 4) {
+            active = false;
+            stats.offsets++;
+        }
+    } else if (envelope < threshold) {
+        /* Quiet: track the noise floor */
+        floor_q += (envelope_q - floor_q) >> FLOOR_SHIFT;
+    } else if (refractory_left == 0) {
+        onset = true;
+        active = true;
+        refractory_left = REFRACTORY_SAMPLES;
+        stats.onsets++;
+    } else {
+        stats.suppressed++;
+    }
+
+    if (refractory_left > 0 && !onset) {
+        refractory_left--;
+    }
+
+    stats.envelope = envelope;
+    stats.threshold = threshold;
+    stats.noise_floor = (uint32_t)(floor_q >> STATE_FRAC_BITS);
+
+    return onset;
+}
+
+void onset_detector_get_stats(onset_stats_t *out)
+{
+    if (out == NULL) {
+        return;
+    }
+    *out = stats;
+}
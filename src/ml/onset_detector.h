@@ -0,0 +1,72 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Zephyr Edge AI Demo - Streaming Gesture Onset Detector
+ *
+ * Energy-envelope onset segmenter used by preprocessing to align
+ * inference windows with gesture onsets instead of running fixed,
+ * arbitrarily phased windows.
+ */
+
+#ifndef ONSET_DETECTOR_H
+#define ONSET_DETECTOR_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Onset detector statistics
+ */
+typedef struct {
+    /** Onsets detected since initialization */
+    uint32_t onsets;
+
+    /** Gesture offsets (envelope back below threshold) */
+    uint32_t offsets;
+
+    /** Threshold crossings ignored during the refractory period */
+    uint32_t suppressed;
+
+    /** Current energy envelope (raw units) */
+    uint32_t envelope;
+
+    /** Current adaptive threshold (raw units) */
+    uint32_t threshold;
+
+    /** Current noise floor estimate (raw units) */
+    uint32_t noise_floor;
+} onset_stats_t;
+
+/**
+ * @brief Reset the detector state
+ */
+void onset_detector_init(void);
+
+/**
+ * @brief Feed one DC-removed sample to the detector
+ *
+ * Not thread-safe; called from preprocessing under its mutex.
+ *
+ * @param dx X-axis value with DC offset removed (raw units)
+ * @param dy Y-axis value with DC offset removed (raw units)
+ * @param dz Z-axis value with DC offset removed (raw units)
+ * @return true if this sample is a gesture onset
+ */
+bool onset_detector_update(int32_t dx, int32_t dy, int32_t dz);
+
+/**
+ * @brief Get detector statistics
+ *
+ * @param[out] stats Pointer to statistics structure
+ */
+void onset_detector_get_stats(onset_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ONSET_DETECTOR_H */
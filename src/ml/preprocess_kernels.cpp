@@ -0,0 +1,276 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Zephyr Edge AI Demo - Preprocessing Kernels
+ *
+ * The window conversion is templated on window length, channel count
+ * and quantization scheme. With all three known at compile time the
+ * compiler drops the per-sample ring modulo (a window is at most two
+ * contiguous spans, and usually one with a constant trip count), turns
+ * the clamps into saturating instructions, unrolls the channel loop and
+ * folds the scale. The float scheme performs exactly the operations of
+ * the generic loop and gives bit-identical output; the fixed scheme
+ * rounds the DC offsets to integers once per window and needs no
+ * floating point in the loop, which matters on cores without an FPU.
+ *
+ * One instance is built per window length in use (primary and
+ * multi-resolution views, plus the benchmark sizes); anything else
+ * takes the generic loop.
+ */
+
+#include "preprocess_kernels.h"
+#include "inference.h"
+#ifdef CONFIG_DEBUG_PREPROC_BENCH
+#include "preproc_bench.h"
+#endif
+
+#include <zephyr/kernel.h>
+
+#ifdef CONFIG_ML_PREPROC_KERNELS
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#endif
+
+/* ============================================================================
+ * Configuration
+ * ============================================================================ */
+
+#ifdef CONFIG_ML_MULTI_RES_VIEWS
+#define VIEW_WINDOWS , CONFIG_ML_VIEW_SHORT_SIZE, CONFIG_ML_VIEW_LONG_SIZE
+#else
+#define VIEW_WINDOWS
+#endif
+
+#ifdef CONFIG_DEBUG_PREPROC_BENCH
+#define BENCH_WINDOWS , PREPROC_BENCH_WINDOWS
+#else
+#define BENCH_WINDOWS
+#endif
+
+/* ============================================================================
+ * Kernels
+ * ============================================================================ */
+
+#ifdef CONFIG_ML_PREPROC_KERNELS
+namespace {
+
+/**
+ * @brief Float quantization, identical to the generic loop
+ */
+struct quant_float {
+    static constexpr const char *name = "float";
+
+    struct state {
+        float dc[3];
+    };
+
+    static state prepare(const float dc_offset[3])
+    {
+        return state{{dc_offset[0], dc_offset[1], dc_offset[2]}};
+    }
+
+    template <size_t Axis>
+    static int32_t quantize(int16_t raw, const state &st)
+    {
+        return (int32_t)(((float)raw - st.dc[Axis]) * PREPROC_QUANT_SCALE);
+    }
+};
+
+/**
+ * @brief Integer quantization with DC offsets rounded per window
+ *
+ * Truncates toward zero like the float scheme; outputs differ from it
+ * by at most one step where the DC rounding crosses a boundary.
+ */
+struct quant_fixed {
+    static constexpr const char *name = "fixed";
+
+    struct state {
+        int32_t dc[3];
+    };
+
+    static int32_t round_dc(float dc)
+    {
+        return (int32_t)(dc + (dc >= 0.0f ? 0.5f : -0.5f));
+    }
+
+    static state prepare(const float dc_offset[3])
+    {
+        return state{{round_dc(dc_offset[0]), round_dc(dc_offset[1]),
+                      round_dc(dc_offset[2])}};
+    }
+
+    template <size_t Axis>
+    static int32_t quantize(int16_t raw, const state &st)
+    {
+        /* ±16384 to ±127; constant divisor becomes a shift */
+        return ((int32_t)raw - st.dc[Axis]) * 127 / 16384;
+    }
+};
+
+#ifdef CONFIG_ML_PREPROC_QUANT_FIXED
+using quant_scheme = quant_fixed;
+#else
+using quant_scheme = quant_float;
+#endif
+
+template <size_t Axis>
+int16_t sample_axis(const struct accel_sample &s)
+{
+    static_assert(Axis < 3, "Accelerometer has three axes");
+
+    if constexpr (Axis == 0) {
+        return s.x;
+    } else if constexpr (Axis == 1) {
+        return s.y;
+    } else {
+        return s.z;
+    }
+}
+
+inline int8_t saturate(int32_t q)
+{
+    return (int8_t)std::clamp<int32_t>(q, INT8_MIN, INT8_MAX);
+}
+
+template <typename Quant, size_t... Axes>
+inline void convert_sample(const struct accel_sample &s,
+                           const typename Quant::state &st, int8_t *out,
+                           std::index_sequence<Axes...>)
+{
+    ((out[Axes] = saturate(Quant::template quantize<Axes>(sample_axis<Axes>(s),
+                                                          st))), ...);
+}
+
+/**
+ * @brief Convert a contiguous run of samples
+ */
+template <size_t Channels, typename Quant>
+inline void convert_span(const struct accel_sample *src, size_t n,
+                         const typename Quant::state &st, int8_t *out)
+{
+    for (size_t i = 0; i < n; i++) {
+        convert_sample<Quant>(src[i], st, out + i * Channels,
+                              std::make_index_sequence<Channels>{});
+    }
+}
+
+/**
+ * @brief Convert one window of Window samples from the ring
+ */
+template <size_t Window, size_t Channels, typename Quant>
+void quantize_window(const struct accel_sample *ring, size_t ring_size,
+                     size_t start, const float dc_offset[3], int8_t *output)
+{
+    static_assert(Window > 0, "Empty window");
+    static_assert(Channels > 0 && Channels <= 3, "Channels must be 1..3");
+
+    const typename Quant::state st = Quant::prepare(dc_offset);
+    size_t first = ring_size - start;
+
+    if (first >= Window) {
+        /* Window does not wrap: constant trip count */
+        convert_span<Channels, Quant>(ring + start, Window, st, output);
+    } else {
+        convert_span<Channels, Quant>(ring + start, first, st, output);
+        convert_span<Channels, Quant>(ring, Window - first, st,
+                                      output + first * Channels);
+    }
+}
+
+/**
+ * @brief Run the instance matching count, if any
+ *
+ * @return true if an instance handled the window
+ */
+template <size_t... Windows>
+bool dispatch(const struct accel_sample *ring, size_t ring_size, size_t start,
+              size_t count, const float dc_offset[3], int8_t *output)
+{
+    return ((count == Windows &&
+             (quantize_window<Windows, ML_INPUT_AXES, quant_scheme>(
+                  ring, ring_size, start, dc_offset, output), true)) || ...);
+}
+
+template <size_t... Windows>
+constexpr bool has_instance(size_t count)
+{
+    return ((count == Windows) || ...);
+}
+
+} /* namespace */
+#endif /* CONFIG_ML_PREPROC_KERNELS */
+
+/* ============================================================================
+ * Public API Implementation
+ * ============================================================================ */
+
+void preprocess_quantize_generic(const struct accel_sample *ring,
+                                 size_t ring_size, size_t start, size_t count,
+                                 const float dc_offset[3], int8_t *output)
+{
+    size_t out_idx = 0;
+    size_t idx = start;
+
+    for (size_t i = 0; i < count; i++) {
+        const struct accel_sample *s = &ring[idx];
+
+        /* Remove DC offset and quantize */
+        float x = (float)s->x - dc_offset[0];
+        float y = (float)s->y - dc_offset[1];
+        float z = (float)s->z - dc_offset[2];
+
+        /* Quantize to INT8 */
+        int32_t qx = (int32_t)(x * PREPROC_QUANT_SCALE);
+        int32_t qy = (int32_t)(y * PREPROC_QUANT_SCALE);
+        int32_t qz = (int32_t)(z * PREPROC_QUANT_SCALE);
+
+        /* Clamp to INT8 range */
+        qx = (qx < -128) ? -128 : (qx > 127) ? 127 : qx;
+        qy = (qy < -128) ? -128 : (qy > 127) ? 127 : qy;
+        qz = (qz < -128) ? -128 : (qz > 127) ? 127 : qz;
+
+        output[out_idx++] = (int8_t)qx;
+        output[out_idx++] = (int8_t)qy;
+        output[out_idx++] = (int8_t)qz;
+
+        idx = (idx + 1) % ring_size;
+    }
+}
+
+void preprocess_quantize(const struct accel_sample *ring, size_t ring_size,
+                         size_t start, size_t count,
+                         const float dc_offset[3], int8_t *output)
+{
+#ifdef CONFIG_ML_PREPROC_KERNELS
+    if (dispatch<CONFIG_ML_INFERENCE_WINDOW_SIZE VIEW_WINDOWS BENCH_WINDOWS>(
+            ring, ring_size, start, count, dc_offset, output)) {
+        return;
+    }
+#endif
+
+    preprocess_quantize_generic(ring, ring_size, start, count, dc_offset,
+                                output);
+}
+
+bool preprocess_kernel_specialized(size_t count)
+{
+#ifdef CONFIG_ML_PREPROC_KERNELS
+    return has_instance<CONFIG_ML_INFERENCE_WINDOW_SIZE VIEW_WINDOWS
+                        BENCH_WINDOWS>(count);
+#else
+    ARG_UNUSED(count);
+    return false;
+#endif
+}
+
+const char *preprocess_kernel_scheme(void)
+{
+#ifdef CONFIG_ML_PREPROC_KERNELS
+    return quant_scheme::name;
+#else
+    return "generic";
+#endif
+}
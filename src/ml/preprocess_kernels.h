@@ -0,0 +1,72 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Zephyr Edge AI Demo - Preprocessing Kernels
+ *
+ * DC removal and INT8 quantization of one window from the sample ring.
+ * With CONFIG_ML_PREPROC_KERNELS the work is done by C++ templates
+ * instantiated for each window length known at build time (primary and
+ * multi-resolution views); other lengths fall back to the generic loop.
+ */
+
+#ifndef PREPROCESS_KERNELS_H
+#define PREPROCESS_KERNELS_H
+
+#include "sensor_hal.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Quantization scale (input range to INT8) */
+#define PREPROC_QUANT_SCALE (127.0f / 16384.0f)  /* Map ±16384 to ±127 */
+
+/**
+ * @brief Quantize one window using the generic runtime-bounds loop
+ *
+ * Reference implementation, always available.
+ *
+ * @param ring Sample ring
+ * @param ring_size Ring length in samples
+ * @param start Ring index of the first window sample
+ * @param count Window length in samples (<= ring_size)
+ * @param dc_offset Per-axis DC offset to remove
+ * @param[out] output count * ML_INPUT_AXES INT8 values, interleaved
+ */
+void preprocess_quantize_generic(const struct accel_sample *ring,
+                                 size_t ring_size, size_t start, size_t count,
+                                 const float dc_offset[3], int8_t *output);
+
+/**
+ * @brief Quantize one window with the fastest available kernel
+ *
+ * Same parameters as preprocess_quantize_generic(). Uses the
+ * specialized kernel for count if one was instantiated.
+ */
+void preprocess_quantize(const struct accel_sample *ring, size_t ring_size,
+                         size_t start, size_t count,
+                         const float dc_offset[3], int8_t *output);
+
+/**
+ * @brief Check whether a window length has a specialized kernel
+ *
+ * @param count Window length in samples
+ * @return true if preprocess_quantize() uses a template instance
+ */
+bool preprocess_kernel_specialized(size_t count);
+
+/**
+ * @brief Get the configured quantization scheme name
+ *
+ * @return "float", "fixed" or "generic" (kernels disabled)
+ */
+const char *preprocess_kernel_scheme(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PREPROCESS_KERNELS_H */
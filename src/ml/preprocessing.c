@@ -5,14 +5,29 @@
  *
  * This file handles data preprocessing for the gesture recognition model,
  * including:
- *   - Sliding window accumulation
- *   - INT8 quantization
+ *   - Optional timestamp-driven resampling onto a uniform grid
+ *   - Sample history ring and window triggering
+ *   - INT8 quantization (see preprocess_kernels.cpp)
  *   - Mean removal for DC offset compensation
+ *
+ * Samples are kept in a single history ring sized for the longest window
+ * view plus some slack. Each view (primary, and optionally short and
+ * long) is just a length, a hop and a ready position into that ring, so
+ * extra views cost no sample storage. A view is marked ready either
+ * every hop samples (fixed mode; the primary view hops by its full
+ * length, the original back-to-back behavior) or once per detected
+ * gesture onset (onset mode), starting a short pre-trigger history
+ * before the onset.
  */
 
 #include "preprocessing.h"
+#include "preprocess_kernels.h"
 #include "sensor_hal.h"
 #include "inference.h"
+#include "onset_detector.h"
+#include "resampler.h"
+#include "lockstat.h"
+#include "memmap.h"
 
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
@@ -24,59 +39,273 @@ LOG_MODULE_REGISTER(preprocessing, CONFIG_LOG_DEFAULT_LEVEL);
  * Configuration
  * ============================================================================ */
 
-/** Quantization scale (input range to INT8) */
-#define QUANT_SCALE (127.0f / 16384.0f)  /* Map ±16384 to ±127 */
-
 /** DC offset filter coefficient (exponential moving average) */
 #define DC_FILTER_ALPHA 0.95f
 
+#ifndef CONFIG_ML_ONSET_PRETRIGGER_SAMPLES
+#define CONFIG_ML_ONSET_PRETRIGGER_SAMPLES 10
+#endif
+
+#ifdef CONFIG_ML_WINDOW_TRIGGER_ONSET
+#define PRETRIGGER_SAMPLES CONFIG_ML_ONSET_PRETRIGGER_SAMPLES
+#else
+#define PRETRIGGER_SAMPLES 0
+#endif
+
+BUILD_ASSERT(PRETRIGGER_SAMPLES < CONFIG_ML_INFERENCE_WINDOW_SIZE,
+             "Pre-trigger history must be shorter than the inference window");
+
+#ifdef CONFIG_SENSOR_ADAPTIVE_RATE
+BUILD_ASSERT(1000 / CONFIG_SENSOR_IDLE_RATE_HZ < CONFIG_ML_RESAMPLE_MAX_GAP_MS,
+             "Idle sample period must be shorter than the resampler max gap");
+#endif
+
+#ifdef CONFIG_ML_MULTI_RES_VIEWS
+#define VIEW_SHORT_SIZE CONFIG_ML_VIEW_SHORT_SIZE
+#define VIEW_SHORT_HOP  CONFIG_ML_VIEW_SHORT_HOP
+#define VIEW_LONG_SIZE  CONFIG_ML_VIEW_LONG_SIZE
+#define VIEW_LONG_HOP   CONFIG_ML_VIEW_LONG_HOP
+#else
+#define VIEW_SHORT_SIZE 0
+#define VIEW_SHORT_HOP  0
+#define VIEW_LONG_SIZE  0
+#define VIEW_LONG_HOP   0
+#endif
+
+/** Longest configured view */
+#define MAX_VIEW_SIZE MAX(CONFIG_ML_INFERENCE_WINDOW_SIZE, \
+                          MAX(VIEW_SHORT_SIZE, VIEW_LONG_SIZE))
+
+/**
+ * Extra ring slots beyond the longest view. A ready window stays intact
+ * until RING_SIZE - view size further samples have arrived, giving the
+ * consumer time to read it while new samples keep coming in.
+ */
+#define RING_SLACK 16
+
+#define RING_SIZE (MAX_VIEW_SIZE + RING_SLACK)
+
 /* ============================================================================
  * Private Data
  * ============================================================================ */
 
-/** Sliding window buffer for accelerometer samples */
-static struct accel_sample sample_window[CONFIG_ML_INFERENCE_WINDOW_SIZE];
+/**
+ * @brief Window view over the shared sample ring
+ */
+struct window_view {
+    /** Window length in samples (0 = view disabled) */
+    size_t size;
+    /** Samples between windows in fixed mode */
+    size_t hop;
+    /** Samples still needed to complete the pending window (0 = none) */
+    size_t samples_to_ready;
+    /** Ring position one past the last sample of the ready window */
+    size_t ready_head;
+    /** Samples added since the ready window completed */
+    size_t samples_since_ready;
+    /** Window is full flag */
+    bool ready;
+    /** Windows marked ready since initialization */
+    uint32_t emitted;
+    /** Windows completed or overwritten before being consumed */
+    uint32_t dropped;
+};
+
+/** Window views, indexed by preproc_view_t */
+static struct window_view views[PREPROC_VIEW_COUNT] = {
+    [PREPROC_VIEW_PRIMARY] = {
+        .size = CONFIG_ML_INFERENCE_WINDOW_SIZE,
+        .hop = CONFIG_ML_INFERENCE_WINDOW_SIZE,
+    },
+    [PREPROC_VIEW_SHORT] = { .size = VIEW_SHORT_SIZE, .hop = VIEW_SHORT_HOP },
+    [PREPROC_VIEW_LONG] = { .size = VIEW_LONG_SIZE, .hop = VIEW_LONG_HOP },
+};
 
-/** Current position in the window */
-static size_t window_pos = 0;
+/** Sample history ring shared by all views */
+static struct accel_sample sample_ring[RING_SIZE];
 
-/** Window is full flag */
-static bool window_ready = false;
+/** Next write position in the ring */
+static size_t ring_head = 0;
+
+/** Valid samples in the ring (saturates at RING_SIZE) */
+static size_t ring_count = 0;
 
 /** DC offset estimates (exponential moving average) */
 static float dc_offset[3] = {0.0f, 0.0f, 8192.0f};  /* Initial Z = 1g */
 
 /** Mutex for thread safety */
-static K_MUTEX_DEFINE(preprocess_mutex);
+static LOCKSTAT_MUTEX_DEFINE(preprocess_mutex);
 
 /** Initialization flag */
 static bool initialized = false;
 
+/* ============================================================================
+ * Private Functions
+ * ============================================================================ */
+
+/**
+ * @brief Reset ring and trigger state (caller holds preprocess_mutex)
+ */
+static void reset_window_state(void)
+{
+    ring_head = 0;
+    ring_count = 0;
+    
+    for (int i = 0; i < PREPROC_VIEW_COUNT; i++) {
+        struct window_view *v = &views[i];
+        
+        v->ready = false;
+        v->ready_head = 0;
+        v->samples_since_ready = 0;
+#ifdef CONFIG_ML_WINDOW_TRIGGER_ONSET
+        v->samples_to_ready = 0;  /* Armed by the next onset */
+#else
+        v->samples_to_ready = v->size;
+#endif
+    }
+    
+    memset(sample_ring, 0, sizeof(sample_ring));
+}
+
+/**
+ * @brief Mark the view window ending at ring_head as ready
+ *
+ * Caller holds preprocess_mutex.
+ */
+static void complete_window(struct window_view *v)
+{
+    if (v->ready) {
+        /* Consumer has not picked up the previous window yet */
+        v->dropped++;
+    }
+    v->ready = true;
+    v->ready_head = ring_head;
+    v->samples_since_ready = 0;
+    v->emitted++;
+    
+#ifdef CONFIG_ML_WINDOW_TRIGGER_ONSET
+    v->samples_to_ready = 0;
+#else
+    v->samples_to_ready = v->hop;
+#endif
+}
+
+/**
+ * @brief Advance all view triggers by one sample
+ *
+ * Caller holds preprocess_mutex.
+ *
+ * @param onset true if this sample was detected as a gesture onset
+ */
+static void advance_views(bool onset)
+{
+    for (int i = 0; i < PREPROC_VIEW_COUNT; i++) {
+        struct window_view *v = &views[i];
+        
+        if (v->size == 0) {
+            continue;
+        }
+        
+        if (v->ready) {
+            v->samples_since_ready++;
+        }
+        
+        if (onset && v->samples_to_ready == 0) {
+            /* Keep up to PRETRIGGER samples of history before the onset;
+             * the count includes the onset sample, decremented below */
+            size_t history = MIN(MIN((size_t)PRETRIGGER_SAMPLES, v->size - 1),
+                                 ring_count - 1);
+            v->samples_to_ready = v->size - history;
+        }
+        
+        if (v->samples_to_ready > 0) {
+            v->samples_to_ready--;
+            if (v->samples_to_ready == 0) {
+                complete_window(v);
+                LOG_DBG("View %d window complete (%zu samples)", i, v->size);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Push one uniformly spaced sample through the window pipeline
+ *
+ * Caller holds preprocess_mutex.
+ */
+static void ingest_sample(const struct accel_sample *sample)
+{
+    bool onset = false;
+    
+    /* Update DC offset estimate using exponential moving average */
+    dc_offset[0] = DC_FILTER_ALPHA * dc_offset[0] +
+                   (1.0f - DC_FILTER_ALPHA) * (float)sample->x;
+    dc_offset[1] = DC_FILTER_ALPHA * dc_offset[1] +
+                   (1.0f - DC_FILTER_ALPHA) * (float)sample->y;
+    dc_offset[2] = DC_FILTER_ALPHA * dc_offset[2] +
+                   (1.0f - DC_FILTER_ALPHA) * (float)sample->z;
+    
+    /* Add sample to history ring */
+    sample_ring[ring_head] = *sample;
+    ring_head = (ring_head + 1) % RING_SIZE;
+    if (ring_count < RING_SIZE) {
+        ring_count++;
+    }
+    
+#ifdef CONFIG_ML_WINDOW_TRIGGER_ONSET
+    onset = onset_detector_update(
+        (int32_t)((float)sample->x - dc_offset[0]),
+        (int32_t)((float)sample->y - dc_offset[1]),
+        (int32_t)((float)sample->z - dc_offset[2]));
+#endif
+    
+    advance_views(onset);
+}
+
 /* ============================================================================
  * Public API Implementation
  * ============================================================================ */
 
 void preprocessing_init(void)
 {
-    k_mutex_lock(&preprocess_mutex, K_FOREVER);
+    lockstat_mutex_lock(&preprocess_mutex, K_FOREVER);
     
-    window_pos = 0;
-    window_ready = false;
+    reset_window_state();
+#ifdef CONFIG_ML_RESAMPLE
+    resampler_init();
+#endif
+    for (int i = 0; i < PREPROC_VIEW_COUNT; i++) {
+        views[i].emitted = 0;
+        views[i].dropped = 0;
+    }
     
     /* Reset DC offset estimates */
     dc_offset[0] = 0.0f;
     dc_offset[1] = 0.0f;
     dc_offset[2] = 8192.0f;  /* Assume 1g on Z-axis initially */
     
-    /* Clear the window */
-    memset(sample_window, 0, sizeof(sample_window));
+#ifdef CONFIG_ML_WINDOW_TRIGGER_ONSET
+    onset_detector_init();
+#endif
     
     initialized = true;
     
+#ifdef CONFIG_ML_WINDOW_TRIGGER_ONSET
+    LOG_INF("Preprocessing initialized (window size: %d samples, "
+            "onset aligned, pre-trigger %d)",
+            CONFIG_ML_INFERENCE_WINDOW_SIZE, PRETRIGGER_SAMPLES);
+#else
     LOG_INF("Preprocessing initialized (window size: %d samples)",
             CONFIG_ML_INFERENCE_WINDOW_SIZE);
+#endif
+#ifdef CONFIG_ML_MULTI_RES_VIEWS
+    LOG_INF("Extra views: short %d/%d, long %d/%d (size/hop), ring %d samples",
+            VIEW_SHORT_SIZE, VIEW_SHORT_HOP, VIEW_LONG_SIZE, VIEW_LONG_HOP,
+            RING_SIZE);
+#endif
+    memmap_add("sample_ring", sizeof(sample_ring), MEMMAP_USED_UNKNOWN);
     
-    k_mutex_unlock(&preprocess_mutex);
+    lockstat_mutex_unlock(&preprocess_mutex);
 }
 
 int preprocessing_add_sample(const struct accel_sample *sample)
@@ -89,114 +318,196 @@ int preprocessing_add_sample(const struct accel_sample *sample)
         return -EINVAL;
     }
     
-    k_mutex_lock(&preprocess_mutex, K_FOREVER);
+    lockstat_mutex_lock(&preprocess_mutex, K_FOREVER);
     
-    /* Update DC offset estimate using exponential moving average */
-    dc_offset[0] = DC_FILTER_ALPHA * dc_offset[0] + 
-                   (1.0f - DC_FILTER_ALPHA) * (float)sample->x;
-    dc_offset[1] = DC_FILTER_ALPHA * dc_offset[1] + 
-                   (1.0f - DC_FILTER_ALPHA) * (float)sample->y;
-    dc_offset[2] = DC_FILTER_ALPHA * dc_offset[2] + 
-                   (1.0f - DC_FILTER_ALPHA) * (float)sample->z;
+#ifdef CONFIG_ML_RESAMPLE
+    /* Only interpolated grid samples reach the ring */
+    struct accel_sample grid[RESAMPLER_MAX_OUTPUT];
+    size_t count = resampler_push(sample, grid);
     
-    /* Add sample to window */
-    sample_window[window_pos] = *sample;
-    window_pos++;
-    
-    /* Check if window is complete */
-    if (window_pos >= CONFIG_ML_INFERENCE_WINDOW_SIZE) {
-        window_ready = true;
-        window_pos = 0;  /* Reset for next window */
-        
-        LOG_DBG("Window complete, ready for inference");
+    for (size_t i = 0; i < count; i++) {
+        ingest_sample(&grid[i]);
     }
+#else
+    ingest_sample(sample);
+#endif
     
-    k_mutex_unlock(&preprocess_mutex);
+    lockstat_mutex_unlock(&preprocess_mutex);
     
     return 0;
 }
 
+void preprocessing_set_source_rate(uint32_t rate_hz)
+{
+    if (rate_hz == 0) {
+        return;
+    }
+    
+#ifdef CONFIG_ML_RESAMPLE
+    lockstat_mutex_lock(&preprocess_mutex, K_FOREVER);
+    resampler_set_input_period(1000000U / rate_hz);
+    lockstat_mutex_unlock(&preprocess_mutex);
+#else
+    if (rate_hz != CONFIG_SENSOR_SAMPLE_RATE_HZ) {
+        LOG_WRN("Input rate %u Hz without resampling distorts windows", rate_hz);
+    }
+#endif
+}
+
 bool preprocessing_window_ready(void)
+{
+    return preprocessing_view_ready(PREPROC_VIEW_PRIMARY);
+}
+
+int preprocessing_get_input(int8_t *output, size_t output_size)
+{
+    if (output_size < ML_INPUT_SIZE) {
+        LOG_ERR("Output buffer too small: %zu < %d", output_size, ML_INPUT_SIZE);
+        return -ENOSPC;
+    }
+    
+    return preprocessing_get_view_input(PREPROC_VIEW_PRIMARY, output,
+                                        output_size);
+}
+
+bool preprocessing_view_ready(preproc_view_t view)
 {
     bool ready;
     
-    k_mutex_lock(&preprocess_mutex, K_FOREVER);
-    ready = window_ready;
-    k_mutex_unlock(&preprocess_mutex);
+    if (view >= PREPROC_VIEW_COUNT) {
+        return false;
+    }
+    
+    lockstat_mutex_lock(&preprocess_mutex, K_FOREVER);
+    ready = views[view].ready;
+    lockstat_mutex_unlock(&preprocess_mutex);
     
     return ready;
 }
 
-int preprocessing_get_input(int8_t *output, size_t output_size)
+size_t preprocessing_view_size(preproc_view_t view)
+{
+    if (view >= PREPROC_VIEW_COUNT) {
+        return 0;
+    }
+    
+    return views[view].size;
+}
+
+int preprocessing_get_view_input(preproc_view_t view, int8_t *output,
+                                 size_t output_size)
 {
-    if (output == NULL) {
+    if (output == NULL || view >= PREPROC_VIEW_COUNT) {
         return -EINVAL;
     }
     
-    if (output_size < ML_INPUT_SIZE) {
-        LOG_ERR("Output buffer too small: %zu < %d", output_size, ML_INPUT_SIZE);
+    struct window_view *v = &views[view];
+    
+    if (v->size == 0) {
+        return -ENOTSUP;
+    }
+    
+    if (output_size < v->size * 3) {
+        LOG_ERR("Output buffer too small: %zu < %zu", output_size, v->size * 3);
         return -ENOSPC;
     }
     
-    k_mutex_lock(&preprocess_mutex, K_FOREVER);
+    lockstat_mutex_lock(&preprocess_mutex, K_FOREVER);
+    
+    if (!v->ready) {
+        lockstat_mutex_unlock(&preprocess_mutex);
+        return -EAGAIN;
+    }
     
-    if (!window_ready) {
-        k_mutex_unlock(&preprocess_mutex);
+    if (v->samples_since_ready > RING_SIZE - v->size) {
+        /* Ready window has been partly overwritten by newer samples */
+        v->ready = false;
+        v->dropped++;
+        lockstat_mutex_unlock(&preprocess_mutex);
         return -EAGAIN;
     }
     
     /* Convert samples to quantized format */
-    size_t out_idx = 0;
+    size_t idx = (v->ready_head + RING_SIZE - v->size) % RING_SIZE;
     
-    for (size_t i = 0; i < CONFIG_ML_INFERENCE_WINDOW_SIZE; i++) {
-        /* Remove DC offset and quantize */
-        float x = (float)sample_window[i].x - dc_offset[0];
-        float y = (float)sample_window[i].y - dc_offset[1];
-        float z = (float)sample_window[i].z - dc_offset[2];
-        
-        /* Quantize to INT8 */
-        int32_t qx = (int32_t)(x * QUANT_SCALE);
-        int32_t qy = (int32_t)(y * QUANT_SCALE);
-        int32_t qz = (int32_t)(z * QUANT_SCALE);
-        
-        /* Clamp to INT8 range */
-        qx = (qx < -128) ? -128 : (qx > 127) ? 127 : qx;
-        qy = (qy < -128) ? -128 : (qy > 127) ? 127 : qy;
-        qz = (qz < -128) ? -128 : (qz > 127) ? 127 : qz;
-        
-        output[out_idx++] = (int8_t)qx;
-        output[out_idx++] = (int8_t)qy;
-        output[out_idx++] = (int8_t)qz;
-    }
+    preprocess_quantize(sample_ring, RING_SIZE, idx, v->size, dc_offset,
+                        output);
     
     /* Mark window as consumed */
-    window_ready = false;
+    v->ready = false;
     
-    k_mutex_unlock(&preprocess_mutex);
+    lockstat_mutex_unlock(&preprocess_mutex);
     
     return 0;
 }
 
 void preprocessing_clear_window(void)
 {
-    k_mutex_lock(&preprocess_mutex, K_FOREVER);
+    lockstat_mutex_lock(&preprocess_mutex, K_FOREVER);
     
-    window_pos = 0;
-    window_ready = false;
-    memset(sample_window, 0, sizeof(sample_window));
+    reset_window_state();
     
     LOG_DBG("Window cleared");
     
-    k_mutex_unlock(&preprocess_mutex);
+    lockstat_mutex_unlock(&preprocess_mutex);
 }
 
 size_t preprocessing_get_window_fill(void)
 {
+    const struct window_view *v = &views[PREPROC_VIEW_PRIMARY];
     size_t fill;
     
-    k_mutex_lock(&preprocess_mutex, K_FOREVER);
-    fill = window_pos;
-    k_mutex_unlock(&preprocess_mutex);
+    lockstat_mutex_lock(&preprocess_mutex, K_FOREVER);
+#ifdef CONFIG_ML_WINDOW_TRIGGER_ONSET
+    if (v->samples_to_ready > 0) {
+        fill = v->size - v->samples_to_ready;
+    } else {
+        /* Idle: only the pre-trigger history is retained */
+        fill = MIN(ring_count, (size_t)PRETRIGGER_SAMPLES);
+    }
+#else
+    fill = v->size - v->samples_to_ready;
+#endif
+    lockstat_mutex_unlock(&preprocess_mutex);
     
     return fill;
 }
+
+uint32_t preprocessing_get_dropped_windows(void)
+{
+    uint32_t dropped;
+    
+    lockstat_mutex_lock(&preprocess_mutex, K_FOREVER);
+    dropped = views[PREPROC_VIEW_PRIMARY].dropped;
+    lockstat_mutex_unlock(&preprocess_mutex);
+    
+    return dropped;
+}
+
+uint32_t preprocessing_get_emitted_windows(void)
+{
+    uint32_t emitted;
+    
+    lockstat_mutex_lock(&preprocess_mutex, K_FOREVER);
+    emitted = views[PREPROC_VIEW_PRIMARY].emitted;
+    lockstat_mutex_unlock(&preprocess_mutex);
+    
+    return emitted;
+}
+
+void preprocessing_get_view_stats(preproc_view_t view, uint32_t *emitted,
+                                  uint32_t *dropped)
+{
+    if (view >= PREPROC_VIEW_COUNT) {
+        return;
+    }
+    
+    lockstat_mutex_lock(&preprocess_mutex, K_FOREVER);
+    if (emitted != NULL) {
+        *emitted = views[view].emitted;
+    }
+    if (dropped != NULL) {
+        *dropped = views[view].dropped;
+    }
+    lockstat_mutex_unlock(&preprocess_mutex);
+}
@@ -16,19 +16,45 @@
 extern "C" {
 #endif
 
+/**
+ * @brief Window views over the shared sample ring
+ *
+ * The primary view is the CONFIG_ML_INFERENCE_WINDOW_SIZE window used by
+ * the gesture model. The short and long views are only active with
+ * CONFIG_ML_MULTI_RES_VIEWS; otherwise their size is 0.
+ */
+typedef enum {
+    PREPROC_VIEW_PRIMARY = 0,
+    PREPROC_VIEW_SHORT,
+    PREPROC_VIEW_LONG,
+    PREPROC_VIEW_COUNT
+} preproc_view_t;
+
 /**
  * @brief Initialize the preprocessing module
  */
 void preprocessing_init(void);
 
 /**
- * @brief Add a new accelerometer sample to the window
+ * @brief Add a new accelerometer sample to the history ring
  *
  * @param sample Pointer to new sample
  * @return 0 on success, negative error code otherwise
  */
 int preprocessing_add_sample(const struct accel_sample *sample);
 
+/**
+ * @brief Tell preprocessing the current sensor sample rate
+ *
+ * Called when the sensor rate changes at runtime. With the resampler
+ * enabled the input is still interpolated onto the
+ * CONFIG_SENSOR_SAMPLE_RATE_HZ grid; the rate only sets the expected
+ * input period used for gap detection.
+ *
+ * @param rate_hz New input sample rate in Hz
+ */
+void preprocessing_set_source_rate(uint32_t rate_hz);
+
 /**
  * @brief Check if the sample window is ready for inference
  *
@@ -60,6 +86,68 @@ void preprocessing_clear_window(void);
  */
 size_t preprocessing_get_window_fill(void);
 
+/**
+ * @brief Get number of windows dropped due to overload
+ *
+ * Counts windows that completed while the previous window was still
+ * waiting to be consumed by the ML thread.
+ *
+ * @return Number of dropped windows since initialization
+ */
+uint32_t preprocessing_get_dropped_windows(void);
+
+/**
+ * @brief Get number of windows marked ready for inference
+ *
+ * In onset mode this is the number of onset-aligned windows; compare
+ * with the sample count to see the inference rate saved over fixed
+ * windowing.
+ *
+ * @return Number of windows emitted since initialization
+ */
+uint32_t preprocessing_get_emitted_windows(void);
+
+/**
+ * @brief Get the window length of a view
+ *
+ * @param view View identifier
+ * @return Window length in samples, 0 if the view is disabled
+ */
+size_t preprocessing_view_size(preproc_view_t view);
+
+/**
+ * @brief Check if a view has a window ready
+ *
+ * @param view View identifier
+ * @return true if the view window is complete
+ */
+bool preprocessing_view_ready(preproc_view_t view);
+
+/**
+ * @brief Get the preprocessed input data for a view
+ *
+ * Same quantization as preprocessing_get_input(), over the view's own
+ * window length. Clears the view's ready flag after reading.
+ *
+ * @param view View identifier
+ * @param output Buffer to fill with INT8 quantized data
+ * @param output_size Size of output buffer (must be >= 3 * view size)
+ * @return 0 on success, -EAGAIN if window not ready or overwritten,
+ *         -ENOTSUP if the view is disabled
+ */
+int preprocessing_get_view_input(preproc_view_t view, int8_t *output,
+                                 size_t output_size);
+
+/**
+ * @brief Get window counters for a view
+ *
+ * @param view View identifier
+ * @param[out] emitted Windows marked ready (may be NULL)
+ * @param[out] dropped Windows never consumed (may be NULL)
+ */
+void preprocessing_get_view_stats(preproc_view_t view, uint32_t *emitted,
+                                  uint32_t *dropped);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,308 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Zephyr Edge AI Demo - Timestamp Resampler
+ *
+ * Fixed-point interpolation of timestamped samples onto a uniform grid:
+ *   - Linear: between the two most recent input samples
+ *   - Cubic: Catmull-Rom over four input samples, one sample of latency
+ *
+ * The interpolation parameter u is computed in Q16 from the actual
+ * sample timestamps, so jittered or batched input lands on the exact
+ * grid time. Intervals longer than 1.5 input periods are counted as
+ * gaps; intervals longer than CONFIG_ML_RESAMPLE_MAX_GAP_MS restart the
+ * grid rather than interpolating across missing motion.
+ */
+
+#include "resampler.h"
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <string.h>
+
+LOG_MODULE_REGISTER(resampler, CONFIG_LOG_DEFAULT_LEVEL);
+
+/* ============================================================================
+ * Configuration
+ * ============================================================================ */
+
+/** Output grid period (us) */
+#define GRID_PERIOD_US (1000000U / CONFIG_SENSOR_SAMPLE_RATE_HZ)
+
+/** Longest interval interpolated across (us) */
+#define MAX_GAP_US ((uint32_t)CONFIG_ML_RESAMPLE_MAX_GAP_MS * 1000U)
+
+/** Fraction bits of the interpolation parameter */
+#define U_FRAC_BITS 16
+
+/** Input history depth (cubic needs four points) */
+#define HISTORY_LEN 4
+
+/* ============================================================================
+ * Private Data
+ * ============================================================================ */
+
+/** Recent input samples, oldest first */
+static struct accel_sample history[HISTORY_LEN];
+static size_t history_count = 0;
+
+/** Timestamp of the next grid point to produce */
+static uint32_t next_grid_us = 0;
+
+/** Expected input period for gap detection */
+static uint32_t input_period_us = GRID_PERIOD_US;
+
+static resampler_stats_t stats = {0};
+static struct k_spinlock stats_lock;
+
+/* ============================================================================
+ * Private Functions
+ * ============================================================================ */
+
+static inline int16_t clamp_i16(int64_t v)
+{
+    return (int16_t)((v < INT16_MIN) ? INT16_MIN : (v > INT16_MAX) ? INT16_MAX : v);
+}
+
+#ifdef CONFIG_ML_RESAMPLE_CUBIC
+/**
+ * @brief Catmull-Rom (cubic Hermite) interpolation between p1 and p2
+ *
+ * Tangents are the central differences (p2 - p0) and (p3 - p1) scaled
+ * to the p1..p2 segment by w1 and w2, which keeps the curve exact for
+ * linear motion even when the input spacing is uneven.
+ *
+ * @param w1 (t2 - t1) / (t2 - t0) in Q16
+ * @param w2 (t2 - t1) / (t3 - t1) in Q16
+ * @param u Position within the segment in Q16
+ */
+static int16_t interp_axis(int32_t p0, int32_t p1, int32_t p2, int32_t p3,
+                           int64_t w1, int64_t w2, int64_t u)
+{
+    const int64_t one = 1 << U_FRAC_BITS;
+    int64_t u2 = (u * u) >> U_FRAC_BITS;
+    int64_t u3 = (u2 * u) >> U_FRAC_BITS;
+    int64_t m1 = ((int64_t)(p2 - p0) * w1) >> U_FRAC_BITS;
+    int64_t m2 = ((int64_t)(p3 - p1) * w2) >> U_FRAC_BITS;
+
+    /* Hermite basis functions */
+    int64_t h00 = 2 * u3 - 3 * u2 + one;
+    int64_t h10 = u3 - 2 * u2 + u;
+    int64_t h01 = -2 * u3 + 3 * u2;
+    int64_t h11 = u3 - u2;
+
+    return clamp_i16((h00 * p1 + h10 * m1 + h01 * p2 + h11 * m2) >> U_FRAC_BITS);
+}
+#else
+/**
+ * @brief Linear interpolation between p1 and p2
+ */
+static int16_t interp_axis(int32_t p0, int32_t p1, int32_t p2, int32_t p3,
+                           int64_t w1, int64_t w2, int64_t u)
+{
+    ARG_UNUSED(p0);
+    ARG_UNUSED(p3);
+    ARG_UNUSED(w1);
+    ARG_UNUSED(w2);
+
+    return clamp_i16(p1 + (((int64_t)(p2 - p1) * u) >> U_FRAC_BITS));
+}
+#endif
+
+/**
+ * @brief Emit all grid points inside the segment [a, b]
+ *
+ * @param p0 Point before a (a itself at the start of the history)
+ * @param p3 Point after b (b itself for linear interpolation)
+ * @return Number of samples written to out
+ */
+static size_t emit_segment(const struct accel_sample *p0,
+                           const struct accel_sample *a,
+                           const struct accel_sample *b,
+                           const struct accel_sample *p3,
+                           struct accel_sample *out)
+{
+    uint32_t span = b->timestamp_us - a->timestamp_us;
+    int64_t w1 = ((int64_t)span << U_FRAC_BITS) /
+                 (uint32_t)(b->timestamp_us - p0->timestamp_us);
+    int64_t w2 = ((int64_t)span << U_FRAC_BITS) /
+                 (uint32_t)(p3->timestamp_us - a->timestamp_us);
+    size_t n = 0;
+
+    /* One entry stays free for the sample that restarts the grid */
+    while ((int32_t)(b->timestamp_us - next_grid_us) >= 0 &&
+           n < RESAMPLER_MAX_OUTPUT - 1) {
+        uint32_t offset = next_grid_us - a->timestamp_us;
+        int64_t u = ((int64_t)offset << U_FRAC_BITS) / span;
+
+        out[n].x = interp_axis(p0->x, a->x, b->x, p3->x, w1, w2, u);
+        out[n].y = interp_axis(p0->y, a->y, b->y, p3->y, w1, w2, u);
+        out[n].z = interp_axis(p0->z, a->z, b->z, p3->z, w1, w2, u);
+        out[n].timestamp_us = next_grid_us;
+        n++;
+
+        next_grid_us += GRID_PERIOD_US;
+    }
+
+    return n;
+}
+
+/**
+ * @brief Emit the grid points still held back before a grid restart
+ *
+ * Cubic output lags one input sample behind, so the segment between the
+ * last two samples has not been produced yet. It is interpolated with
+ * the end tangent taken from the segment itself (with fewer than three
+ * samples both tangents are, which is linear interpolation).
+ *
+ * @return Number of samples written to out
+ */
+static size_t flush_history(struct accel_sample *out)
+{
+#ifdef CONFIG_ML_RESAMPLE_CUBIC
+    if (history_count < 2) {
+        return 0;
+    }
+
+    size_t b = history_count - 1;
+    size_t a = b - 1;
+    size_t p0 = (a > 0) ? a - 1 : a;
+
+    return emit_segment(&history[p0], &history[a], &history[b],
+                        &history[b], out);
+#else
+    /* Linear output is already complete up to the newest sample */
+    ARG_UNUSED(out);
+    return 0;
+#endif
+}
+
+/**
+ * @brief Add one input sample to the history and interpolate
+ *
+ * @param[out] delta Statistics increments for this sample
+ * @return Number of samples written to out
+ */
+static size_t resample_one(const struct accel_sample *in,
+                           struct accel_sample *out,
+                           resampler_stats_t *delta)
+{
+    size_t flushed = 0;
+
+    if (history_count > 0) {
+        const struct accel_sample *last = &history[history_count - 1];
+        int32_t dt = (int32_t)(in->timestamp_us - last->timestamp_us);
+
+        if (dt <= 0) {
+            delta->out_of_order = 1;
+            return 0;
+        }
+
+        if ((uint32_t)dt > input_period_us + input_period_us / 2) {
+            uint32_t missing = ((uint32_t)dt + input_period_us / 2) /
+                               input_period_us - 1;
+            delta->gaps = 1;
+            delta->samples_missing = missing;
+            LOG_DBG("Sample gap: %d us (%u missing)", dt, missing);
+        }
+
+        if ((uint32_t)dt > MAX_GAP_US) {
+            /* Too long to interpolate across: restart the grid here */
+            delta->resets = 1;
+            flushed = flush_history(out);
+            history_count = 0;
+        }
+    }
+
+    /* Append to history, dropping the oldest point when full */
+    if (history_count == HISTORY_LEN) {
+        memmove(&history[0], &history[1],
+                (HISTORY_LEN - 1) * sizeof(history[0]));
+        history_count--;
+    }
+    history[history_count++] = *in;
+
+    if (history_count == 1) {
+        /* Grid starts at the first sample */
+        out[flushed] = *in;
+        next_grid_us = in->timestamp_us + GRID_PERIOD_US;
+        return flushed + 1;
+    }
+
+#ifdef CONFIG_ML_RESAMPLE_CUBIC
+    /* Interpolate the segment before the newest point */
+    if (history_count < 3) {
+        return 0;
+    }
+
+    size_t b = history_count - 2;
+    size_t a = b - 1;
+    size_t p0 = (a > 0) ? a - 1 : a;
+
+    return emit_segment(&history[p0], &history[a], &history[b],
+                        &history[history_count - 1], out);
+#else
+    size_t b = history_count - 1;
+
+    return emit_segment(&history[b - 1], &history[b - 1], &history[b],
+                        &history[b], out);
+#endif
+}
+
+/* ============================================================================
+ * Public API Implementation
+ * ============================================================================ */
+
+void resampler_init(void)
+{
+    history_count = 0;
+    next_grid_us = 0;
+    input_period_us = GRID_PERIOD_US;
+
+    k_spinlock_key_t key = k_spin_lock(&stats_lock);
+    stats = (resampler_stats_t){0};
+    k_spin_unlock(&stats_lock, key);
+
+#ifdef CONFIG_ML_RESAMPLE_CUBIC
+    LOG_INF("Resampler: cubic, grid %u us, max gap %u us",
+            GRID_PERIOD_US, MAX_GAP_US);
+#else
+    LOG_INF("Resampler: linear, grid %u us, max gap %u us",
+            GRID_PERIOD_US, MAX_GAP_US);
+#endif
+}
+
+void resampler_set_input_period(uint32_t period_us)
+{
+    if (period_us > 0) {
+        input_period_us = period_us;
+    }
+}
+
+size_t resampler_push(const struct accel_sample *in, struct accel_sample *out)
+{
+    resampler_stats_t delta = {0};
+    size_t n = resample_one(in, out, &delta);
+
+    k_spinlock_key_t key = k_spin_lock(&stats_lock);
+    stats.samples_in++;
+    stats.samples_out += n;
+    stats.gaps += delta.gaps;
+    stats.samples_missing += delta.samples_missing;
+    stats.resets += delta.resets;
+    stats.out_of_order += delta.out_of_order;
+    k_spin_unlock(&stats_lock, key);
+
+    return n;
+}
+
+void resampler_get_stats(resampler_stats_t *out)
+{
+    if (out == NULL) {
+        return;
+    }
+
+    k_spinlock_key_t key = k_spin_lock(&stats_lock);
+    *out = stats;
+    k_spin_unlock(&stats_lock, key);
+}
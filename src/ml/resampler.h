@@ -0,0 +1,101 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Zephyr Edge AI Demo - Timestamp Resampler
+ *
+ * Interpolates timestamped accelerometer samples onto an exact uniform
+ * grid at CONFIG_SENSOR_SAMPLE_RATE_HZ, so that scheduling jitter,
+ * dropped samples and batched reads do not distort the model input.
+ */
+
+#ifndef RESAMPLER_H
+#define RESAMPLER_H
+
+#include "sensor_hal.h"
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef CONFIG_SENSOR_SAMPLE_RATE_HZ
+#define CONFIG_SENSOR_SAMPLE_RATE_HZ 100
+#endif
+
+#ifndef CONFIG_ML_RESAMPLE_MAX_GAP_MS
+#define CONFIG_ML_RESAMPLE_MAX_GAP_MS 100
+#endif
+
+/**
+ * Maximum grid samples produced by one input sample. Input gaps longer
+ * than CONFIG_ML_RESAMPLE_MAX_GAP_MS restart the grid instead of being
+ * interpolated across, which bounds this; a restart adds the first
+ * sample of the new grid after the flushed pre-gap segment.
+ */
+#define RESAMPLER_MAX_OUTPUT \
+    ((CONFIG_ML_RESAMPLE_MAX_GAP_MS * CONFIG_SENSOR_SAMPLE_RATE_HZ) / 1000 + 2)
+
+/**
+ * @brief Resampler statistics
+ */
+typedef struct {
+    /** Input samples received */
+    uint32_t samples_in;
+
+    /** Grid samples produced */
+    uint32_t samples_out;
+
+    /** Input intervals longer than 1.5 input periods */
+    uint32_t gaps;
+
+    /** Input samples estimated missing across all gaps */
+    uint32_t samples_missing;
+
+    /** Grid restarts after gaps longer than the maximum */
+    uint32_t resets;
+
+    /** Input samples discarded for non-increasing timestamps */
+    uint32_t out_of_order;
+} resampler_stats_t;
+
+/**
+ * @brief Reset the resampler state and statistics
+ */
+void resampler_init(void);
+
+/**
+ * @brief Set the expected input sample period
+ *
+ * Only affects gap detection; the output grid always runs at
+ * CONFIG_SENSOR_SAMPLE_RATE_HZ. Not thread-safe; call under the
+ * preprocessing mutex.
+ *
+ * @param period_us Expected interval between input samples (us)
+ */
+void resampler_set_input_period(uint32_t period_us);
+
+/**
+ * @brief Feed one timestamped input sample
+ *
+ * Produces every grid point that can now be interpolated. With cubic
+ * interpolation output lags the input by one sample.
+ *
+ * @param in Input sample (timestamp_us must be set)
+ * @param[out] out Grid samples (at least RESAMPLER_MAX_OUTPUT entries)
+ * @return Number of grid samples written to out
+ */
+size_t resampler_push(const struct accel_sample *in, struct accel_sample *out);
+
+/**
+ * @brief Get resampler statistics
+ *
+ * @param[out] stats Pointer to statistics structure
+ */
+void resampler_get_stats(resampler_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RESAMPLER_H */
@@ -0,0 +1,250 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Zephyr Edge AI Demo - Synthetic Inference Load Model
+ *
+ * Replaces the fixed 5 ms busy-wait of the original mock inference with
+ * a configurable load model:
+ *   - Latency distribution: fixed, uniform, or long-tail
+ *   - Time spent as CPU burn (k_busy_wait) vs. sleep (k_usleep)
+ *   - Output class mix and confidence range
+ *
+ * A local xorshift generator is used instead of the entropy driver so
+ * that a given seed always reproduces the same load sequence.
+ */
+
+#include "synthetic_inference.h"
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+
+LOG_MODULE_REGISTER(synthetic_inference, CONFIG_LOG_DEFAULT_LEVEL);
+
+/* ============================================================================
+ * Configuration
+ * ============================================================================ */
+
+#ifndef CONFIG_ML_SYNTH_LATENCY_MIN_US
+#define CONFIG_ML_SYNTH_LATENCY_MIN_US 5000
+#endif
+
+#ifndef CONFIG_ML_SYNTH_LATENCY_MAX_US
+#define CONFIG_ML_SYNTH_LATENCY_MAX_US 5000
+#endif
+
+#ifndef CONFIG_ML_SYNTH_TAIL_PERCENT
+#define CONFIG_ML_SYNTH_TAIL_PERCENT 0
+#endif
+
+#ifndef CONFIG_ML_SYNTH_TAIL_MULTIPLIER
+#define CONFIG_ML_SYNTH_TAIL_MULTIPLIER 1
+#endif
+
+#ifndef CONFIG_ML_SYNTH_BURN_PERCENT
+#define CONFIG_ML_SYNTH_BURN_PERCENT 100
+#endif
+
+#ifndef CONFIG_ML_SYNTH_WEIGHT_IDLE
+#define CONFIG_ML_SYNTH_WEIGHT_IDLE 96
+#endif
+
+#ifndef CONFIG_ML_SYNTH_WEIGHT_WAVE
+#define CONFIG_ML_SYNTH_WEIGHT_WAVE 2
+#endif
+
+#ifndef CONFIG_ML_SYNTH_WEIGHT_TAP
+#define CONFIG_ML_SYNTH_WEIGHT_TAP 2
+#endif
+
+#ifndef CONFIG_ML_SYNTH_WEIGHT_CIRCLE
+#define CONFIG_ML_SYNTH_WEIGHT_CIRCLE 0
+#endif
+
+#ifndef CONFIG_ML_SYNTH_CONFIDENCE_MIN
+#define CONFIG_ML_SYNTH_CONFIDENCE_MIN 80
+#endif
+
+#ifndef CONFIG_ML_SYNTH_CONFIDENCE_MAX
+#define CONFIG_ML_SYNTH_CONFIDENCE_MAX 95
+#endif
+
+#ifndef CONFIG_ML_SYNTH_SEED
+#define CONFIG_ML_SYNTH_SEED 0x2545F491
+#endif
+
+/* synth_rand_range() collapses an inverted range to its lower bound */
+#ifndef CONFIG_ML_SYNTH_LATENCY_FIXED
+BUILD_ASSERT(CONFIG_ML_SYNTH_LATENCY_MIN_US <= CONFIG_ML_SYNTH_LATENCY_MAX_US,
+             "ML_SYNTH_LATENCY_MIN_US exceeds ML_SYNTH_LATENCY_MAX_US");
+#endif
+BUILD_ASSERT(CONFIG_ML_SYNTH_CONFIDENCE_MIN <= CONFIG_ML_SYNTH_CONFIDENCE_MAX,
+             "ML_SYNTH_CONFIDENCE_MIN exceeds ML_SYNTH_CONFIDENCE_MAX");
+
+/** Class weights, indexed by gesture_label_t */
+static const uint32_t class_weights[GESTURE_COUNT] = {
+    CONFIG_ML_SYNTH_WEIGHT_IDLE,
+    CONFIG_ML_SYNTH_WEIGHT_WAVE,
+    CONFIG_ML_SYNTH_WEIGHT_TAP,
+    CONFIG_ML_SYNTH_WEIGHT_CIRCLE,
+};
+
+/* ============================================================================
+ * Private Data
+ * ============================================================================ */
+
+static uint32_t rng_state = CONFIG_ML_SYNTH_SEED;
+static uint32_t weight_total = 0;
+
+static synthetic_stats_t synth_stats = {0};
+static struct k_spinlock stats_lock;
+
+/* ============================================================================
+ * Private Functions
+ * ============================================================================ */
+
+/**
+ * @brief xorshift32 pseudo-random generator
+ */
+static uint32_t synth_rand(void)
+{
+    uint32_t x = rng_state;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    rng_state = x;
+
+    return x;
+}
+
+/**
+ * @brief Uniform random value in [lo, hi]
+ */
+static uint32_t synth_rand_range(uint32_t lo, uint32_t hi)
+{
+    if (hi <= lo) {
+        return lo;
+    }
+    return lo + (synth_rand() % (hi - lo + 1));
+}
+
+/**
+ * @brief Draw a latency from the configured distribution
+ *
+ * @param[out] is_tail Set when the draw came from the long tail
+ */
+static uint32_t draw_latency_us(bool *is_tail)
+{
+    *is_tail = false;
+
+#if defined(CONFIG_ML_SYNTH_LATENCY_UNIFORM)
+    return synth_rand_range(CONFIG_ML_SYNTH_LATENCY_MIN_US,
+                            CONFIG_ML_SYNTH_LATENCY_MAX_US);
+#elif defined(CONFIG_ML_SYNTH_LATENCY_LONG_TAIL)
+    /* Body is uniform over [min, max]; the tail extends to max * multiplier */
+    if ((synth_rand() % 100) < CONFIG_ML_SYNTH_TAIL_PERCENT) {
+        *is_tail = true;
+        return synth_rand_range(CONFIG_ML_SYNTH_LATENCY_MAX_US,
+                                CONFIG_ML_SYNTH_LATENCY_MAX_US *
+                                CONFIG_ML_SYNTH_TAIL_MULTIPLIER);
+    }
+    return synth_rand_range(CONFIG_ML_SYNTH_LATENCY_MIN_US,
+                            CONFIG_ML_SYNTH_LATENCY_MAX_US);
+#else
+    return CONFIG_ML_SYNTH_LATENCY_MIN_US;
+#endif
+}
+
+/**
+ * @brief Draw an output class from the configured mix
+ */
+static gesture_label_t draw_class(void)
+{
+    if (weight_total == 0) {
+        return GESTURE_IDLE;
+    }
+
+    uint32_t pick = synth_rand() % weight_total;
+
+    for (int i = 0; i < GESTURE_COUNT; i++) {
+        if (pick < class_weights[i]) {
+            return (gesture_label_t)i;
+        }
+        pick -= class_weights[i];
+    }
+
+    return GESTURE_IDLE;
+}
+
+/* ============================================================================
+ * Public API Implementation
+ * ============================================================================ */
+
+void synthetic_inference_init(void)
+{
+    rng_state = CONFIG_ML_SYNTH_SEED ? CONFIG_ML_SYNTH_SEED : 1;
+
+    weight_total = 0;
+    for (int i = 0; i < GESTURE_COUNT; i++) {
+        weight_total += class_weights[i];
+    }
+
+    k_spinlock_key_t key = k_spin_lock(&stats_lock);
+    synth_stats = (synthetic_stats_t){0};
+    k_spin_unlock(&stats_lock, key);
+
+    LOG_INF("Synthetic inference: latency %u-%u us, burn %d%%, mix %u/%u/%u/%u",
+            CONFIG_ML_SYNTH_LATENCY_MIN_US, CONFIG_ML_SYNTH_LATENCY_MAX_US,
+            CONFIG_ML_SYNTH_BURN_PERCENT,
+            class_weights[GESTURE_IDLE], class_weights[GESTURE_WAVE],
+            class_weights[GESTURE_TAP], class_weights[GESTURE_CIRCLE]);
+}
+
+gesture_label_t synthetic_inference_run(float *scores)
+{
+    bool is_tail;
+    uint32_t latency_us = draw_latency_us(&is_tail);
+    uint32_t burn_us = (uint32_t)(((uint64_t)latency_us *
+                                   CONFIG_ML_SYNTH_BURN_PERCENT) / 100);
+    uint32_t sleep_us = latency_us - burn_us;
+
+    /* Spend the latency: burn first so CPU load lands where Invoke() would */
+    if (burn_us > 0) {
+        k_busy_wait(burn_us);
+    }
+    if (sleep_us > 0) {
+        k_usleep((int32_t)sleep_us);
+    }
+
+    /* Winning class gets the drawn confidence, the rest share the remainder */
+    gesture_label_t label = draw_class();
+    float confidence = (float)synth_rand_range(CONFIG_ML_SYNTH_CONFIDENCE_MIN,
+                                               CONFIG_ML_SYNTH_CONFIDENCE_MAX) / 100.0f;
+    float rest = (1.0f - confidence) / (float)(GESTURE_COUNT - 1);
+
+    for (int i = 0; i < GESTURE_COUNT; i++) {
+        scores[i] = (i == (int)label) ? confidence : rest;
+    }
+
+    k_spinlock_key_t key = k_spin_lock(&stats_lock);
+    synth_stats.run_count++;
+    if (is_tail) {
+        synth_stats.tail_count++;
+    }
+    synth_stats.burn_time_us += burn_us;
+    synth_stats.sleep_time_us += sleep_us;
+    k_spin_unlock(&stats_lock, key);
+
+    return label;
+}
+
+void synthetic_inference_get_stats(synthetic_stats_t *stats)
+{
+    if (stats == NULL) {
+        return;
+    }
+
+    k_spinlock_key_t key = k_spin_lock(&stats_lock);
+    *stats = synth_stats;
+    k_spin_unlock(&stats_lock, key);
+}
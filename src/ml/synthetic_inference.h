@@ -0,0 +1,70 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Zephyr Edge AI Demo - Synthetic Inference Load Model
+ *
+ * Stand-in inference backend used when the model cannot be loaded, or
+ * when CONFIG_ML_SYNTHETIC_INFERENCE forces it. Produces inference-like
+ * timing and class outputs so the sensor, queue and output subsystems
+ * can be stress tested without a real model.
+ */
+
+#ifndef SYNTHETIC_INFERENCE_H
+#define SYNTHETIC_INFERENCE_H
+
+#include "inference.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Synthetic backend statistics
+ */
+typedef struct {
+    /** Number of synthetic inferences run */
+    uint32_t run_count;
+
+    /** Number of runs that drew a latency from the long tail */
+    uint32_t tail_count;
+
+    /** Total time spent busy-waiting (us) */
+    uint64_t burn_time_us;
+
+    /** Total time spent sleeping (us) */
+    uint64_t sleep_time_us;
+} synthetic_stats_t;
+
+/**
+ * @brief Initialize the synthetic backend
+ *
+ * Seeds the pseudo-random generator from CONFIG_ML_SYNTH_SEED so that
+ * successive runs produce the same latency and class sequence.
+ */
+void synthetic_inference_init(void);
+
+/**
+ * @brief Run one synthetic inference
+ *
+ * Draws a latency from the configured distribution and spends it
+ * busy-waiting and/or sleeping, then draws a class from the configured
+ * output mix and fills in the per-class scores.
+ *
+ * @param[out] scores Per-class scores (GESTURE_COUNT entries)
+ * @return Selected gesture class
+ */
+gesture_label_t synthetic_inference_run(float *scores);
+
+/**
+ * @brief Get synthetic backend statistics
+ *
+ * @param[out] stats Pointer to statistics structure
+ */
+void synthetic_inference_get_stats(synthetic_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SYNTHETIC_INFERENCE_H */
@@ -0,0 +1,392 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Zephyr Edge AI Demo - Temporal Gesture Decoder
+ *
+ * Model, one frame per inference result:
+ *   - State 0 is IDLE, with a self loop.
+ *   - Gesture g has states g_1 .. g_D (D = its minimum duration in
+ *     frames). g_k moves to g_k+1 with probability 1; the last state
+ *     g_D loops with probability STAY, otherwise starts any gesture's
+ *     chain with ENTER each (back-to-back gestures) or returns to IDLE.
+ *   - IDLE starts each gesture's chain with ENTER.
+ *   - Emission log-likelihood of a state is the log of its class score,
+ *     floored so a single confident wrong frame costs a bounded amount.
+ *
+ * Viterbi runs in the log domain, renormalized every frame. Back
+ * pointers for the last LAG frames are kept in a ring; after each frame
+ * the best path is traced back LAG steps and the state reached is the
+ * final decision for that frame. A gesture event is emitted when the
+ * decided path reaches the last state of a gesture chain, i.e. once
+ * the gesture has lasted its minimum duration.
+ */
+
+#include "temporal_decoder.h"
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <math.h>
+#include <string.h>
+
+LOG_MODULE_REGISTER(temporal_decoder, CONFIG_LOG_DEFAULT_LEVEL);
+
+/* ============================================================================
+ * Configuration
+ * ============================================================================ */
+
+#ifndef CONFIG_ML_DECODER_LAG
+#define CONFIG_ML_DECODER_LAG 2
+#endif
+
+#ifndef CONFIG_ML_DECODER_ENTER_PERCENT
+#define CONFIG_ML_DECODER_ENTER_PERCENT 10
+#endif
+
+#ifndef CONFIG_ML_DECODER_STAY_PERCENT
+#define CONFIG_ML_DECODER_STAY_PERCENT 50
+#endif
+
+#ifndef CONFIG_ML_DECODER_SCORE_FLOOR_PERMILLE
+#define CONFIG_ML_DECODER_SCORE_FLOOR_PERMILLE 10
+#endif
+
+#ifndef CONFIG_ML_DECODER_WAVE_MS
+#define CONFIG_ML_DECODER_WAVE_MS 500
+#endif
+
+#ifndef CONFIG_ML_DECODER_TAP_MS
+#define CONFIG_ML_DECODER_TAP_MS 300
+#endif
+
+#ifndef CONFIG_ML_DECODER_CIRCLE_MS
+#define CONFIG_ML_DECODER_CIRCLE_MS 500
+#endif
+
+/** Gesture classes (all but IDLE) */
+#define NUM_GESTURES (GESTURE_COUNT - 1)
+
+/** Upper bound on the state count */
+#define MAX_STATES (1 + NUM_GESTURES * DECODER_MAX_DURATION_FRAMES)
+
+/** Frames held for traceback: the decided frame plus LAG newer ones */
+#define RING_FRAMES (CONFIG_ML_DECODER_LAG + 1)
+
+/** Log probability of an impossible transition */
+#define LOG_ZERO (-1.0e30f)
+
+BUILD_ASSERT(NUM_GESTURES * CONFIG_ML_DECODER_ENTER_PERCENT < 100,
+             "Gesture entry probabilities leave no room for idle");
+BUILD_ASSERT(MAX_STATES <= UINT8_MAX, "Back pointers are 8-bit");
+
+/* ============================================================================
+ * Private Data
+ * ============================================================================ */
+
+/** Per-gesture minimum durations (ms), indexed by gesture_label_t */
+static const uint32_t duration_ms[GESTURE_COUNT] = {
+    [GESTURE_WAVE] = CONFIG_ML_DECODER_WAVE_MS,
+    [GESTURE_TAP] = CONFIG_ML_DECODER_TAP_MS,
+    [GESTURE_CIRCLE] = CONFIG_ML_DECODER_CIRCLE_MS,
+};
+
+/** State layout: first state and chain length per gesture */
+static uint8_t chain_first[GESTURE_COUNT];
+static uint8_t chain_len[GESTURE_COUNT];
+static uint8_t num_states = 1;
+
+/** Gesture and chain position (0-based) of each state */
+static uint8_t state_gesture[MAX_STATES];
+static uint8_t state_pos[MAX_STATES];
+
+/** Log transition probabilities */
+static float log_enter;
+static float log_idle_stay;
+static float log_last_stay;
+static float log_last_idle;
+static float log_last_enter;
+static float log_floor;
+
+/** Path scores after the newest frame */
+static float delta[MAX_STATES];
+
+/** Frame ring: back pointers, scores and timestamps */
+static uint8_t back[RING_FRAMES][MAX_STATES];
+static float frame_scores[RING_FRAMES][GESTURE_COUNT];
+static uint32_t frame_ts[RING_FRAMES];
+
+/** Frames pushed */
+static uint32_t frame_count = 0;
+
+/** Decided segment being tracked */
+static uint8_t last_decided = 0;
+static uint32_t seg_frames = 0;
+static float seg_score_sum = 0.0f;
+static uint32_t seg_start_us = 0;
+static bool seg_emitted = false;
+
+static uint32_t event_sequence = 0;
+
+static decoder_stats_t stats = {0};
+static struct k_spinlock stats_lock;
+
+/* ============================================================================
+ * Private Functions
+ * ============================================================================ */
+
+static bool is_last(uint8_t s)
+{
+    return s != 0 && state_pos[s] == chain_len[state_gesture[s]] - 1;
+}
+
+static float emission(uint8_t s, const float *scores)
+{
+    float p = scores[state_gesture[s]];
+
+    return p > 0.0f ? MAX(logf(p), log_floor) : log_floor;
+}
+
+/**
+ * @brief Best predecessor of a state, from the previous frame's scores
+ *
+ * @param s State
+ * @param[out] from Predecessor state
+ * @return Predecessor path score plus the transition
+ */
+static float best_predecessor(uint8_t s, uint8_t *from)
+{
+    float best = LOG_ZERO;
+    uint8_t arg = 0;
+
+#define CONSIDER(p, log_a)                                                    \
+    do {                                                                      \
+        float v_ = delta[(p)] + (log_a);                                      \
+        if (v_ > best) {                                                      \
+            best = v_;                                                        \
+            arg = (p);                                                        \
+        }                                                                     \
+    } while (0)
+
+    if (s == 0) {
+        CONSIDER(0, log_idle_stay);
+        for (int h = 1; h < GESTURE_COUNT; h++) {
+            CONSIDER(chain_first[h] + chain_len[h] - 1, log_last_idle);
+        }
+    } else if (state_pos[s] == 0) {
+        CONSIDER(0, log_enter);
+        for (int h = 1; h < GESTURE_COUNT; h++) {
+            CONSIDER(chain_first[h] + chain_len[h] - 1, log_last_enter);
+        }
+    } else {
+        CONSIDER(s - 1, 0.0f);
+    }
+
+    /* Self loop of the last chain state (g_1 itself when D == 1) */
+    if (is_last(s)) {
+        CONSIDER(s, log_last_stay);
+    }
+
+#undef CONSIDER
+
+    *from = arg;
+    return best;
+}
+
+/**
+ * @brief Trace the best path back to the oldest frame in the ring
+ *
+ * @return Decided state of frame (frame_count - 1 - LAG)
+ */
+static uint8_t traceback(void)
+{
+    uint8_t s = 0;
+
+    for (uint8_t i = 1; i < num_states; i++) {
+        if (delta[i] > delta[s]) {
+            s = i;
+        }
+    }
+
+    for (uint32_t j = 0; j < CONFIG_ML_DECODER_LAG; j++) {
+        s = back[(frame_count - 1 - j) % RING_FRAMES][s];
+    }
+
+    return s;
+}
+
+/**
+ * @brief Track the decided path and emit an event when a gesture's
+ *        chain is completed
+ */
+static bool on_decided(uint8_t s, uint32_t slot, uint32_t newest_us,
+                       decoder_event_t *event)
+{
+    uint8_t g = state_gesture[s];
+    const float *scores = frame_scores[slot];
+    uint8_t top = 0;
+
+    for (uint8_t c = 1; c < GESTURE_COUNT; c++) {
+        if (scores[c] > scores[top]) {
+            top = c;
+        }
+    }
+
+    /* New segment on a change of class, or a back-to-back repeat */
+    bool repeat = state_pos[s] == 0 && is_last(last_decided) &&
+                  state_gesture[last_decided] == g && chain_len[g] > 1;
+
+    if (g != state_gesture[last_decided] || repeat || frame_count == RING_FRAMES) {
+        seg_frames = 0;
+        seg_score_sum = 0.0f;
+        seg_start_us = frame_ts[slot];
+        seg_emitted = false;
+    }
+
+    seg_frames++;
+    seg_score_sum += scores[g];
+    last_decided = s;
+
+    k_spinlock_key_t key = k_spin_lock(&stats_lock);
+    if (top != g) {
+        stats.smoothed++;
+    }
+    k_spin_unlock(&stats_lock, key);
+
+    if (g == GESTURE_IDLE || seg_emitted || !is_last(s)) {
+        return false;
+    }
+
+    seg_emitted = true;
+
+    event->gesture = (gesture_label_t)g;
+    event->confidence = seg_score_sum / (float)seg_frames;
+    event->frames = seg_frames;
+    event->start_us = seg_start_us;
+    event->delay_us = newest_us - frame_ts[slot];
+    event->sequence = ++event_sequence;
+
+    key = k_spin_lock(&stats_lock);
+    stats.events++;
+    k_spin_unlock(&stats_lock, key);
+
+    return true;
+}
+
+/* ============================================================================
+ * Public API Implementation
+ * ============================================================================ */
+
+int temporal_decoder_init(uint32_t frame_period_ms)
+{
+    if (frame_period_ms == 0) {
+        return -EINVAL;
+    }
+
+    num_states = 1;
+    state_gesture[0] = GESTURE_IDLE;
+    state_pos[0] = 0;
+    chain_first[GESTURE_IDLE] = 0;
+    chain_len[GESTURE_IDLE] = 1;
+
+    for (int g = 1; g < GESTURE_COUNT; g++) {
+        uint32_t frames = (duration_ms[g] + frame_period_ms / 2) /
+                          frame_period_ms;
+
+        frames = CLAMP(frames, 1, DECODER_MAX_DURATION_FRAMES);
+        chain_first[g] = num_states;
+        chain_len[g] = (uint8_t)frames;
+
+        for (uint32_t k = 0; k < frames; k++) {
+            state_gesture[num_states] = (uint8_t)g;
+            state_pos[num_states] = (uint8_t)k;
+            num_states++;
+        }
+    }
+
+    float enter = CONFIG_ML_DECODER_ENTER_PERCENT / 100.0f;
+    float stay = CONFIG_ML_DECODER_STAY_PERCENT / 100.0f;
+    float idle = 1.0f - NUM_GESTURES * enter;
+
+    log_enter = logf(enter);
+    log_idle_stay = logf(idle);
+    log_last_stay = logf(stay);
+    log_last_enter = logf((1.0f - stay) * enter);
+    log_last_idle = logf((1.0f - stay) * idle);
+    log_floor = logf(CONFIG_ML_DECODER_SCORE_FLOOR_PERMILLE / 1000.0f);
+
+    /* Start in IDLE */
+    for (uint8_t s = 0; s < num_states; s++) {
+        delta[s] = (s == 0) ? 0.0f : LOG_ZERO;
+    }
+
+    frame_count = 0;
+    last_decided = 0;
+    seg_frames = 0;
+    seg_emitted = false;
+    event_sequence = 0;
+
+    k_spinlock_key_t key = k_spin_lock(&stats_lock);
+    memset(&stats, 0, sizeof(stats));
+    for (int g = 1; g < GESTURE_COUNT; g++) {
+        stats.duration_frames[g] = chain_len[g];
+    }
+    k_spin_unlock(&stats_lock, key);
+
+    LOG_INF("Temporal decoder: %u states, lag %d frames, "
+            "chains wave/tap/circle %u/%u/%u at %u ms per frame",
+            num_states, CONFIG_ML_DECODER_LAG, chain_len[GESTURE_WAVE],
+            chain_len[GESTURE_TAP], chain_len[GESTURE_CIRCLE],
+            frame_period_ms);
+    return 0;
+}
+
+bool temporal_decoder_push(const inference_result_t *result,
+                           decoder_event_t *event)
+{
+    float next[MAX_STATES];
+    float best = LOG_ZERO;
+    uint32_t slot = frame_count % RING_FRAMES;
+
+    if (result == NULL || event == NULL) {
+        return false;
+    }
+
+    /* Viterbi step */
+    for (uint8_t s = 0; s < num_states; s++) {
+        next[s] = best_predecessor(s, &back[slot][s]) +
+                  emission(s, result->class_scores);
+        best = MAX(best, next[s]);
+    }
+
+    /* Renormalize so scores stay in float range over long runs */
+    for (uint8_t s = 0; s < num_states; s++) {
+        delta[s] = MAX(next[s] - best, LOG_ZERO);
+    }
+
+    memcpy(frame_scores[slot], result->class_scores,
+           sizeof(frame_scores[slot]));
+    frame_ts[slot] = result->timestamp_us;
+    frame_count++;
+
+    k_spinlock_key_t key = k_spin_lock(&stats_lock);
+    stats.frames++;
+    k_spin_unlock(&stats_lock, key);
+
+    if (frame_count < RING_FRAMES) {
+        return false;
+    }
+
+    /* Oldest frame in the ring is now final */
+    return on_decided(traceback(), frame_count % RING_FRAMES,
+                      result->timestamp_us, event);
+}
+
+void temporal_decoder_get_stats(decoder_stats_t *out)
+{
+    if (out == NULL) {
+        return;
+    }
+
+    k_spinlock_key_t key = k_spin_lock(&stats_lock);
+    *out = stats;
+    k_spin_unlock(&stats_lock, key);
+}
@@ -0,0 +1,104 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Zephyr Edge AI Demo - Temporal Gesture Decoder
+ *
+ * Turns the stream of per-window classifier scores into gesture
+ * events. A small HMM gives each gesture a left-to-right chain of
+ * states whose length is the gesture's minimum duration in frames,
+ * plus a single idle state; a fixed-lag online Viterbi decodes it, so
+ * one noisy frame cannot start or break a gesture and each decision is
+ * final after CONFIG_ML_DECODER_LAG further frames.
+ */
+
+#ifndef TEMPORAL_DECODER_H
+#define TEMPORAL_DECODER_H
+
+#include "inference.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Longest gesture chain (frames) */
+#define DECODER_MAX_DURATION_FRAMES 8
+
+/**
+ * @brief Decoded gesture event
+ */
+typedef struct {
+    /** Gesture (never GESTURE_IDLE) */
+    gesture_label_t gesture;
+
+    /** Mean classifier score of the gesture over its decoded frames */
+    float confidence;
+
+    /** Decoded frames up to the event */
+    uint32_t frames;
+
+    /** Completion timestamp of the segment's first frame (us) */
+    uint32_t start_us;
+
+    /** Time from the segment's last decoded frame to the newest frame,
+     *  i.e. the cost of the decoding lag (us) */
+    uint32_t delay_us;
+
+    /** Event sequence number */
+    uint32_t sequence;
+} decoder_event_t;
+
+/**
+ * @brief Decoder statistics
+ */
+typedef struct {
+    /** Frames pushed */
+    uint32_t frames;
+
+    /** Events emitted */
+    uint32_t events;
+
+    /** Decided frames whose top class differed from the decoded state */
+    uint32_t smoothed;
+
+    /** Chain length per gesture class (frames, 0 for idle) */
+    uint8_t duration_frames[GESTURE_COUNT];
+} decoder_stats_t;
+
+/**
+ * @brief Build the model for a frame period
+ *
+ * Per-gesture minimum durations (CONFIG_ML_DECODER_*_MS) are converted
+ * to chain lengths at this frame period.
+ *
+ * @param frame_period_ms Time between successive results (ms)
+ * @return 0 on success, -EINVAL if frame_period_ms is 0
+ */
+int temporal_decoder_init(uint32_t frame_period_ms);
+
+/**
+ * @brief Feed one inference result
+ *
+ * Not thread-safe; call from one thread.
+ *
+ * @param result Classifier result (class_scores are used)
+ * @param[out] event Filled when a gesture is confirmed
+ * @return true if an event was emitted
+ */
+bool temporal_decoder_push(const inference_result_t *result,
+                           decoder_event_t *event);
+
+/**
+ * @brief Get decoder statistics
+ *
+ * @param[out] stats Statistics
+ */
+void temporal_decoder_get_stats(decoder_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TEMPORAL_DECODER_H */
@@ -0,0 +1,156 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Zephyr Edge AI Demo - Gradient-Boosted Tree Classifier
+ *
+ * Features (per axis, over the N samples of the window, int32):
+ *   sum      sum(x)
+ *   energy   sum(x^2)
+ *   var      N * sum(x^2) - sum(x)^2, the variance times N^2
+ *   zc       sign changes between neighbouring samples
+ *   hi       sum((x[i] - x[i-1])^2), high band energy
+ *   lo       sum((x[i] + x[i-1] + x[i-2] + x[i-3])^2), low band energy
+ *   peak     max(|x|)
+ * With |x| <= 128 and N = 50 the largest (var) stays below 2^26.
+ *
+ * The definitions must match extract_features() in model/tree_model.py,
+ * which trains on the same integers; thresholds are then exact.
+ *
+ * Each tree is a complete binary tree in heap order, so a descent is
+ * TREE_MODEL_DEPTH steps of idx = 2 * idx + 1 + (f > thr): loads, one
+ * compare and adds, the same instruction count for every input.
+ */
+
+#include "tree_classifier.h"
+#include "tree_model.h"
+
+#include <zephyr/kernel.h>
+#include <errno.h>
+
+/* ============================================================================
+ * Configuration
+ * ============================================================================ */
+
+enum {
+    FEAT_SUM,
+    FEAT_ENERGY,
+    FEAT_VAR,
+    FEAT_ZC,
+    FEAT_HI,
+    FEAT_LO,
+    FEAT_PEAK,
+    FEATS_PER_AXIS
+};
+
+/** Split nodes per tree; leaves follow them in heap order */
+#define TREE_INNER_NODES ((1 << TREE_MODEL_DEPTH) - 1)
+
+BUILD_ASSERT(TREE_MODEL_WINDOW == CONFIG_ML_INFERENCE_WINDOW_SIZE,
+             "tree_model.h was trained for another window size");
+BUILD_ASSERT(TREE_MODEL_AXES == ML_INPUT_AXES, "Axis count mismatch");
+BUILD_ASSERT(TREE_MODEL_CLASSES == GESTURE_COUNT, "Class count mismatch");
+BUILD_ASSERT(TREE_MODEL_FEATURES == ML_INPUT_AXES * FEATS_PER_AXIS,
+             "tree_model.h uses another feature set");
+BUILD_ASSERT(TREE_MODEL_WINDOW >= 4, "Low band filter needs 4 samples");
+
+/* ============================================================================
+ * Private Functions
+ * ============================================================================ */
+
+static inline int32_t abs32(int32_t v)
+{
+    int32_t sign = v >> 31;
+
+    return (v ^ sign) - sign;
+}
+
+static inline int32_t max32(int32_t a, int32_t b)
+{
+    return a ^ ((a ^ b) & -(int32_t)(b > a));
+}
+
+static void extract_features(const int8_t *window, int32_t *features)
+{
+    for (int a = 0; a < ML_INPUT_AXES; a++) {
+        const int8_t *x = window + a;
+        int32_t *f = features + a * FEATS_PER_AXIS;
+        int32_t sum = x[0];
+        int32_t energy = x[0] * x[0];
+        int32_t zc = 0;
+        int32_t hi = 0;
+        int32_t lo = 0;
+        int32_t peak = abs32(x[0]);
+
+        for (int i = 1; i < TREE_MODEL_WINDOW; i++) {
+            int32_t v = x[i * ML_INPUT_AXES];
+            int32_t prev = x[(i - 1) * ML_INPUT_AXES];
+            int32_t d = v - prev;
+
+            sum += v;
+            energy += v * v;
+            zc += (int32_t)((uint32_t)(v ^ prev) >> 31);
+            hi += d * d;
+            peak = max32(peak, abs32(v));
+        }
+
+        /* 4-tap box filter, sliding */
+        int32_t box = x[0] + x[ML_INPUT_AXES] + x[2 * ML_INPUT_AXES];
+
+        for (int i = 3; i < TREE_MODEL_WINDOW; i++) {
+            box += x[i * ML_INPUT_AXES];
+            lo += box * box;
+            box -= x[(i - 3) * ML_INPUT_AXES];
+        }
+
+        f[FEAT_SUM] = sum;
+        f[FEAT_ENERGY] = energy;
+        f[FEAT_VAR] = TREE_MODEL_WINDOW * energy - sum * sum;
+        f[FEAT_ZC] = zc;
+        f[FEAT_HI] = hi;
+        f[FEAT_LO] = lo;
+        f[FEAT_PEAK] = peak;
+    }
+}
+
+static void evaluate(const int32_t *features, int32_t *scores)
+{
+    for (int t = 0; t < TREE_MODEL_TREES; t++) {
+        const uint8_t *feat = tree_feature[t];
+        const int32_t *thr = tree_threshold[t];
+        uint32_t n = 0;
+
+        for (int d = 0; d < TREE_MODEL_DEPTH; d++) {
+            n = 2 * n + 1 + (uint32_t)(features[feat[n]] > thr[n]);
+        }
+
+        scores[tree_class[t]] += tree_leaf[t][n - TREE_INNER_NODES];
+    }
+}
+
+/* ============================================================================
+ * Public API Implementation
+ * ============================================================================ */
+
+int tree_classifier_run(const int8_t *window, size_t len, float *scores)
+{
+    int32_t features[TREE_MODEL_FEATURES];
+    int32_t acc[TREE_MODEL_CLASSES] = {0};
+
+    if (len != ML_INPUT_SIZE) {
+        return -EINVAL;
+    }
+
+    extract_features(window, features);
+    evaluate(features, acc);
+
+    for (int c = 0; c < TREE_MODEL_CLASSES; c++) {
+        scores[c] = (float)acc[c] * (1.0f / (1 << TREE_MODEL_SCORE_SHIFT));
+    }
+
+    return 0;
+}
+
+int tree_classifier_tree_count(void)
+{
+    return TREE_MODEL_TREES;
+}
@@ -0,0 +1,47 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Zephyr Edge AI Demo - Gradient-Boosted Tree Classifier
+ *
+ * Alternative inference backend (CONFIG_ML_TREE_CLASSIFIER). Instead of
+ * running the neural network, it reduces the int8 window to a handful of
+ * integer features per axis (mean, variance, energy, zero crossings,
+ * band energies, peak) and evaluates a small gradient-boosted tree
+ * ensemble on them. The trees are trained and code-generated into
+ * tree_model.h by model/train_gesture_model.py; evaluation is integer
+ * only and free of data-dependent branches.
+ */
+
+#ifndef TREE_CLASSIFIER_H
+#define TREE_CLASSIFIER_H
+
+#include "inference.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Classify one window
+ *
+ * @param window Preprocessed int8 window, samples interleaved per axis
+ * @param len Window length (must be ML_INPUT_SIZE)
+ * @param[out] scores Per-class logits (GESTURE_COUNT entries); apply
+ *             softmax for probabilities
+ * @return 0 on success, -EINVAL on a window of the wrong size
+ */
+int tree_classifier_run(const int8_t *window, size_t len, float *scores);
+
+/**
+ * @brief Number of trees in the generated ensemble
+ */
+int tree_classifier_tree_count(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TREE_CLASSIFIER_H */
@@ -0,0 +1,191 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Zephyr Edge AI Demo - Gradient-Boosted Tree Model
+ *
+ * Generated by model/train_gesture_model.py; regenerate rather than edit.
+ * Complete binary trees in heap order: node i splits on
+ * features[tree_feature[t][i]] > tree_threshold[t][i] (go to 2i+2, else
+ * 2i+1); leaves add tree_leaf[t][j] to the score of class tree_class[t].
+ * Scores are in units of 2^-TREE_MODEL_SCORE_SHIFT.
+ *
+ * 12 stages x 4 classes, depth 3, learning rate 0.3
+ * Validation accuracy: 99.62% (sklearn), 99.62% (integer tables)
+ */
+
+#ifndef TREE_MODEL_H
+#define TREE_MODEL_H
+
+#include <stdint.h>
+
+#define TREE_MODEL_WINDOW      50
+#define TREE_MODEL_AXES        3
+#define TREE_MODEL_FEATURES    21
+#define TREE_MODEL_CLASSES     4
+#define TREE_MODEL_TREES       48
+#define TREE_MODEL_DEPTH       3
+#define TREE_MODEL_SCORE_SHIFT 12
+
+/* Feature index: axis * 7 + one of sum, energy, var, zc, hi, lo, peak */
+
+static const uint8_t tree_feature[TREE_MODEL_TREES][7] = {
+    { 13,  0,  0,  0,  0,  0,  0 },
+    {  2,  2,  4,  0,  4, 12, 12 },
+    { 20,  0,  0,  0,  0,  0,  0 },
+    { 10,  4,  3,  7,  8,  0,  7 },
+    {  9, 15,  7,  0, 18,  0,  4 },
+    {  2,  1,  4,  8,  4, 12, 12 },
+    { 14,  7,  0,  0, 14,  0,  0 },
+    { 10,  4,  3,  7,  8, 13,  7 },
+    {  9,  3,  7,  0,  9,  0,  4 },
+    {  2, 13,  4,  9, 12, 12, 12 },
+    { 18,  7,  0,  0, 14,  0,  0 },
+    { 10,  4,  3, 11, 12, 13,  7 },
+    { 12,  0,  7,  0,  0, 14,  4 },
+    {  2, 13,  4, 13, 20, 11, 12 },
+    { 14,  7, 19,  5, 14,  0,  5 },
+    {  3,  4, 10,  7,  7,  2, 12 },
+    {  1,  0,  4,  0,  0,  7,  2 },
+    {  1,  8, 10, 13, 15,  4,  4 },
+    { 19,  7,  1,  8, 10,  0,  0 },
+    {  3,  4, 10, 11, 12,  1, 12 },
+    { 15,  0,  4,  0,  0, 10,  1 },
+    {  1,  5, 10,  2, 11,  4, 12 },
+    { 15,  7,  0,  9, 10,  0,  0 },
+    {  3,  4, 10, 11, 12, 12,  7 },
+    {  5,  0,  4,  0,  0, 10,  1 },
+    {  1,  8, 10,  3,  6,  4,  4 },
+    { 15,  7,  0,  2, 10,  0,  0 },
+    { 10,  4,  3,  2,  9,  1,  7 },
+    { 12,  0,  4,  0,  0,  3,  1 },
+    {  1,  5, 10,  2, 20,  4, 12 },
+    { 14,  7,  0,  0, 10,  0,  0 },
+    {  3,  4, 10,  6,  6, 12,  7 },
+    {  2,  0,  4,  0,  0,  3, 12 },
+    {  1,  9,  4,  2,  0,  8,  7 },
+    { 14, 10,  0,  4,  7,  0,  0 },
+    { 10,  4,  7, 13,  6,  7,  0 },
+    { 16,  0,  4,  0,  0,  3, 12 },
+    {  1,  2,  4,  2, 13, 13, 12 },
+    { 16, 10,  0,  4,  7,  0,  0 },
+    { 10,  4,  7,  4,  8,  3,  9 },
+    { 12,  0,  4,  0,  0,  3, 12 },
+    {  1,  8, 10,  7,  0,  4,  7 },
+    { 14,  7,  0,  7,  6,  0,  0 },
+    {  3,  4,  7, 11,  8, 12,  0 },
+    {  5,  0,  4,  0,  0,  3, 12 },
+    {  7,  0,  4,  0,  0, 11,  4 },
+    { 14, 10,  0,  6,  7,  0,  0 },
+    {  3, 10,  7,  4,  1,  7,  0 },
+};
+
+static const int32_t tree_threshold[TREE_MODEL_TREES][7] = {
+    {         15, 2147483647, 2147483647, 2147483647, 2147483647, 2147483647, 2147483647 },
+    {    3202470,    2959795,       5308, 2147483647,       3751,     838032,    1610063 },
+    {         78, 2147483647, 2147483647, 2147483647, 2147483647, 2147483647, 2147483647 },
+    {          3,       5485,          2,        -45,     112478, 2147483647,        414 },
+    {     109840,        221,       -554, 2147483647,        381, 2147483647,       5256 },
+    {    3202470,      61603,       5182,      86173,       3751,     838032,    1609841 },
+    {        290,       -554, 2147483647, 2147483647,        155, 2147483647, 2147483647 },
+    {          3,       5308,          2,        -45,     109710,         54,        414 },
+    {     109840,         14,       -554, 2147483647,       8712, 2147483647,       5256 },
+    {    3056855,         64,       4701,    3734544,    1380184,     800068,    1447722 },
+    {      12972,       -554, 2147483647, 2147483647,        155, 2147483647, 2147483647 },
+    {          3,       4701,          2,       4750,    1447722,         54,        501 },
+    {       6014, 2147483647,       -554, 2147483647, 2147483647,          6,       5411 },
+    {    3056855,         64,       4175,         59,         17,       4770,    1446623 },
+    {        290,       -554,     407054,    1185164,        155, 2147483647,      15425 },
+    {          3,       5308,          2,        -58,        622,    3119930,    1445632 },
+    {       2141, 2147483647,       5500, 2147483647, 2147483647,       -145,    3050092 },
+    {      62580,      73897,          2,         59,       1741,       5210,       3346 },
+    {     180216,       -554,       5082,      85257,          4, 2147483647, 2147483647 },
+    {          3,       3787,          2,       4687,    1352570,      62725,    1445632 },
+    {        878, 2147483647,       5500, 2147483647, 2147483647,          3,      62170 },
+    {      61603,     854458,          2,    1729660,       3498,       5210,    1490134 },
+    {      17832,       -554, 2147483647,    3932734,          4, 2147483647, 2147483647 },
+    {          3,       3868,          2,       4755,    1263909,    1018684,        452 },
+    {       6394, 2147483647,       5500, 2147483647, 2147483647,          3,      62170 },
+    {      62580,      71107,          2,          4,         55,       3790,       3346 },
+    {      17832,       -554, 2147483647,    3876065,          4, 2147483647, 2147483647 },
+    {          2,       3790,          2,    2935536,    4111890,      61611,        434 },
+    {       6014, 2147483647,       5500, 2147483647, 2147483647,          3,      62516 },
+    {      61603,     854458,          2,    2988392,         14,       3790,    1490134 },
+    {        290,       -575, 2147483647, 2147483647,          4, 2147483647, 2147483647 },
+    {          3,       3346,          2,         40,         59,    1018684,        452 },
+    {     104625, 2147483647,       5500, 2147483647, 2147483647,          3,    1456659 },
+    {      64043,    5020065,       3787,    3153685, 2147483647,      55080,        573 },
+    {        290,          4, 2147483647,       5500,        441, 2147483647, 2147483647 },
+    {          3,       3787,        575,         39,         61,        520, 2147483647 },
+    {      43376, 2147483647,       5500, 2147483647, 2147483647,          3,    1456659 },
+    {      60820,    2997320,       4175,    2973634,         53,         39,    1489837 },
+    {     797550,          4, 2147483647,       5500,        441, 2147483647, 2147483647 },
+    {          2,       3783,        576,       3366,      79487,          2,    4165403 },
+    {       6014, 2147483647,       5500, 2147483647, 2147483647,          3,    1456659 },
+    {      64215,     100649,          2,        503, 2147483647,       3783,        546 },
+    {        290,        339, 2147483647,       -575,         40, 2147483647, 2147483647 },
+    {          3,       4243,        504,       4750,      97762,    1217154, 2147483647 },
+    {       6394, 2147483647,       5411, 2147483647, 2147483647,          3,    1456659 },
+    {       -575, 2147483647,       3346, 2147483647, 2147483647,       1541,       3355 },
+    {        290,          4, 2147483647,         61,        441, 2147483647, 2147483647 },
+    {          2,          2,        433,       3824,      61611,       -575,        260 },
+};
+
+static const int16_t tree_leaf[TREE_MODEL_TREES][8] = {
+    {   3686,   3686,   3686,   3686,  -1229,  -1229,  -1229,  -1229 },
+    {  -1229,  -1229,  -1121,   3686,   3686,  -1014,   3686,  -1229 },
+    {  -1229,  -1229,  -1229,  -1229,   3686,   3686,   3686,   3686 },
+    {  -1229,   3546,  -1229,   3686,   3686,   3686,  -1227,   1229 },
+    {   1754,   1754,   1754,   1754,  -1223,  -1223,  -1100,  -1095 },
+    {  -1093,   1754,   -917,   1835,   1985,   -854,   1762,  -1099 },
+    {  -1223,  -1223,  -1097,  -1223,   1754,   1754,   1754,   1754 },
+    {  -1167,   1705,  -1109,   1763,   1754,   1769,  -1093,    743 },
+    {   1337,   1337,   1337,   1337,  -1213,  -1213,  -1036,  -1028 },
+    {  -1024,    567,   1337,   2056,   1719,   -837,   1374,   -947 },
+    {  -1213,  -1213,  -1031,  -1208,   1337,   1337,   1337,   1337 },
+    {   1308,   -663,  -1195,   1343,   1337,   1351,  -1022,    860 },
+    {   1155,   1155,   1155,   1155,  -1191,  -1144,   -998,   -988 },
+    {   -983,    333,   1155,   1493,   -830,   4220,   1213,   -920 },
+    {  -1191,  -1144,   -992,  -1135,   1155,   1155,   1155,   1155 },
+    {  -1132,   1087,   -999,   1158,   1168,   1181,   -984,  -1906 },
+    {   1060,   1060,   1060,   1060,  -1069,   -970,   -964,   -963 },
+    {   -955,    453,   1197,   1056,   -976,   -967,   -976,   1090 },
+    {  -1139,  -1055,   -971,   -963,   1060,   1060,   1060,   1060 },
+    {   1057,  -2331,  -1006,   1007,   1067,   1080,   -953,  -1643 },
+    {   1006,   1006,   1006,   1006,   -953,  -1019,   -948,   -947 },
+    {   -948,   -958,   -950,   1484,   -957,   -951,   1020,   -972 },
+    {  -1095,  -1012,   -955,   -948,   1006,   1006,   1006,   1006 },
+    {    975,  -1634,  -1218,    867,   1010,   1018,   -935,   1207 },
+    {    974,    974,    974,    974,   -943,   -999,   -939,   -938 },
+    {   -950,   -918,    119,   1108,   -944,   -949,   -956,    961 },
+    {   -979,  -1034,   -945,   -938,    974,    974,    974,    974 },
+    {    978,    982,   1055,    985,    977,    992,   -909,    667 },
+    {    955,    955,    955,    955,   -937,   -987,   -933,   -932 },
+    {   -934,  -1091,   1373,     -4,   -936,   -939,    905,   -956 },
+    {  -1007,  -1007,   -940,   -932,    955,    955,    955,    955 },
+    {   1311,    962,  -1065,    465,    956,    959,   -883,   1102 },
+    {    943,    943,    943,    943,   -932,   -986,   -928,   -931 },
+    {   -870,   -875,   1081,   1081,   1876,   -800,    973,   -948 },
+    {   -939,   -928,   -928,   -944,    943,    943,    943,    943 },
+    {  -3102,    902,  -1066,    367,   -842,  -1084,   1296,   1296 },
+    {    935,    935,    935,    935,   -930,   -985,   -926,   -928 },
+    {   -927,    864,  -1232,   -926,   1884,   -399,    972,   -939 },
+    {   -937,   -926,   -926,   -943,    935,    935,    935,    935 },
+    {    937,    940,   1021,    946,    944,   -673,   1073,    930 },
+    {    930,    930,    930,    930,   -928,   -990,   -924,   -926 },
+    {   -829,  -1039,   1009,   1009,   -926,   -932,    813,   -565 },
+    {   -959,   -931,  -1004,   -928,    930,    930,    930,    930 },
+    {    713,  -1029,   -987,    889,   -726,  -1045,   1051,   1051 },
+    {    927,    927,    927,    927,   -926,   -994,   -924,   -924 },
+    {   1227,   1227,   1227,   1227,   -924,   -947,   1412,    382 },
+    {   -948,   -924,   -924,   -936,    927,    927,    927,    927 },
+    {    928,    932,    928,    937,  -1143,   -657,    894,   -626 },
+};
+
+/* 0 = IDLE, 1 = WAVE, 2 = TAP, 3 = CIRCLE */
+static const uint8_t tree_class[TREE_MODEL_TREES] = {
+    0, 1, 2, 3, 0, 1, 2, 3, 0, 1, 2, 3, 0, 1, 2, 3,
+    0, 1, 2, 3, 0, 1, 2, 3, 0, 1, 2, 3, 0, 1, 2, 3,
+    0, 1, 2, 3, 0, 1, 2, 3, 0, 1, 2, 3, 0, 1, 2, 3,
+};
+
+#endif /* TREE_MODEL_H */
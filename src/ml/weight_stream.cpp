@@ -0,0 +1,1099 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Zephyr Edge AI Demo - Layer-wise Weight Streaming Backend
+ *
+ * Flash image (weights partition):
+ *
+ *     header | layer table | layer 0 weights | ... | biases
+ *
+ * The image describes itself: the layer table holds each layer's shape,
+ * weights offset and requantization parameters, so the streaming build
+ * runs whatever model the partition holds and needs no copy of it in
+ * the application image. Weights keep the TFLite [out][in] row-major
+ * order, each layer padded to IMAGE_ALIGN. Biases (int32, all layers)
+ * are read into SRAM once at init; they are a few bytes per output and
+ * needed by every chunk.
+ *
+ * With CONFIG_ML_WEIGHT_STREAM_PROVISION the image is built from the
+ * linked-in flatbuffer and written whenever the partition holds a
+ * different one. Only then are the TFLite schema headers needed.
+ *
+ * At run time a layer is split into chunks of as many weight rows as
+ * fit one buffer half. The compute side queues chunk k+1 for the
+ * prefetch thread before it waits for chunk k, so the read of the next
+ * chunk (of this layer or the next) overlaps the computation of the
+ * current one. The prefetch thread runs above the inference thread:
+ * it issues its read at once and, on drivers that wait for DMA or a
+ * bus transfer, blocks while the layer is computed. Reads, kernels and
+ * the whole run are timed separately; read plus compute time beyond the
+ * wall time is what actually overlapped. A compute-side stall alone
+ * would not show it: with a synchronous driver the prefetch thread
+ * preempts the compute side and finishes each read before the wait.
+ *
+ * The FC arithmetic matches the TFLite reference int8 kernel, so the
+ * results are identical to the interpreter's. Each layer uses the
+ * kernel variant tuned for its shape (fc_tuning.h).
+ */
+
+#include "weight_stream.h"
+#include "fc_kernels.h"
+#include "inference.h"
+#include "memmap.h"
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/storage/flash_map.h>
+#include <zephyr/sys/crc.h>
+#include <string.h>
+
+#ifdef CONFIG_ML_WEIGHT_STREAM_PROVISION
+#include "gesture_model.h"
+
+#include <cmath>
+
+#include <tensorflow/lite/kernels/internal/quantization_util.h>
+#include <tensorflow/lite/schema/schema_generated.h>
+#include <tensorflow/lite/schema/schema_utils.h>
+#endif
+
+LOG_MODULE_REGISTER(weight_stream, CONFIG_LOG_DEFAULT_LEVEL);
+
+/* ============================================================================
+ * Configuration
+ * ============================================================================ */
+
+#ifndef CONFIG_ML_WEIGHT_STREAM_BUFFER_SIZE
+#define CONFIG_ML_WEIGHT_STREAM_BUFFER_SIZE 2048
+#endif
+
+#ifndef CONFIG_ML_WEIGHT_STREAM_PRIORITY
+#define CONFIG_ML_WEIGHT_STREAM_PRIORITY 6
+#endif
+
+#ifndef CONFIG_ML_FC_TUNE_ITERATIONS
+#define CONFIG_ML_FC_TUNE_ITERATIONS 20
+#endif
+
+#if FIXED_PARTITION_EXISTS(weights_partition)
+#define WEIGHTS_PARTITION_ID FIXED_PARTITION_ID(weights_partition)
+#elif FIXED_PARTITION_EXISTS(storage_partition)
+#define WEIGHTS_PARTITION_ID FIXED_PARTITION_ID(storage_partition)
+#else
+/* No partition: flash_area_open() fails and init reports it, which
+ * still leaves the parsed layers for CONFIG_ML_FC_TUNE */
+#define WEIGHTS_PARTITION_ID 0xFF
+#endif
+
+/** Streamed layers supported */
+#define MAX_LAYERS WEIGHT_STREAM_MAX_LAYERS
+
+/** Widest layer input or output */
+#define MAX_ACTIVATIONS FC_MAX_DIM
+
+/** Total outputs over all layers (resident biases) */
+#define MAX_BIASES 512
+
+/** Image magic, "WST2" */
+#define IMAGE_MAGIC 0x32545357U
+
+/** Alignment of image sections (covers flash write blocks up to 8) */
+#define IMAGE_ALIGN 8
+
+/** Prefetch thread stack size */
+#define PREFETCH_STACK_SIZE 1024
+
+BUILD_ASSERT(CONFIG_ML_WEIGHT_STREAM_BUFFER_SIZE % IMAGE_ALIGN == 0,
+             "Buffer size must be a multiple of the image alignment");
+BUILD_ASSERT(ML_INPUT_SIZE <= MAX_ACTIVATIONS,
+             "Inference window too large for the activation buffers");
+
+/* ============================================================================
+ * Private Data
+ * ============================================================================ */
+
+/**
+ * @brief Image header, at the start of the partition
+ */
+struct image_header {
+    uint32_t magic;
+    uint32_t layers;
+    /** Bytes after the header: layer table, weights and biases */
+    uint32_t payload_bytes;
+    uint32_t payload_crc;
+    /** Biases offset in the image */
+    uint32_t bias_offset;
+    /** Scale of the last layer's output */
+    float output_scale;
+};
+
+/**
+ * @brief Layer table entry, one per layer after the header
+ */
+struct image_layer {
+    /** Weights offset in the image */
+    uint32_t offset;
+    uint16_t in_dim;
+    uint16_t out_dim;
+    int32_t input_offset;
+    int32_t output_zp;
+    int32_t multiplier;
+    int32_t shift;
+    int32_t act_min;
+    int32_t act_max;
+};
+
+BUILD_ASSERT(sizeof(struct image_header) % IMAGE_ALIGN == 0,
+             "Header must keep the layer table aligned");
+BUILD_ASSERT(sizeof(struct image_layer) % IMAGE_ALIGN == 0,
+             "Layer table must keep the weights aligned");
+
+/**
+ * @brief One fully-connected layer
+ */
+struct layer {
+    /** Weights offset in the image */
+    uint32_t offset;
+    uint16_t in_dim;
+    uint16_t out_dim;
+    uint16_t rows_per_chunk;
+    /** First bias in bias_pool */
+    uint16_t bias_index;
+    struct fc_params fc;
+    fc_variant_t variant;
+};
+
+/**
+ * @brief Chunk read request
+ */
+struct chunk_req {
+    uint32_t offset;
+    uint32_t len;
+    uint32_t slot;
+};
+
+/**
+ * @brief Position in the chunk sequence of one inference
+ */
+struct cursor {
+    uint8_t layer;
+    uint16_t row;
+};
+
+static struct layer layers[MAX_LAYERS];
+static uint8_t num_layers = 0;
+static uint32_t image_bytes = 0;
+static float output_scale = 0.0f;
+
+#ifdef CONFIG_ML_WEIGHT_STREAM_PROVISION
+/** Image of the linked-in model, as it is written */
+static struct image_header model_hdr;
+static struct image_layer model_table[MAX_LAYERS];
+
+/** Provisioning source in the flatbuffer */
+static const int8_t *src_weights[MAX_LAYERS];
+static const int32_t *src_bias[MAX_LAYERS];
+#endif
+
+static const struct flash_area *fa = nullptr;
+static bool stream_ready = false;
+
+static int32_t bias_pool[MAX_BIASES];
+static uint8_t chunk_buf[2][CONFIG_ML_WEIGHT_STREAM_BUFFER_SIZE] __aligned(4);
+static int8_t act[2][MAX_ACTIVATIONS];
+
+static K_MSGQ_DEFINE(req_msgq, sizeof(struct chunk_req), 2, 4);
+static struct k_sem ready_sem[2];
+static int slot_status[2];
+
+/** Read cycles of the current inference (prefetch thread only) */
+static uint32_t run_read_cyc = 0;
+
+static K_MUTEX_DEFINE(run_mutex);
+
+static weight_stream_stats_t stats = {};
+static struct k_spinlock stats_lock;
+
+#ifdef CONFIG_ML_WEIGHT_STREAM_PREFETCH
+static K_THREAD_STACK_DEFINE(prefetch_stack, PREFETCH_STACK_SIZE);
+static struct k_thread prefetch_thread;
+#endif
+
+/* ============================================================================
+ * Private Functions
+ * ============================================================================ */
+
+static uint32_t align_up(uint32_t v)
+{
+    return (v + IMAGE_ALIGN - 1) & ~(uint32_t)(IMAGE_ALIGN - 1);
+}
+
+static uint32_t layer_bytes(const struct layer *l)
+{
+    return (uint32_t)l->out_dim * l->in_dim;
+}
+
+/**
+ * @brief Share of read time hidden behind compute, (read + compute - total) / read
+ */
+static uint32_t overlap_permille(uint64_t read_us, uint64_t compute_us,
+                                 uint64_t total_us)
+{
+    uint64_t busy_us = read_us + compute_us;
+    uint64_t hidden_us = busy_us > total_us ?
+        MIN(busy_us - total_us, read_us) : 0;
+
+    return read_us > 0 ? (uint32_t)(hidden_us * 1000U / read_us) : 0;
+}
+
+/**
+ * @brief Set up a layer from its table entry
+ *
+ * @param biases Outputs of the layers before it
+ * @return 0, or -ENOSPC if it exceeds the streaming buffers
+ */
+static int load_layer(const struct image_layer *e, uint32_t biases,
+                      struct layer *l)
+{
+    if (e->in_dim == 0 || e->out_dim == 0 ||
+        e->in_dim > MAX_ACTIVATIONS || e->out_dim > MAX_ACTIVATIONS ||
+        biases + e->out_dim > MAX_BIASES ||
+        e->in_dim > CONFIG_ML_WEIGHT_STREAM_BUFFER_SIZE) {
+        return -ENOSPC;
+    }
+
+    l->offset = e->offset;
+    l->in_dim = e->in_dim;
+    l->out_dim = e->out_dim;
+    l->rows_per_chunk = (uint16_t)MIN(e->out_dim,
+        CONFIG_ML_WEIGHT_STREAM_BUFFER_SIZE / e->in_dim);
+    l->bias_index = (uint16_t)biases;
+    l->fc.in_dim = e->in_dim;
+    l->fc.input_offset = e->input_offset;
+    l->fc.output_zp = e->output_zp;
+    l->fc.multiplier = e->multiplier;
+    l->fc.shift = e->shift;
+    l->fc.act_min = e->act_min;
+    l->fc.act_max = e->act_max;
+    l->variant = fc_tuning_lookup(e->in_dim, e->out_dim);
+
+    return 0;
+}
+
+/**
+ * @brief Load the layer table and biases of the image in the partition
+ *
+ * The header, the layer chain and the payload CRC are all checked
+ * before the current layers are replaced.
+ *
+ * @return 0, -ENOENT if there is no image, -EINVAL if it is malformed,
+ *         -ENOSPC or -ENOTSUP if it does not suit this build, -EIO on a
+ *         CRC mismatch, or a flash error
+ */
+static int load_image(void)
+{
+    static struct layer staged[MAX_LAYERS];
+    struct image_header hdr;
+    struct image_layer entry;
+    uint32_t biases = 0;
+    uint32_t crc = 0;
+    int ret;
+
+    ret = flash_area_read(fa, 0, &hdr, sizeof(hdr));
+    if (ret != 0) {
+        return ret;
+    }
+    if (hdr.magic != IMAGE_MAGIC) {
+        return -ENOENT;
+    }
+
+    uint32_t table_end = sizeof(hdr) + hdr.layers * sizeof(entry);
+    uint32_t end = sizeof(hdr) + hdr.payload_bytes;
+
+    if (hdr.layers == 0 || hdr.layers > MAX_LAYERS ||
+        hdr.payload_bytes > fa->fa_size - sizeof(hdr) ||
+        hdr.bias_offset < table_end || hdr.bias_offset > end ||
+        hdr.bias_offset % IMAGE_ALIGN != 0) {
+        return -EINVAL;
+    }
+
+    for (uint32_t i = 0; i < hdr.layers; i++) {
+        ret = flash_area_read(fa, sizeof(hdr) + i * sizeof(entry), &entry,
+                              sizeof(entry));
+        if (ret != 0) {
+            return ret;
+        }
+
+        ret = load_layer(&entry, biases, &staged[i]);
+        if (ret != 0) {
+            LOG_WRN("Layer %u (%ux%u) exceeds the streaming buffers",
+                    i, entry.out_dim, entry.in_dim);
+            return ret;
+        }
+        if (entry.offset < table_end || entry.offset % IMAGE_ALIGN != 0 ||
+            entry.offset > hdr.bias_offset ||
+            layer_bytes(&staged[i]) > hdr.bias_offset - entry.offset ||
+            (i > 0 && entry.in_dim != staged[i - 1].out_dim)) {
+            return -EINVAL;
+        }
+        biases += entry.out_dim;
+    }
+
+    if (staged[0].in_dim != ML_INPUT_SIZE) {
+        return -ENOTSUP;
+    }
+    if (biases * sizeof(int32_t) > end - hdr.bias_offset) {
+        return -EINVAL;
+    }
+
+    for (uint32_t offset = sizeof(hdr); offset < end; ) {
+        uint32_t n = MIN(end - offset,
+                         (uint32_t)CONFIG_ML_WEIGHT_STREAM_BUFFER_SIZE);
+
+        ret = flash_area_read(fa, offset, chunk_buf[0], n);
+        if (ret != 0) {
+            return ret;
+        }
+        crc = crc32_ieee_update(crc, chunk_buf[0], n);
+        offset += n;
+    }
+    if (crc != hdr.payload_crc) {
+        return -EIO;
+    }
+
+    ret = flash_area_read(fa, hdr.bias_offset, bias_pool,
+                          biases * sizeof(int32_t));
+    if (ret != 0) {
+        return ret;
+    }
+
+    memcpy(layers, staged, hdr.layers * sizeof(staged[0]));
+    num_layers = (uint8_t)hdr.layers;
+    image_bytes = end;
+    output_scale = hdr.output_scale;
+
+    return 0;
+}
+
+#ifdef CONFIG_ML_WEIGHT_STREAM_PROVISION
+static bool int8_tensor(const tflite::Tensor *t)
+{
+    return t != nullptr && t->type() == tflite::TensorType_INT8 &&
+           t->quantization() != nullptr &&
+           t->quantization()->scale() != nullptr &&
+           t->quantization()->scale()->size() == 1 &&
+           t->quantization()->zero_point() != nullptr &&
+           t->quantization()->zero_point()->size() == 1;
+}
+
+static float tensor_scale(const tflite::Tensor *t)
+{
+    return t->quantization()->scale()->Get(0);
+}
+
+static int32_t tensor_zp(const tflite::Tensor *t)
+{
+    return (int32_t)t->quantization()->zero_point()->Get(0);
+}
+
+static const uint8_t *tensor_data(const tflite::Model *m,
+                                  const tflite::Tensor *t)
+{
+    const tflite::Buffer *buf = m->buffers()->Get(t->buffer());
+
+    return (buf != nullptr && buf->data() != nullptr) ?
+           buf->data()->data() : nullptr;
+}
+
+/**
+ * @brief Clamp range of a fused activation, as the TFLite kernels
+ *        compute it
+ */
+static void activation_range(tflite::ActivationFunctionType fn, float scale,
+                             int32_t zp, int32_t *act_min, int32_t *act_max)
+{
+    auto quantize = [scale, zp](float v) {
+        return zp + (int32_t)std::round(v / scale);
+    };
+
+    *act_min = INT8_MIN;
+    *act_max = INT8_MAX;
+
+    switch (fn) {
+    case tflite::ActivationFunctionType_RELU:
+        *act_min = MAX(*act_min, quantize(0.0f));
+        break;
+    case tflite::ActivationFunctionType_RELU6:
+        *act_min = MAX(*act_min, quantize(0.0f));
+        *act_max = MIN(*act_max, quantize(6.0f));
+        break;
+    case tflite::ActivationFunctionType_RELU_N1_TO_1:
+        *act_min = MAX(*act_min, quantize(-1.0f));
+        *act_max = MIN(*act_max, quantize(1.0f));
+        break;
+    default:
+        break;
+    }
+}
+
+/**
+ * @brief Extend a CRC over the 0xFF padding write_staged() puts after
+ *        len bytes
+ */
+static uint32_t crc_pad(uint32_t crc, uint32_t len)
+{
+    static const uint8_t pad[IMAGE_ALIGN] = {
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF
+    };
+
+    return crc32_ieee_update(crc, pad, align_up(len) - len);
+}
+
+/**
+ * @brief Build the image layout of the linked-in flatbuffer
+ *
+ * Fills model_hdr (but its CRC), model_table and the layers, so
+ * CONFIG_ML_FC_TUNE can run even if no image can be written.
+ */
+static int parse_model(const tflite::Model *m)
+{
+    if (m == nullptr || m->version() != TFLITE_SCHEMA_VERSION) {
+        return -EINVAL;
+    }
+
+    const auto *subgraphs = m->subgraphs();
+
+    if (subgraphs == nullptr || subgraphs->size() != 1) {
+        return -ENOTSUP;
+    }
+
+    const tflite::SubGraph *sg = subgraphs->Get(0);
+    const auto *tensors = sg->tensors();
+    const auto *ops = sg->operators();
+    int32_t current = sg->inputs()->Get(0);
+    uint32_t offset = 0;
+    uint32_t biases = 0;
+    float scale = 0.0f;
+
+    num_layers = 0;
+
+    for (uint32_t i = 0; i < ops->size(); i++) {
+        const tflite::Operator *op = ops->Get(i);
+        tflite::BuiltinOperator code =
+            tflite::GetBuiltinCode(m->operator_codes()->Get(op->opcode_index()));
+
+        if (op->inputs()->Get(0) != current) {
+            LOG_WRN("Operator %u is not on the layer chain", i);
+            return -ENOTSUP;
+        }
+
+        if (code == tflite::BuiltinOperator_RESHAPE) {
+            current = op->outputs()->Get(0);
+            continue;
+        }
+        if (code == tflite::BuiltinOperator_SOFTMAX && i == ops->size() - 1) {
+            /* Scores are normalized in float by the caller */
+            continue;
+        }
+        if (code != tflite::BuiltinOperator_FULLY_CONNECTED) {
+            LOG_WRN("Operator %u (%s) cannot be streamed", i,
+                    tflite::EnumNameBuiltinOperator(code));
+            return -ENOTSUP;
+        }
+        if (num_layers == MAX_LAYERS) {
+            return -ENOSPC;
+        }
+
+        const auto *options = op->builtin_options_as_FullyConnectedOptions();
+        const tflite::Tensor *in = tensors->Get(op->inputs()->Get(0));
+        const tflite::Tensor *w = tensors->Get(op->inputs()->Get(1));
+        int32_t bias_idx = op->inputs()->size() > 2 ? op->inputs()->Get(2) : -1;
+        const tflite::Tensor *bias = bias_idx >= 0 ? tensors->Get(bias_idx) : nullptr;
+        const tflite::Tensor *out = tensors->Get(op->outputs()->Get(0));
+
+        if (options == nullptr ||
+            options->weights_format() !=
+                tflite::FullyConnectedOptionsWeightsFormat_DEFAULT ||
+            !int8_tensor(in) || !int8_tensor(w) || !int8_tensor(out) ||
+            tensor_zp(w) != 0 || w->shape() == nullptr ||
+            w->shape()->size() != 2 || tensor_data(m, w) == nullptr ||
+            (bias != nullptr && bias->type() != tflite::TensorType_INT32)) {
+            LOG_WRN("Layer %u: unsupported weights or quantization", num_layers);
+            return -ENOTSUP;
+        }
+
+        struct image_layer *e = &model_table[num_layers];
+        uint32_t out_dim = w->shape()->Get(0);
+        uint32_t in_dim = w->shape()->Get(1);
+
+        if (in_dim > MAX_ACTIVATIONS || out_dim > MAX_ACTIVATIONS) {
+            LOG_WRN("Layer %u (%ux%u) exceeds the streaming buffers",
+                    num_layers, out_dim, in_dim);
+            return -ENOSPC;
+        }
+        if (num_layers > 0 && in_dim != layers[num_layers - 1].out_dim) {
+            return -ENOTSUP;
+        }
+
+        double real_multiplier =
+            (double)(tensor_scale(in) * tensor_scale(w)) /
+            (double)tensor_scale(out);
+        int shift;
+
+        e->offset = offset;
+        e->in_dim = (uint16_t)in_dim;
+        e->out_dim = (uint16_t)out_dim;
+        e->input_offset = -tensor_zp(in);
+        e->output_zp = tensor_zp(out);
+        tflite::QuantizeMultiplier(real_multiplier, &e->multiplier, &shift);
+        e->shift = shift;
+        activation_range(options->fused_activation_function(),
+                         tensor_scale(out), tensor_zp(out),
+                         &e->act_min, &e->act_max);
+
+        int ret = load_layer(e, biases, &layers[num_layers]);
+        if (ret != 0) {
+            LOG_WRN("Layer %u (%ux%u) exceeds the streaming buffers",
+                    num_layers, out_dim, in_dim);
+            return ret;
+        }
+
+        src_weights[num_layers] = (const int8_t *)tensor_data(m, w);
+        src_bias[num_layers] = bias != nullptr ?
+                               (const int32_t *)tensor_data(m, bias) : nullptr;
+
+        scale = tensor_scale(out);
+        offset += align_up(out_dim * in_dim);
+        biases += out_dim;
+        current = op->outputs()->Get(0);
+        num_layers++;
+    }
+
+    if (num_layers == 0 || layers[0].in_dim != ML_INPUT_SIZE) {
+        return -ENOTSUP;
+    }
+
+    /* Weights follow the layer table, now that its length is known */
+    uint32_t weights_start = sizeof(struct image_header) +
+                             num_layers * sizeof(struct image_layer);
+
+    for (uint8_t i = 0; i < num_layers; i++) {
+        model_table[i].offset += weights_start;
+        layers[i].offset += weights_start;
+    }
+
+    model_hdr.magic = IMAGE_MAGIC;
+    model_hdr.layers = num_layers;
+    model_hdr.bias_offset = weights_start + offset;
+    model_hdr.payload_bytes = model_hdr.bias_offset +
+                              align_up(biases * sizeof(int32_t)) -
+                              (uint32_t)sizeof(struct image_header);
+    model_hdr.output_scale = scale;
+    return 0;
+}
+
+/**
+ * @brief CRC of the image payload as it would be written
+ */
+static uint32_t source_crc(void)
+{
+    uint32_t crc = crc32_ieee_update(0, (const uint8_t *)model_table,
+                                     num_layers * sizeof(model_table[0]));
+    uint32_t biases = 0;
+
+    for (uint8_t i = 0; i < num_layers; i++) {
+        crc = crc32_ieee_update(crc, (const uint8_t *)src_weights[i],
+                                layer_bytes(&layers[i]));
+        crc = crc_pad(crc, layer_bytes(&layers[i]));
+    }
+    for (uint8_t i = 0; i < num_layers; i++) {
+        for (uint16_t r = 0; r < layers[i].out_dim; r++) {
+            int32_t b = src_bias[i] != nullptr ? src_bias[i][r] : 0;
+
+            crc = crc32_ieee_update(crc, (const uint8_t *)&b, sizeof(b));
+        }
+        biases += layers[i].out_dim;
+    }
+
+    return crc_pad(crc, biases * sizeof(int32_t));
+}
+
+/**
+ * @brief Write bytes at an aligned offset, padding the tail with 0xFF
+ *
+ * Staged through chunk_buf[0] so the source may be memory the flash
+ * driver cannot write from.
+ */
+static int write_staged(uint32_t offset, const void *src, uint32_t len)
+{
+    const uint8_t *p = (const uint8_t *)src;
+
+    while (len > 0) {
+        uint32_t n = MIN(len, (uint32_t)CONFIG_ML_WEIGHT_STREAM_BUFFER_SIZE);
+        uint32_t padded = align_up(n);
+
+        memcpy(chunk_buf[0], p, n);
+        memset(chunk_buf[0] + n, 0xFF, padded - n);
+
+        int ret = flash_area_write(fa, offset, chunk_buf[0], padded);
+        if (ret != 0) {
+            return ret;
+        }
+
+        offset += padded;
+        p += n;
+        len -= n;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Write the image of the linked-in model
+ */
+static int provision(void)
+{
+    uint32_t biases = 0;
+    int ret;
+
+    LOG_INF("Writing %u byte weight image to flash",
+            (uint32_t)sizeof(model_hdr) + model_hdr.payload_bytes);
+
+    ret = flash_area_erase(fa, 0, fa->fa_size);
+    if (ret != 0) {
+        return ret;
+    }
+
+    ret = write_staged(sizeof(model_hdr), model_table,
+                       num_layers * sizeof(model_table[0]));
+    if (ret != 0) {
+        return ret;
+    }
+
+    for (uint8_t i = 0; i < num_layers; i++) {
+        ret = write_staged(layers[i].offset, src_weights[i],
+                           layer_bytes(&layers[i]));
+        if (ret != 0) {
+            return ret;
+        }
+    }
+
+    /* Biases, one layer at a time (layer output counts fit the buffer) */
+    for (uint8_t i = 0; i < num_layers; i++) {
+        for (uint16_t r = 0; r < layers[i].out_dim; r++) {
+            bias_pool[biases++] = src_bias[i] != nullptr ? src_bias[i][r] : 0;
+        }
+    }
+    ret = write_staged(model_hdr.bias_offset, bias_pool,
+                       biases * sizeof(int32_t));
+    if (ret != 0) {
+        return ret;
+    }
+
+    /* Header last, so an interrupted write is never mistaken for an image */
+    return write_staged(0, &model_hdr, sizeof(model_hdr));
+}
+
+/**
+ * @brief Write the linked-in model's image unless the partition has it
+ */
+static int provision_if_changed(void)
+{
+    struct image_header hdr;
+    int ret;
+
+    if (sizeof(model_hdr) + model_hdr.payload_bytes > fa->fa_size) {
+        LOG_ERR("Weight image (%u bytes) exceeds partition (%u bytes)",
+                (uint32_t)sizeof(model_hdr) + model_hdr.payload_bytes,
+                (uint32_t)fa->fa_size);
+        return -ENOSPC;
+    }
+
+    model_hdr.payload_crc = source_crc();
+
+    ret = flash_area_read(fa, 0, &hdr, sizeof(hdr));
+    if (ret != 0) {
+        return ret;
+    }
+    if (memcmp(&hdr, &model_hdr, sizeof(hdr)) == 0) {
+        return 0;
+    }
+
+    ret = provision();
+    if (ret != 0) {
+        LOG_ERR("Writing weight image failed: %d", ret);
+    }
+    return ret;
+}
+#endif /* CONFIG_ML_WEIGHT_STREAM_PROVISION */
+
+static void record_read(uint32_t start_cyc)
+{
+    run_read_cyc += k_cycle_get_32() - start_cyc;
+}
+
+#ifdef CONFIG_ML_WEIGHT_STREAM_PREFETCH
+/**
+ * @brief Prefetch thread: read requested chunks in order
+ */
+static void prefetch_fn(void *p1, void *p2, void *p3)
+{
+    ARG_UNUSED(p1);
+    ARG_UNUSED(p2);
+    ARG_UNUSED(p3);
+
+    struct chunk_req req;
+
+    for (;;) {
+        k_msgq_get(&req_msgq, &req, K_FOREVER);
+
+        uint32_t t0 = k_cycle_get_32();
+
+        slot_status[req.slot] = flash_area_read(fa, req.offset,
+                                                chunk_buf[req.slot], req.len);
+        record_read(t0);
+        k_sem_give(&ready_sem[req.slot]);
+    }
+}
+#endif
+
+/**
+ * @brief Start fetching a chunk into a buffer half
+ *
+ * With prefetch the request goes to the prefetch thread; without, the
+ * read happens in fetch_wait() on the compute side.
+ */
+static void fetch_start(const struct chunk_req *req)
+{
+#ifdef CONFIG_ML_WEIGHT_STREAM_PREFETCH
+    (void)k_msgq_put(&req_msgq, req, K_FOREVER);
+#else
+    ARG_UNUSED(req);
+#endif
+}
+
+/**
+ * @brief Wait until a chunk is in its buffer half
+ *
+ * @param[in,out] stall_cyc Accumulated wait
+ * @return Flash read result
+ */
+static int fetch_wait(const struct chunk_req *req, uint32_t *stall_cyc)
+{
+    uint32_t t0 = k_cycle_get_32();
+
+#ifdef CONFIG_ML_WEIGHT_STREAM_PREFETCH
+    k_sem_take(&ready_sem[req->slot], K_FOREVER);
+#else
+    slot_status[req->slot] = flash_area_read(fa, req->offset,
+                                             chunk_buf[req->slot], req->len);
+    record_read(t0);
+#endif
+
+    *stall_cyc += k_cycle_get_32() - t0;
+    return slot_status[req->slot];
+}
+
+/**
+ * @brief Describe the chunk at a cursor and advance it
+ *
+ * @return Rows in the chunk, 0 past the last layer
+ */
+static uint16_t next_chunk(struct cursor *c, uint32_t slot,
+                           struct chunk_req *req)
+{
+    if (c->layer >= num_layers) {
+        return 0;
+    }
+
+    const struct layer *l = &layers[c->layer];
+    uint16_t rows = MIN(l->rows_per_chunk, (uint16_t)(l->out_dim - c->row));
+
+    req->offset = l->offset + (uint32_t)c->row * l->in_dim;
+    req->len = (uint32_t)rows * l->in_dim;
+    req->slot = slot;
+
+    c->row += rows;
+    if (c->row == l->out_dim) {
+        c->layer++;
+        c->row = 0;
+    }
+
+    return rows;
+}
+
+/* ============================================================================
+ * Public API Implementation
+ * ============================================================================ */
+
+int weight_stream_init(void)
+{
+    int ret;
+
+#ifdef CONFIG_ML_WEIGHT_STREAM_PROVISION
+    ret = parse_model(tflite::GetModel(gesture_model_data));
+    if (ret != 0) {
+        return ret;
+    }
+#endif
+
+    ret = flash_area_open(WEIGHTS_PARTITION_ID, &fa);
+    if (ret != 0) {
+        LOG_ERR("Cannot open weights partition: %d", ret);
+        return ret;
+    }
+    if (IMAGE_ALIGN % flash_area_align(fa) != 0) {
+        return -ENOTSUP;
+    }
+
+#ifdef CONFIG_ML_WEIGHT_STREAM_PROVISION
+    ret = provision_if_changed();
+    if (ret != 0) {
+        return ret;
+    }
+#endif
+
+    ret = load_image();
+    if (ret != 0) {
+        LOG_ERR("No valid weight image in the partition: %d", ret);
+        return ret;
+    }
+
+    k_sem_init(&ready_sem[0], 0, 1);
+    k_sem_init(&ready_sem[1], 0, 1);
+
+#ifdef CONFIG_ML_WEIGHT_STREAM_PREFETCH
+    k_thread_create(&prefetch_thread, prefetch_stack,
+                    K_THREAD_STACK_SIZEOF(prefetch_stack),
+                    prefetch_fn, nullptr, nullptr, nullptr,
+                    CONFIG_ML_WEIGHT_STREAM_PRIORITY, 0, K_NO_WAIT);
+    k_thread_name_set(&prefetch_thread, "wstream");
+    memmap_add_thread("stack_wstream", &prefetch_thread);
+#endif
+
+    memmap_add("wstream_buffers", sizeof(chunk_buf), sizeof(chunk_buf));
+    memmap_add("wstream_acts", sizeof(act) + sizeof(bias_pool),
+               MEMMAP_USED_UNKNOWN);
+
+    k_spinlock_key_t key = k_spin_lock(&stats_lock);
+    stats = {};
+    stats.layers = num_layers;
+    stats.image_bytes = image_bytes;
+    k_spin_unlock(&stats_lock, key);
+
+    for (uint8_t i = 0; i < num_layers; i++) {
+        LOG_INF("  Layer %u: %ux%u, %u rows per chunk, %s kernel", i,
+                layers[i].out_dim, layers[i].in_dim, layers[i].rows_per_chunk,
+                fc_variant_name(layers[i].variant));
+    }
+    LOG_INF("Weight streaming ready: %u layers, %u byte image, 2x%d byte buffer%s",
+            num_layers, image_bytes, CONFIG_ML_WEIGHT_STREAM_BUFFER_SIZE,
+            IS_ENABLED(CONFIG_ML_WEIGHT_STREAM_PREFETCH) ? "" : " (no prefetch)");
+
+    stream_ready = true;
+    return 0;
+}
+
+int weight_stream_run(const int8_t *input, int8_t *output, size_t output_size)
+{
+    struct cursor issue = {};
+    struct cursor comp = {};
+    struct chunk_req req[2];
+    uint32_t stall_cyc = 0;
+    uint32_t compute_cyc = 0;
+    uint32_t chunks = 0;
+    uint64_t bytes = 0;
+    int cur = 0;
+    int ret = 0;
+
+    if (!stream_ready) {
+        return -ENODEV;
+    }
+    if (input == nullptr || output == nullptr ||
+        output_size < layers[num_layers - 1].out_dim) {
+        return -EINVAL;
+    }
+
+    k_mutex_lock(&run_mutex, K_FOREVER);
+
+    uint32_t start = k_cycle_get_32();
+
+    run_read_cyc = 0;
+    memcpy(act[0], input, layers[0].in_dim);
+
+    next_chunk(&issue, 0, &req[0]);
+    fetch_start(&req[0]);
+
+    for (uint32_t k = 0; comp.layer < num_layers; k++) {
+        uint32_t slot = k % 2;
+        struct chunk_req *next = &req[(k + 1) % 2];
+
+        /* Queue the following chunk; its buffer half was freed when
+         * chunk k-1 was computed */
+        if (next_chunk(&issue, (k + 1) % 2, next) > 0) {
+            fetch_start(next);
+        }
+
+        int status = fetch_wait(&req[slot], &stall_cyc);
+
+        if (status != 0 && ret == 0) {
+            ret = status;
+        }
+
+        const struct layer *l = &layers[comp.layer];
+        uint16_t row0 = comp.row;
+        struct chunk_req unused;
+        uint16_t rows = next_chunk(&comp, slot, &unused);
+
+        if (ret == 0) {
+            uint32_t t0 = k_cycle_get_32();
+
+            fc_kernel_run(l->variant, &l->fc, &bias_pool[l->bias_index + row0],
+                          (const int8_t *)chunk_buf[slot], rows,
+                          act[cur], act[cur ^ 1] + row0);
+            compute_cyc += k_cycle_get_32() - t0;
+        }
+
+        chunks++;
+        bytes += req[slot].len;
+
+        if (comp.row == 0) {
+            cur ^= 1;  /* Layer finished, its output is the next input */
+        }
+    }
+
+    uint32_t total_cyc = k_cycle_get_32() - start;
+
+    if (ret == 0) {
+        memcpy(output, act[cur], layers[num_layers - 1].out_dim);
+    }
+
+    k_spinlock_key_t key = k_spin_lock(&stats_lock);
+    stats.inferences++;
+    stats.chunks += chunks;
+    stats.bytes += bytes;
+    stats.read_us += k_cyc_to_us_floor32(run_read_cyc);
+    stats.stall_us += k_cyc_to_us_floor32(stall_cyc);
+    stats.compute_us += k_cyc_to_us_floor32(compute_cyc);
+    stats.total_us += k_cyc_to_us_floor32(total_cyc);
+    stats.overlap_permille = overlap_permille(stats.read_us, stats.compute_us,
+                                              stats.total_us);
+    k_spin_unlock(&stats_lock, key);
+
+    k_mutex_unlock(&run_mutex);
+
+    if (ret != 0) {
+        LOG_ERR("Weight read failed: %d", ret);
+    }
+    return ret;
+}
+
+#ifdef CONFIG_ML_FC_TUNE
+int weight_stream_autotune(fc_tune_result_t *results, size_t max_results)
+{
+    static int8_t tune_out[MAX_ACTIVATIONS];
+    size_t n = 0;
+
+    if (results == nullptr) {
+        return -EINVAL;
+    }
+    if (num_layers == 0) {
+        return -ENODEV;
+    }
+
+    k_mutex_lock(&run_mutex, K_FOREVER);
+
+    for (uint8_t i = 0; i < num_layers; i++) {
+        const struct layer *l = &layers[i];
+        int32_t *bias = &bias_pool[l->bias_index];
+
+        /* First chunk straight from the model, so tuning works without
+         * a weights partition. Biases are the same values init loads. */
+        for (uint16_t r = 0; r < l->rows_per_chunk; r++) {
+            bias[r] = src_bias[i] != nullptr ? src_bias[i][r] : 0;
+        }
+        for (uint16_t c = 0; c < l->in_dim; c++) {
+            act[0][c] = (int8_t)((c * 37U + i * 11U) & 0xFF);
+        }
+
+        fc_kernel_run(FC_VARIANT_REFERENCE, &l->fc, bias, src_weights[i],
+                      l->rows_per_chunk, act[0], act[1]);
+
+        for (int v = 0; v < FC_VARIANT_COUNT && n < max_results; v++) {
+            uint32_t best = UINT32_MAX;
+
+            for (int it = 0; it < CONFIG_ML_FC_TUNE_ITERATIONS; it++) {
+                unsigned int key = irq_lock();
+                uint32_t start = k_cycle_get_32();
+
+                fc_kernel_run((fc_variant_t)v, &l->fc, bias, src_weights[i],
+                              l->rows_per_chunk, act[0], tune_out);
+                uint32_t cycles = k_cycle_get_32() - start;
+
+                irq_unlock(key);
+                best = MIN(best, cycles);
+            }
+
+            fc_tune_result_t *res = &results[n++];
+
+            res->layer = i;
+            res->layers = num_layers;
+            res->in_dim = l->in_dim;
+            res->out_dim = l->out_dim;
+            res->rows = l->rows_per_chunk;
+            res->variant = (fc_variant_t)v;
+            res->cycles = best;
+            res->match = memcmp(tune_out, act[1], l->rows_per_chunk) == 0;
+
+            LOG_INF("Tune layer %u (%ux%u): %s %u cycles%s", i, l->out_dim,
+                    l->in_dim, fc_variant_name(res->variant), best,
+                    res->match ? "" : " MISMATCH");
+        }
+    }
+
+    k_mutex_unlock(&run_mutex);
+
+    return (int)n;
+}
+#endif
+
+void weight_stream_output_quant(float *scale, int32_t *zero_point)
+{
+    if (scale != nullptr) {
+        *scale = output_scale;
+    }
+    if (zero_point != nullptr) {
+        *zero_point = num_layers > 0 ? layers[num_layers - 1].fc.output_zp : 0;
+    }
+}
+
+void weight_stream_get_stats(weight_stream_stats_t *out)
+{
+    if (out == nullptr) {
+        return;
+    }
+
+    k_spinlock_key_t key = k_spin_lock(&stats_lock);
+    *out = stats;
+    k_spin_unlock(&stats_lock, key);
+}
+
+void weight_stream_stats_interval(const weight_stream_stats_t *now,
+                                  const weight_stream_stats_t *prev,
+                                  weight_stream_stats_t *out)
+{
+    if (now == nullptr || prev == nullptr || out == nullptr) {
+        return;
+    }
+
+    *out = *now;
+    out->inferences = now->inferences - prev->inferences;
+    out->chunks = now->chunks - prev->chunks;
+    out->bytes = now->bytes - prev->bytes;
+    out->read_us = now->read_us - prev->read_us;
+    out->stall_us = now->stall_us - prev->stall_us;
+    out->compute_us = now->compute_us - prev->compute_us;
+    out->total_us = now->total_us - prev->total_us;
+    out->overlap_permille = overlap_permille(out->read_us, out->compute_us,
+                                             out->total_us);
+}
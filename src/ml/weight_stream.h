@@ -0,0 +1,146 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Zephyr Edge AI Demo - Layer-wise Weight Streaming Backend
+ *
+ * Runs a fully-connected int8 model with its weights in a flash
+ * partition instead of memory-mapped from the image. Each layer is read
+ * in row chunks into one half of a small SRAM double buffer while the
+ * previous chunk is computed from the other half, so SRAM holds two
+ * chunks and the activations rather than the whole model. The image
+ * carries its own layer table, so the model need not be linked in.
+ */
+
+#ifndef WEIGHT_STREAM_H
+#define WEIGHT_STREAM_H
+
+#include "fc_kernels.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Streamed layers supported */
+#define WEIGHT_STREAM_MAX_LAYERS 8
+
+/**
+ * @brief Streaming statistics, cumulative since init
+ */
+typedef struct {
+    /** Inferences run */
+    uint32_t inferences;
+
+    /** Chunks read from flash */
+    uint32_t chunks;
+
+    /** Bytes read from flash */
+    uint64_t bytes;
+
+    /** Time spent in flash reads (us) */
+    uint64_t read_us;
+
+    /** Time the compute side waited for a chunk (us) */
+    uint64_t stall_us;
+
+    /** Time spent in the FC kernels (us) */
+    uint64_t compute_us;
+
+    /** Wall time of the streamed inferences (us) */
+    uint64_t total_us;
+
+    /**
+     * Share of read time hidden behind compute (permille):
+     * (read + compute - total) / read. Reads that ran inline, like a
+     * synchronous driver called from the higher-priority prefetch
+     * thread, add to the total and count as not overlapped.
+     */
+    uint32_t overlap_permille;
+
+    /** Streamed layers */
+    uint8_t layers;
+
+    /** Bytes in the flash image */
+    uint32_t image_bytes;
+} weight_stream_stats_t;
+
+/**
+ * @brief Prepare the streaming backend
+ *
+ * Loads the layer table, requantization parameters and biases of the
+ * image in the weights partition, checks its CRC and starts the
+ * prefetch thread. With CONFIG_ML_WEIGHT_STREAM_PROVISION the linked-in
+ * model is first checked to be a chain of int8 FULLY_CONNECTED layers
+ * (RESHAPE and a trailing SOFTMAX are skipped) and written to the
+ * partition unless its image is already there.
+ *
+ * @return 0 on success, -ENOENT if the partition holds no image,
+ *         -EINVAL if the image or model is malformed, -EIO on a CRC
+ *         mismatch, -ENOTSUP if the model has other operators or
+ *         quantization, -ENOSPC if it does not fit the partition or the
+ *         buffers, or a flash error
+ */
+int weight_stream_init(void);
+
+/**
+ * @brief Run the model on one input
+ *
+ * @param input Quantized input (model input size)
+ * @param[out] output Quantized output of the last layer (logits)
+ * @param output_size Size of output
+ * @return 0 on success, negative error code otherwise
+ */
+int weight_stream_run(const int8_t *input, int8_t *output, size_t output_size);
+
+/**
+ * @brief Quantization of the last layer's output
+ *
+ * @param[out] scale Output scale
+ * @param[out] zero_point Output zero point
+ */
+void weight_stream_output_quant(float *scale, int32_t *zero_point);
+
+#ifdef CONFIG_ML_FC_TUNE
+/**
+ * @brief Benchmark every FC kernel variant on every layer
+ *
+ * Times one chunk per layer (weights from the model, synthetic input)
+ * for CONFIG_ML_FC_TUNE_ITERATIONS runs per variant with interrupts
+ * locked and keeps the fastest. Works after weight_stream_init()
+ * parsed the model, even if the flash image could not be set up.
+ *
+ * @param[out] results Up to WEIGHT_STREAM_MAX_LAYERS * FC_VARIANT_COUNT
+ * @param max_results Capacity of results
+ * @return Number of results, -ENODEV if no model was parsed
+ */
+int weight_stream_autotune(fc_tune_result_t *results, size_t max_results);
+#endif
+
+/**
+ * @brief Get streaming statistics
+ *
+ * @param[out] stats Statistics
+ */
+void weight_stream_get_stats(weight_stream_stats_t *stats);
+
+/**
+ * @brief Statistics of the inferences between two snapshots
+ *
+ * Counters and times become the differences, and overlap_permille is
+ * recomputed over the interval.
+ *
+ * @param now Later snapshot from weight_stream_get_stats()
+ * @param prev Earlier snapshot
+ * @param[out] out Interval statistics
+ */
+void weight_stream_stats_interval(const weight_stream_stats_t *now,
+                                  const weight_stream_stats_t *prev,
+                                  weight_stream_stats_t *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* WEIGHT_STREAM_H */
@@ -0,0 +1,389 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Zephyr Edge AI Demo - Prioritized Output Queues
+ *
+ * Producers (ML result formatting, debug, heartbeat and error paths)
+ * only format and enqueue; the output thread is the single transmitter.
+ * Each class has its own fixed-depth queue and drop policy:
+ *   - drop oldest: a full queue overwrites its oldest line (telemetry
+ *     where the latest value matters)
+ *   - drop newest: a full queue rejects the new line (errors, where the
+ *     first report is usually the root cause)
+ *
+ * With strict priority an inference line waits at most for the line
+ * already being transmitted, regardless of debug volume.
+ */
+
+#include "output_queue.h"
+#include "memmap.h"
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <string.h>
+
+LOG_MODULE_REGISTER(output_queue, CONFIG_LOG_DEFAULT_LEVEL);
+
+/* ============================================================================
+ * Configuration
+ * ============================================================================ */
+
+#ifndef CONFIG_OUTPUT_QUEUE_DEPTH_INFERENCE
+#define CONFIG_OUTPUT_QUEUE_DEPTH_INFERENCE 8
+#endif
+
+#ifndef CONFIG_OUTPUT_QUEUE_DEPTH_ERROR
+#define CONFIG_OUTPUT_QUEUE_DEPTH_ERROR 4
+#endif
+
+#ifndef CONFIG_OUTPUT_QUEUE_DEPTH_HEARTBEAT
+#define CONFIG_OUTPUT_QUEUE_DEPTH_HEARTBEAT 2
+#endif
+
+#ifndef CONFIG_OUTPUT_QUEUE_DEPTH_DEBUG
+#define CONFIG_OUTPUT_QUEUE_DEPTH_DEBUG 4
+#endif
+
+#ifndef CONFIG_OUTPUT_QUEUE_WEIGHT_INFERENCE
+#define CONFIG_OUTPUT_QUEUE_WEIGHT_INFERENCE 8
+#endif
+
+#ifndef CONFIG_OUTPUT_QUEUE_WEIGHT_ERROR
+#define CONFIG_OUTPUT_QUEUE_WEIGHT_ERROR 4
+#endif
+
+#ifndef CONFIG_OUTPUT_QUEUE_WEIGHT_HEARTBEAT
+#define CONFIG_OUTPUT_QUEUE_WEIGHT_HEARTBEAT 1
+#endif
+
+#ifndef CONFIG_OUTPUT_QUEUE_WEIGHT_DEBUG
+#define CONFIG_OUTPUT_QUEUE_WEIGHT_DEBUG 1
+#endif
+
+#define TOTAL_DEPTH (CONFIG_OUTPUT_QUEUE_DEPTH_INFERENCE + \
+                     CONFIG_OUTPUT_QUEUE_DEPTH_ERROR +     \
+                     CONFIG_OUTPUT_QUEUE_DEPTH_HEARTBEAT + \
+                     CONFIG_OUTPUT_QUEUE_DEPTH_DEBUG)
+
+BUILD_ASSERT(OUTPUT_TYPE_ERROR < OUTPUT_CLASS_COUNT,
+             "output_type_t grew, update OUTPUT_CLASS_COUNT");
+
+/* ============================================================================
+ * Private Data
+ * ============================================================================ */
+
+/**
+ * @brief Queued output line
+ */
+struct queued_line {
+    /** Enqueue time (us) for latency tracking */
+    uint32_t enqueue_us;
+    /** Formatted line */
+    char text[OUTPUT_QUEUE_LINE_LEN];
+};
+
+/**
+ * @brief Per-class queue state
+ */
+struct class_queue {
+    /** First slot in the shared pool */
+    uint16_t base;
+    /** Number of slots */
+    uint16_t depth;
+    /** Oldest queued slot (relative to base) */
+    uint16_t head;
+    /** Queued lines */
+    uint16_t count;
+    /** Full queue overwrites the oldest line instead of rejecting */
+    bool drop_oldest;
+    /** Weighted round-robin share */
+    uint8_t weight;
+    /** Remaining weighted round-robin credits */
+    uint8_t credits;
+    output_queue_stats_t stats;
+};
+
+/** Line storage shared by all classes */
+static struct queued_line pool[TOTAL_DEPTH];
+
+/** Queues indexed by output_type_t */
+static struct class_queue queues[OUTPUT_CLASS_COUNT] = {
+    [OUTPUT_TYPE_INFERENCE] = {
+        .base = 0,
+        .depth = CONFIG_OUTPUT_QUEUE_DEPTH_INFERENCE,
+        .drop_oldest = IS_ENABLED(CONFIG_OUTPUT_QUEUE_DROP_OLDEST_INFERENCE),
+        .weight = CONFIG_OUTPUT_QUEUE_WEIGHT_INFERENCE,
+    },
+    [OUTPUT_TYPE_ERROR] = {
+        .base = CONFIG_OUTPUT_QUEUE_DEPTH_INFERENCE,
+        .depth = CONFIG_OUTPUT_QUEUE_DEPTH_ERROR,
+        .drop_oldest = IS_ENABLED(CONFIG_OUTPUT_QUEUE_DROP_OLDEST_ERROR),
+        .weight = CONFIG_OUTPUT_QUEUE_WEIGHT_ERROR,
+    },
+    [OUTPUT_TYPE_HEARTBEAT] = {
+        .base = CONFIG_OUTPUT_QUEUE_DEPTH_INFERENCE +
+                CONFIG_OUTPUT_QUEUE_DEPTH_ERROR,
+        .depth = CONFIG_OUTPUT_QUEUE_DEPTH_HEARTBEAT,
+        .drop_oldest = IS_ENABLED(CONFIG_OUTPUT_QUEUE_DROP_OLDEST_HEARTBEAT),
+        .weight = CONFIG_OUTPUT_QUEUE_WEIGHT_HEARTBEAT,
+    },
+    [OUTPUT_TYPE_DEBUG] = {
+        .base = CONFIG_OUTPUT_QUEUE_DEPTH_INFERENCE +
+                CONFIG_OUTPUT_QUEUE_DEPTH_ERROR +
+                CONFIG_OUTPUT_QUEUE_DEPTH_HEARTBEAT,
+        .depth = CONFIG_OUTPUT_QUEUE_DEPTH_DEBUG,
+        .drop_oldest = IS_ENABLED(CONFIG_OUTPUT_QUEUE_DROP_OLDEST_DEBUG),
+        .weight = CONFIG_OUTPUT_QUEUE_WEIGHT_DEBUG,
+    },
+};
+
+/** Classes from highest to lowest priority */
+static const output_type_t priority_order[OUTPUT_CLASS_COUNT] = {
+    OUTPUT_TYPE_INFERENCE,
+    OUTPUT_TYPE_ERROR,
+    OUTPUT_TYPE_HEARTBEAT,
+    OUTPUT_TYPE_DEBUG,
+};
+
+static bool active = false;
+
+static K_MUTEX_DEFINE(queue_mutex);
+
+/** Signals the transmitter that a line was queued */
+static K_SEM_DEFINE(queue_sem, 0, 1);
+
+/** Signalled when a line leaves a queue (see output_queue_push_wait()) */
+static K_CONDVAR_DEFINE(space_cv);
+
+/* ============================================================================
+ * Private Functions
+ * ============================================================================ */
+
+static uint32_t now_us(void)
+{
+    return (uint32_t)k_ticks_to_us_floor64(k_uptime_ticks());
+}
+
+#ifdef CONFIG_OUTPUT_QUEUE_SCHED_WEIGHTED
+/**
+ * @brief Pick a class by weighted round robin (caller holds queue_mutex)
+ *
+ * Each non-empty class may send up to its weight lines per round,
+ * visited in priority order. A new round starts when every non-empty
+ * class has used its credits.
+ */
+static struct class_queue *select_queue(void)
+{
+    for (int round = 0; round < 2; round++) {
+        for (int i = 0; i < OUTPUT_CLASS_COUNT; i++) {
+            struct class_queue *q = &queues[priority_order[i]];
+
+            if (q->count > 0 && q->credits > 0) {
+                q->credits--;
+                return q;
+            }
+        }
+
+        /* Start a new round */
+        for (int i = 0; i < OUTPUT_CLASS_COUNT; i++) {
+            queues[i].credits = queues[i].weight;
+        }
+    }
+
+    return NULL;
+}
+#else
+/**
+ * @brief Pick the highest priority non-empty class (caller holds mutex)
+ */
+static struct class_queue *select_queue(void)
+{
+    for (int i = 0; i < OUTPUT_CLASS_COUNT; i++) {
+        struct class_queue *q = &queues[priority_order[i]];
+
+        if (q->count > 0) {
+            return q;
+        }
+    }
+
+    return NULL;
+}
+#endif
+
+/* ============================================================================
+ * Public API Implementation
+ * ============================================================================ */
+
+void output_queue_init(void)
+{
+    k_mutex_lock(&queue_mutex, K_FOREVER);
+
+    for (int i = 0; i < OUTPUT_CLASS_COUNT; i++) {
+        queues[i].head = 0;
+        queues[i].count = 0;
+        queues[i].credits = queues[i].weight;
+        queues[i].stats = (output_queue_stats_t){0};
+    }
+    active = false;
+
+    k_mutex_unlock(&queue_mutex);
+
+    memmap_add("output_queues", sizeof(pool), MEMMAP_USED_UNKNOWN);
+
+#ifdef CONFIG_OUTPUT_QUEUE_SCHED_WEIGHTED
+    LOG_INF("Output queues: %d/%d/%d/%d lines, weighted %d/%d/%d/%d",
+            CONFIG_OUTPUT_QUEUE_DEPTH_INFERENCE, CONFIG_OUTPUT_QUEUE_DEPTH_ERROR,
+            CONFIG_OUTPUT_QUEUE_DEPTH_HEARTBEAT, CONFIG_OUTPUT_QUEUE_DEPTH_DEBUG,
+            CONFIG_OUTPUT_QUEUE_WEIGHT_INFERENCE, CONFIG_OUTPUT_QUEUE_WEIGHT_ERROR,
+            CONFIG_OUTPUT_QUEUE_WEIGHT_HEARTBEAT, CONFIG_OUTPUT_QUEUE_WEIGHT_DEBUG);
+#else
+    LOG_INF("Output queues: %d/%d/%d/%d lines, strict priority",
+            CONFIG_OUTPUT_QUEUE_DEPTH_INFERENCE, CONFIG_OUTPUT_QUEUE_DEPTH_ERROR,
+            CONFIG_OUTPUT_QUEUE_DEPTH_HEARTBEAT, CONFIG_OUTPUT_QUEUE_DEPTH_DEBUG);
+#endif
+}
+
+void output_queue_start(void)
+{
+    k_mutex_lock(&queue_mutex, K_FOREVER);
+    active = true;
+    k_mutex_unlock(&queue_mutex);
+}
+
+bool output_queue_is_active(void)
+{
+    return active;
+}
+
+/**
+ * @brief Add a line to a class queue (caller holds queue_mutex)
+ */
+static int enqueue_locked(struct class_queue *q, const char *line)
+{
+    if (q->count == q->depth) {
+        q->stats.dropped++;
+        if (!q->drop_oldest) {
+            return -ENOSPC;
+        }
+        /* Overwrite the oldest line */
+        q->head = (q->head + 1) % q->depth;
+        q->count--;
+    }
+
+    struct queued_line *slot = &pool[q->base + (q->head + q->count) % q->depth];
+
+    strncpy(slot->text, line, sizeof(slot->text) - 1);
+    slot->text[sizeof(slot->text) - 1] = '\0';
+    slot->enqueue_us = now_us();
+
+    q->count++;
+    q->stats.enqueued++;
+    if (q->count > q->stats.max_depth) {
+        q->stats.max_depth = q->count;
+    }
+
+    return 0;
+}
+
+int output_queue_push(output_type_t type, const char *line)
+{
+    if (line == NULL || (int)type >= OUTPUT_CLASS_COUNT) {
+        return -EINVAL;
+    }
+
+    k_mutex_lock(&queue_mutex, K_FOREVER);
+    int ret = enqueue_locked(&queues[type], line);
+    k_mutex_unlock(&queue_mutex);
+
+    if (ret == 0) {
+        k_sem_give(&queue_sem);
+    }
+
+    return ret;
+}
+
+int output_queue_push_wait(output_type_t type, const char *line,
+                           k_timeout_t timeout)
+{
+    if (line == NULL || (int)type >= OUTPUT_CLASS_COUNT) {
+        return -EINVAL;
+    }
+
+    struct class_queue *q = &queues[type];
+    k_timepoint_t deadline = sys_timepoint_calc(timeout);
+
+    k_mutex_lock(&queue_mutex, K_FOREVER);
+
+    while (q->count == q->depth) {
+        /* Wake the transmitter, then wait for it to take a line; other
+         * producers may refill the queue first, so every wait only gets
+         * what is left of the caller's timeout */
+        k_sem_give(&queue_sem);
+        if (k_condvar_wait(&space_cv, &queue_mutex,
+                           sys_timepoint_timeout(deadline)) != 0) {
+            break;  /* Timed out: the drop policy applies */
+        }
+    }
+
+    int ret = enqueue_locked(q, line);
+
+    k_mutex_unlock(&queue_mutex);
+
+    if (ret == 0) {
+        k_sem_give(&queue_sem);
+    }
+
+    return ret;
+}
+
+bool output_queue_pop(char *line, output_type_t *type)
+{
+    if (line == NULL) {
+        return false;
+    }
+
+    k_mutex_lock(&queue_mutex, K_FOREVER);
+
+    struct class_queue *q = select_queue();
+
+    if (q == NULL) {
+        k_mutex_unlock(&queue_mutex);
+        return false;
+    }
+
+    struct queued_line *slot = &pool[q->base + q->head];
+    uint32_t latency = now_us() - slot->enqueue_us;
+
+    memcpy(line, slot->text, OUTPUT_QUEUE_LINE_LEN);
+    q->head = (q->head + 1) % q->depth;
+    q->count--;
+    q->stats.sent++;
+    if (latency > q->stats.max_latency_us) {
+        q->stats.max_latency_us = latency;
+    }
+
+    if (type != NULL) {
+        *type = (output_type_t)(q - queues);
+    }
+
+    k_condvar_broadcast(&space_cv);
+    k_mutex_unlock(&queue_mutex);
+
+    return true;
+}
+
+void output_queue_wait(k_timeout_t timeout)
+{
+    (void)k_sem_take(&queue_sem, timeout);
+}
+
+void output_queue_get_stats(output_type_t type, output_queue_stats_t *stats)
+{
+    if (stats == NULL || (int)type >= OUTPUT_CLASS_COUNT) {
+        return;
+    }
+
+    k_mutex_lock(&queue_mutex, K_FOREVER);
+    *stats = queues[type].stats;
+    k_mutex_unlock(&queue_mutex);
+}
@@ -0,0 +1,130 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Zephyr Edge AI Demo - Prioritized Output Queues
+ *
+ * Per-class queues of formatted output lines, drained by a single
+ * transmitter (the output thread) so that a burst of debug telemetry
+ * cannot delay a gesture result.
+ */
+
+#ifndef OUTPUT_QUEUE_H
+#define OUTPUT_QUEUE_H
+
+#include "uart_protocol.h"
+#include <zephyr/kernel.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Number of output classes (one per output_type_t) */
+#define OUTPUT_CLASS_COUNT 4
+
+/** Longest queued line including terminator */
+#define OUTPUT_QUEUE_LINE_LEN 256
+
+/**
+ * @brief Per-class queue statistics
+ */
+typedef struct {
+    /** Lines accepted into the queue */
+    uint32_t enqueued;
+
+    /** Lines transmitted */
+    uint32_t sent;
+
+    /** Lines dropped by the class drop policy */
+    uint32_t dropped;
+
+    /** Highest queue depth seen */
+    uint32_t max_depth;
+
+    /** Longest enqueue-to-transmit latency (us) */
+    uint32_t max_latency_us;
+} output_queue_stats_t;
+
+/**
+ * @brief Initialize the queues
+ */
+void output_queue_init(void);
+
+/**
+ * @brief Mark the transmitter as running
+ *
+ * Until this is called, output_queue_is_active() returns false and
+ * callers write directly (startup banner, init errors).
+ */
+void output_queue_start(void);
+
+/**
+ * @brief Check whether lines should be queued
+ *
+ * @return true once the transmitter is running
+ */
+bool output_queue_is_active(void);
+
+/**
+ * @brief Queue a formatted line
+ *
+ * Never blocks. When the class queue is full the class drop policy
+ * decides whether the oldest queued line or the new line is dropped.
+ *
+ * @param type Message class
+ * @param line NUL-terminated line without newline
+ * @return 0 on success, -ENOSPC if the new line was dropped
+ */
+int output_queue_push(output_type_t type, const char *line);
+
+/**
+ * @brief Queue a formatted line, waiting for room
+ *
+ * For one-off bursts longer than the class queue (the memory map dump)
+ * that would otherwise overwrite their own first lines. Blocks until
+ * the transmitter has taken a line from the full queue; after the
+ * timeout the class drop policy applies as in output_queue_push().
+ * Not for use where the transmitter itself or an ISR is the caller.
+ *
+ * @param type Message class
+ * @param line NUL-terminated line without newline
+ * @param timeout Longest wait for room
+ * @return 0 on success, -ENOSPC if the new line was dropped
+ */
+int output_queue_push_wait(output_type_t type, const char *line,
+                           k_timeout_t timeout);
+
+/**
+ * @brief Take the next line to transmit
+ *
+ * Selects the class by strict priority (INFERENCE, ERROR, HEARTBEAT,
+ * DEBUG) or by weighted round robin, depending on Kconfig.
+ *
+ * @param[out] line Buffer of OUTPUT_QUEUE_LINE_LEN bytes
+ * @param[out] type Class of the returned line (may be NULL)
+ * @return true if a line was returned, false if all queues are empty
+ */
+bool output_queue_pop(char *line, output_type_t *type);
+
+/**
+ * @brief Wait until a line is queued or the timeout expires
+ *
+ * @param timeout Maximum time to wait
+ */
+void output_queue_wait(k_timeout_t timeout);
+
+/**
+ * @brief Get statistics for one class
+ *
+ * @param type Message class
+ * @param[out] stats Pointer to statistics structure
+ */
+void output_queue_get_stats(output_type_t type, output_queue_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OUTPUT_QUEUE_H */
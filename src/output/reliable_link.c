@@ -0,0 +1,323 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Zephyr Edge AI Demo - Reliable Telemetry Link
+ *
+ * Every JSON line gets a link sequence number and CRC16, and a copy of
+ * the encoded frame is kept in a retransmit window of the last
+ * CONFIG_OUTPUT_RELIABLE_WINDOW frames. The host acknowledges
+ * cumulatively and NACKs gaps; only the missing frames are resent.
+ *
+ * Host commands arrive on the console UART RX interrupt, which only
+ * collects lines into a message queue. Parsing and retransmission run
+ * in reliable_link_poll() from the output thread.
+ */
+
+#include "reliable_link.h"
+#include "memmap.h"
+
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/uart.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/crc.h>
+#include <zephyr/sys/printk.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+LOG_MODULE_REGISTER(reliable_link, CONFIG_LOG_DEFAULT_LEVEL);
+
+/* ============================================================================
+ * Configuration
+ * ============================================================================ */
+
+#ifndef CONFIG_OUTPUT_RELIABLE_WINDOW
+#define CONFIG_OUTPUT_RELIABLE_WINDOW 16
+#endif
+
+#ifndef CONFIG_OUTPUT_RELIABLE_RTO_MS
+#define CONFIG_OUTPUT_RELIABLE_RTO_MS 1000
+#endif
+
+/** Largest encoded frame: 256-byte line plus sequence and CRC fields */
+#define MAX_FRAME_LEN 320
+
+/** Longest host command line */
+#define MAX_CMD_LEN 32
+
+/** Host commands buffered between polls */
+#define CMD_QUEUE_DEPTH 8
+
+/* ============================================================================
+ * Private Data
+ * ============================================================================ */
+
+/**
+ * @brief Retransmit window slot
+ */
+struct frame_slot {
+    /** Link sequence number (0 = empty) */
+    uint32_t seq;
+    /** Encoded frame length */
+    uint16_t len;
+    /** Encoded frame, NUL-terminated, without newline */
+    char data[MAX_FRAME_LEN];
+};
+
+static struct frame_slot window[CONFIG_OUTPUT_RELIABLE_WINDOW];
+
+/** Frame being encoded; the slot keeps the old frame until it fits */
+static char encode_buf[MAX_FRAME_LEN];
+
+/** Sequence number of the next new frame */
+static uint32_t next_seq = 1;
+
+/** Time of the last ACK progress (or probe) */
+static int64_t last_progress_ms = 0;
+
+/** Set once the host has sent any command */
+static bool host_seen = false;
+
+static reliable_link_stats_t stats = {0};
+
+static K_MUTEX_DEFINE(link_mutex);
+
+K_MSGQ_DEFINE(cmd_msgq, MAX_CMD_LEN, CMD_QUEUE_DEPTH, 4);
+
+/** RX line assembly (ISR context only) */
+static char rx_line[MAX_CMD_LEN];
+static size_t rx_len = 0;
+
+static const struct device *const uart_dev =
+    DEVICE_DT_GET(DT_CHOSEN(zephyr_console));
+
+/* ============================================================================
+ * Private Functions
+ * ============================================================================ */
+
+/**
+ * @brief UART RX interrupt: collect host command lines
+ */
+static void uart_rx_isr(const struct device *dev, void *user_data)
+{
+    uint8_t c;
+
+    ARG_UNUSED(user_data);
+
+    while (uart_irq_update(dev) && uart_irq_rx_ready(dev)) {
+        while (uart_fifo_read(dev, &c, 1) == 1) {
+            if (c == '\n' || c == '\r') {
+                if (rx_len > 0) {
+                    rx_line[rx_len] = '\0';
+                    /* Drop the command if the queue is full; the host
+                     * will repeat it on its next ACK or NACK */
+                    (void)k_msgq_put(&cmd_msgq, rx_line, K_NO_WAIT);
+                    rx_len = 0;
+                }
+            } else if (rx_len < sizeof(rx_line) - 1) {
+                rx_line[rx_len++] = (char)c;
+            } else {
+                rx_len = 0;  /* Overlong line, discard */
+            }
+        }
+    }
+}
+
+/**
+ * @brief Get the window slot holding a sequence number
+ *
+ * Caller holds link_mutex.
+ *
+ * @return Slot pointer, or NULL if the frame was evicted or never sent
+ */
+static struct frame_slot *find_frame(uint32_t seq)
+{
+    struct frame_slot *slot = &window[seq % CONFIG_OUTPUT_RELIABLE_WINDOW];
+
+    return (seq != 0 && slot->seq == seq) ? slot : NULL;
+}
+
+/**
+ * @brief Resend one frame (caller holds link_mutex)
+ */
+static void retransmit(uint32_t seq)
+{
+    struct frame_slot *slot = find_frame(seq);
+
+    if (slot == NULL) {
+        stats.evicted++;
+        return;
+    }
+
+    printk("%s\n", slot->data);
+    stats.retransmits++;
+    stats.bytes_retransmitted += slot->len + 1;
+}
+
+/**
+ * @brief Handle one host command line (caller holds link_mutex)
+ */
+static void handle_command(const char *cmd)
+{
+    char *end;
+
+    host_seen = true;
+
+    if (strncmp(cmd, "ACK ", 4) == 0) {
+        uint32_t seq = strtoul(cmd + 4, &end, 10);
+
+        if (end == cmd + 4 || seq >= next_seq) {
+            stats.bad_commands++;
+            return;
+        }
+
+        stats.acks++;
+        if (seq > stats.acked_seq) {
+            stats.acked_seq = seq;
+            last_progress_ms = k_uptime_get();
+        }
+    } else if (strncmp(cmd, "NACK ", 5) == 0) {
+        uint32_t first = strtoul(cmd + 5, &end, 10);
+        uint32_t last = first;
+
+        if (end == cmd + 5) {
+            stats.bad_commands++;
+            return;
+        }
+        if (*end == '-') {
+            last = strtoul(end + 1, &end, 10);
+        }
+        if (first == 0 || last < first || last >= next_seq) {
+            stats.bad_commands++;
+            return;
+        }
+
+        stats.nacks++;
+
+        /* Never resend more than one window's worth per request */
+        if (last - first >= CONFIG_OUTPUT_RELIABLE_WINDOW) {
+            stats.evicted += (last - first + 1) - CONFIG_OUTPUT_RELIABLE_WINDOW;
+            first = last - CONFIG_OUTPUT_RELIABLE_WINDOW + 1;
+        }
+        for (uint32_t seq = first; seq <= last; seq++) {
+            retransmit(seq);
+        }
+    } else {
+        stats.bad_commands++;
+    }
+}
+
+/* ============================================================================
+ * Public API Implementation
+ * ============================================================================ */
+
+int reliable_link_init(void)
+{
+    k_mutex_lock(&link_mutex, K_FOREVER);
+    memset(window, 0, sizeof(window));
+    next_seq = 1;
+    host_seen = false;
+    last_progress_ms = k_uptime_get();
+    stats = (reliable_link_stats_t){0};
+    k_mutex_unlock(&link_mutex);
+
+    memmap_add("link_window", sizeof(window), MEMMAP_USED_UNKNOWN);
+
+    if (!device_is_ready(uart_dev)) {
+        LOG_ERR("Console UART not ready, link is transmit-only");
+        return -ENODEV;
+    }
+
+    uart_irq_callback_user_data_set(uart_dev, uart_rx_isr, NULL);
+    uart_irq_rx_enable(uart_dev);
+
+    LOG_INF("Reliable link: window %d frames, ACK timeout %d ms",
+            CONFIG_OUTPUT_RELIABLE_WINDOW, CONFIG_OUTPUT_RELIABLE_RTO_MS);
+    return 0;
+}
+
+void reliable_link_send(const char *line)
+{
+    size_t line_len = strlen(line);
+
+    if (line_len < 2 || line[0] != '{' || line[line_len - 1] != '}') {
+        /* Not a JSON object: pass through unframed */
+        printk("%s\n", line);
+        return;
+    }
+
+    k_mutex_lock(&link_mutex, K_FOREVER);
+
+    uint32_t seq = next_seq;
+
+    /* {"lseq":N,<fields without braces>  then  ,"crc":"XXXX"} */
+    int len = snprintf(encode_buf, sizeof(encode_buf), "{\"lseq\":%u,%.*s",
+                       seq, (int)(line_len - 2), line + 1);
+    if (len < 0 || len >= (int)sizeof(encode_buf) - 16) {
+        /* The slot still holds frame seq - WINDOW for retransmission */
+        LOG_WRN("Frame too long, sent unframed");
+        k_mutex_unlock(&link_mutex);
+        printk("%s\n", line);
+        return;
+    }
+
+    uint16_t crc = crc16_itu_t(0xFFFF, (const uint8_t *)encode_buf, len);
+
+    len += snprintf(encode_buf + len, sizeof(encode_buf) - len,
+                    ",\"crc\":\"%04X\"}", crc);
+
+    struct frame_slot *slot = &window[seq % CONFIG_OUTPUT_RELIABLE_WINDOW];
+
+    next_seq++;
+    memcpy(slot->data, encode_buf, len + 1);
+    slot->len = (uint16_t)len;
+    slot->seq = seq;
+
+    printk("%s\n", slot->data);
+    stats.frames_sent++;
+    stats.bytes_sent += len + 1;
+
+    k_mutex_unlock(&link_mutex);
+}
+
+void reliable_link_poll(void)
+{
+    char cmd[MAX_CMD_LEN];
+
+    k_mutex_lock(&link_mutex, K_FOREVER);
+
+    while (k_msgq_get(&cmd_msgq, cmd, K_NO_WAIT) == 0) {
+        handle_command(cmd);
+    }
+
+    /*
+     * Tail loss: the host only notices a gap when a later frame arrives.
+     * If ACKs stall with frames outstanding, probe with the oldest
+     * unacknowledged frame still in the window to elicit an ACK or NACK.
+     */
+    int64_t now = k_uptime_get();
+
+    if (host_seen && stats.acked_seq + 1 < next_seq &&
+        now - last_progress_ms >= CONFIG_OUTPUT_RELIABLE_RTO_MS) {
+        uint32_t oldest = (next_seq > CONFIG_OUTPUT_RELIABLE_WINDOW) ?
+                          next_seq - CONFIG_OUTPUT_RELIABLE_WINDOW : 1;
+        uint32_t probe = MAX(stats.acked_seq + 1, oldest);
+
+        retransmit(probe);
+        last_progress_ms = now;
+    }
+
+    k_mutex_unlock(&link_mutex);
+}
+
+void reliable_link_get_stats(reliable_link_stats_t *out)
+{
+    if (out == NULL) {
+        return;
+    }
+
+    k_mutex_lock(&link_mutex, K_FOREVER);
+    *out = stats;
+    k_mutex_unlock(&link_mutex);
+}
@@ -0,0 +1,95 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Zephyr Edge AI Demo - Reliable Telemetry Link
+ *
+ * Optional sequenced, checksummed framing for the JSON output stream
+ * with a retransmit window driven by host acknowledgements received
+ * over UART RX.
+ *
+ * Frame format (still a valid JSON object):
+ *   {"lseq":<n>,<original fields>,"crc":"<CRC16 hex>"}
+ *
+ * The CRC16-CCITT covers everything before ,"crc". Host commands, one
+ * per line:
+ *   ACK <n>        - all frames up to and including n were received
+ *   NACK <a>[-<b>] - resend frames a..b
+ */
+
+#ifndef RELIABLE_LINK_H
+#define RELIABLE_LINK_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Reliable link statistics
+ */
+typedef struct {
+    /** Frames sent for the first time */
+    uint32_t frames_sent;
+
+    /** Frames sent again in response to NACKs or ACK timeouts */
+    uint32_t retransmits;
+
+    /** ACK commands received */
+    uint32_t acks;
+
+    /** NACK commands received */
+    uint32_t nacks;
+
+    /** Requested frames already evicted from the retransmit window */
+    uint32_t evicted;
+
+    /** Unparseable host commands */
+    uint32_t bad_commands;
+
+    /** Highest cumulatively acknowledged sequence number */
+    uint32_t acked_seq;
+
+    /** Bytes sent for the first time */
+    uint32_t bytes_sent;
+
+    /** Bytes sent as retransmissions */
+    uint32_t bytes_retransmitted;
+} reliable_link_stats_t;
+
+/**
+ * @brief Initialize the link and enable UART RX for host commands
+ *
+ * @return 0 on success, negative error code otherwise
+ */
+int reliable_link_init(void);
+
+/**
+ * @brief Frame and transmit one JSON line
+ *
+ * Assigns the next link sequence number, stores the encoded frame in
+ * the retransmit window and writes it out. Thread-safe.
+ *
+ * @param line JSON object without trailing newline
+ */
+void reliable_link_send(const char *line);
+
+/**
+ * @brief Process pending host commands and retransmissions
+ *
+ * Call periodically from the output thread.
+ */
+void reliable_link_poll(void);
+
+/**
+ * @brief Get link statistics
+ *
+ * @param[out] stats Pointer to statistics structure
+ */
+void reliable_link_get_stats(reliable_link_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RELIABLE_LINK_H */
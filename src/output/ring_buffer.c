@@ -7,6 +7,8 @@
  */
 
 #include "ring_buffer.h"
+#include "lockstat.h"
+#include "memmap.h"
 
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
@@ -30,8 +32,9 @@ static inference_result_t buffer[CONFIG_OUTPUT_RING_BUFFER_SIZE];
 static size_t head = 0;
 static size_t tail = 0;
 static size_t count = 0;
+static uint32_t dropped = 0;
 
-static K_MUTEX_DEFINE(buffer_mutex);
+static LOCKSTAT_MUTEX_DEFINE(buffer_mutex);
 
 /* ============================================================================
  * Public API Implementation
@@ -39,16 +42,18 @@ static K_MUTEX_DEFINE(buffer_mutex);
 
 void result_buffer_init(void)
 {
-    k_mutex_lock(&buffer_mutex, K_FOREVER);
+    lockstat_mutex_lock(&buffer_mutex, K_FOREVER);
     
     head = 0;
     tail = 0;
     count = 0;
+    dropped = 0;
     memset(buffer, 0, sizeof(buffer));
     
     LOG_INF("Result buffer initialized (size: %d)", CONFIG_OUTPUT_RING_BUFFER_SIZE);
+    memmap_add("result_ring", sizeof(buffer), MEMMAP_USED_UNKNOWN);
     
-    k_mutex_unlock(&buffer_mutex);
+    lockstat_mutex_unlock(&buffer_mutex);
 }
 
 int result_buffer_push(const inference_result_t *result)
@@ -57,20 +62,21 @@ int result_buffer_push(const inference_result_t *result)
         return -EINVAL;
     }
     
-    k_mutex_lock(&buffer_mutex, K_FOREVER);
+    lockstat_mutex_lock(&buffer_mutex, K_FOREVER);
     
     if (count >= CONFIG_OUTPUT_RING_BUFFER_SIZE) {
         LOG_WRN("Result buffer full, dropping oldest");
         /* Overwrite oldest entry */
         tail = (tail + 1) % CONFIG_OUTPUT_RING_BUFFER_SIZE;
         count--;
+        dropped++;
     }
     
     buffer[head] = *result;
     head = (head + 1) % CONFIG_OUTPUT_RING_BUFFER_SIZE;
     count++;
     
-    k_mutex_unlock(&buffer_mutex);
+    lockstat_mutex_unlock(&buffer_mutex);
     
     return 0;
 }
@@ -81,10 +87,10 @@ int result_buffer_pop(inference_result_t *result)
         return -EINVAL;
     }
     
-    k_mutex_lock(&buffer_mutex, K_FOREVER);
+    lockstat_mutex_lock(&buffer_mutex, K_FOREVER);
     
     if (count == 0) {
-        k_mutex_unlock(&buffer_mutex);
+        lockstat_mutex_unlock(&buffer_mutex);
         return -EAGAIN;
     }
     
@@ -92,7 +98,7 @@ int result_buffer_pop(inference_result_t *result)
     tail = (tail + 1) % CONFIG_OUTPUT_RING_BUFFER_SIZE;
     count--;
     
-    k_mutex_unlock(&buffer_mutex);
+    lockstat_mutex_unlock(&buffer_mutex);
     
     return 0;
 }
@@ -101,9 +107,9 @@ bool result_buffer_empty(void)
 {
     bool empty;
     
-    k_mutex_lock(&buffer_mutex, K_FOREVER);
+    lockstat_mutex_lock(&buffer_mutex, K_FOREVER);
     empty = (count == 0);
-    k_mutex_unlock(&buffer_mutex);
+    lockstat_mutex_unlock(&buffer_mutex);
     
     return empty;
 }
@@ -112,9 +118,9 @@ bool result_buffer_full(void)
 {
     bool full;
     
-    k_mutex_lock(&buffer_mutex, K_FOREVER);
+    lockstat_mutex_lock(&buffer_mutex, K_FOREVER);
     full = (count >= CONFIG_OUTPUT_RING_BUFFER_SIZE);
-    k_mutex_unlock(&buffer_mutex);
+    lockstat_mutex_unlock(&buffer_mutex);
     
     return full;
 }
@@ -123,9 +129,20 @@ size_t result_buffer_count(void)
 {
     size_t cnt;
     
-    k_mutex_lock(&buffer_mutex, K_FOREVER);
+    lockstat_mutex_lock(&buffer_mutex, K_FOREVER);
     cnt = count;
-    k_mutex_unlock(&buffer_mutex);
+    lockstat_mutex_unlock(&buffer_mutex);
     
     return cnt;
 }
+
+uint32_t result_buffer_dropped(void)
+{
+    uint32_t drops;
+    
+    lockstat_mutex_lock(&buffer_mutex, K_FOREVER);
+    drops = dropped;
+    lockstat_mutex_unlock(&buffer_mutex);
+    
+    return drops;
+}
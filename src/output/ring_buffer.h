@@ -52,6 +52,11 @@ bool result_buffer_full(void);
  */
 size_t result_buffer_count(void);
 
+/**
+ * @brief Get number of results dropped because the buffer was full
+ */
+uint32_t result_buffer_dropped(void);
+
 #ifdef __cplusplus
 }
 #endif
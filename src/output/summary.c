@@ -0,0 +1,109 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Zephyr Edge AI Demo - Aggregated Summary Records
+ *
+ * Gesture counts, confidence and latency histograms and drop counters
+ * per CONFIG_OUTPUT_SUMMARY_INTERVAL_MS. Drop counters are cumulative in
+ * their modules; the summary reports the increase over the interval.
+ */
+
+#include "summary.h"
+#include "ring_buffer.h"
+#include "preprocessing.h"
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <string.h>
+
+LOG_MODULE_REGISTER(summary, CONFIG_LOG_DEFAULT_LEVEL);
+
+/* ============================================================================
+ * Configuration
+ * ============================================================================ */
+
+#ifndef CONFIG_OUTPUT_SUMMARY_INTERVAL_MS
+#define CONFIG_OUTPUT_SUMMARY_INTERVAL_MS 10000
+#endif
+
+/* ============================================================================
+ * Private Data
+ * ============================================================================ */
+
+static summary_t current;
+static int64_t interval_start_ms = 0;
+
+/** Cumulative drop counters at the start of the interval */
+static uint32_t windows_dropped_base = 0;
+static uint32_t results_dropped_base = 0;
+
+/* ============================================================================
+ * Private Functions
+ * ============================================================================ */
+
+/**
+ * @brief Clear the aggregates and start a new interval
+ */
+static void start_interval(void)
+{
+    memset(&current, 0, sizeof(current));
+    interval_start_ms = k_uptime_get();
+    windows_dropped_base = preprocessing_get_dropped_windows();
+    results_dropped_base = result_buffer_dropped();
+}
+
+/* ============================================================================
+ * Public API Implementation
+ * ============================================================================ */
+
+void summary_init(void)
+{
+    start_interval();
+    
+    LOG_INF("Summary records every %d ms", CONFIG_OUTPUT_SUMMARY_INTERVAL_MS);
+}
+
+void summary_record(const inference_result_t *result)
+{
+    if (result == NULL) {
+        return;
+    }
+    
+    current.inferences++;
+    
+    if ((int)result->gesture >= 0 && result->gesture < GESTURE_COUNT) {
+        current.gestures[result->gesture]++;
+    }
+    
+    int bin = (int)(result->confidence * SUMMARY_CONF_BINS);
+    
+    if (bin < 0) {
+        bin = 0;
+    } else if (bin >= SUMMARY_CONF_BINS) {
+        bin = SUMMARY_CONF_BINS - 1;  /* Confidence 1.0 */
+    }
+    current.confidence[bin]++;
+    
+    profile_hist_record(&current.latency, result->inference_time_us);
+}
+
+bool summary_due(void)
+{
+    return k_uptime_get() - interval_start_ms >= CONFIG_OUTPUT_SUMMARY_INTERVAL_MS;
+}
+
+void summary_take(summary_t *summary)
+{
+    if (summary == NULL) {
+        return;
+    }
+    
+    current.interval_ms = (uint32_t)(k_uptime_get() - interval_start_ms);
+    current.windows_dropped = preprocessing_get_dropped_windows() -
+                              windows_dropped_base;
+    current.results_dropped = result_buffer_dropped() - results_dropped_base;
+    
+    *summary = current;
+    
+    start_interval();
+}
@@ -0,0 +1,84 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Zephyr Edge AI Demo - Aggregated Summary Records
+ *
+ * Accumulates inference results over a fixed interval so that one
+ * compact summary record can replace the per-inference records on
+ * low-bandwidth links.
+ */
+
+#ifndef SUMMARY_H
+#define SUMMARY_H
+
+#include "inference.h"
+#include "timing.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Confidence histogram bins (0.1 wide) */
+#define SUMMARY_CONF_BINS 10
+
+/**
+ * @brief Aggregates for one summary interval
+ */
+typedef struct {
+    /** Actual interval length (ms) */
+    uint32_t interval_ms;
+    
+    /** Inference results in the interval */
+    uint32_t inferences;
+    
+    /** Results per gesture class */
+    uint32_t gestures[GESTURE_COUNT];
+    
+    /** Confidence histogram, bin i covers [i/10, (i+1)/10) */
+    uint32_t confidence[SUMMARY_CONF_BINS];
+    
+    /** Inference latency histogram (us) */
+    profile_hist_t latency;
+    
+    /** Windows dropped by preprocessing in the interval */
+    uint32_t windows_dropped;
+    
+    /** Results dropped by the result buffer in the interval */
+    uint32_t results_dropped;
+} summary_t;
+
+/**
+ * @brief Start the first summary interval
+ */
+void summary_init(void);
+
+/**
+ * @brief Add an inference result to the current interval
+ *
+ * Call from the output thread only.
+ *
+ * @param result Inference result
+ */
+void summary_record(const inference_result_t *result);
+
+/**
+ * @brief Check whether the current interval has elapsed
+ *
+ * @return true if a summary should be emitted
+ */
+bool summary_due(void);
+
+/**
+ * @brief Close the current interval and start the next one
+ *
+ * @param[out] summary Aggregates of the closed interval
+ */
+void summary_take(summary_t *summary);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SUMMARY_H */
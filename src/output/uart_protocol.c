@@ -9,6 +9,14 @@
 
 #include "uart_protocol.h"
 #include "ring_buffer.h"
+#include "preprocessing.h"
+#include "reliable_link.h"
+#include "output_queue.h"
+#include "summary.h"
+#include "lockstat.h"
+#include "memmap.h"
+#include "energy.h"
+#include "preprocess_kernels.h"
 
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
@@ -35,6 +43,11 @@ LOG_MODULE_REGISTER(uart_protocol, CONFIG_LOG_DEFAULT_LEVEL);
 static bool initialized = false;
 static uint32_t output_sequence = 0;
 
+#ifndef CONFIG_OUTPUT_RELIABLE_LINK
+/** Protocol bytes written to the UART */
+static atomic_t tx_bytes = ATOMIC_INIT(0);
+#endif
+
 /* ============================================================================
  * Private Functions
  * ============================================================================ */
@@ -47,14 +60,87 @@ static uint32_t get_timestamp_us(void)
     return (uint32_t)(k_uptime_get() * 1000);
 }
 
+#if defined(CONFIG_OUTPUT_SUMMARY) || defined(CONFIG_DEBUG_LOCKSTAT) || \
+    defined(CONFIG_DEBUG_SCHED_BENCH) || defined(CONFIG_DEBUG_SCHED_CHECK)
+/**
+ * @brief Append ,"key":[v0,v1,...] to a JSON buffer
+ *
+ * @return New buffer length (clamped to size on truncation)
+ */
+static int append_array(char *buf, int len, int size, const char *key,
+                        const uint32_t *values, int count)
+{
+    len += snprintf(buf + len, MAX(size - len, 0), ",\"%s\":[", key);
+    
+    for (int i = 0; i < count && len < size; i++) {
+        len += snprintf(buf + len, size - len, "%s%u",
+                        (i > 0) ? "," : "", values[i]);
+    }
+    
+    if (len < size) {
+        len += snprintf(buf + len, size - len, "]");
+    }
+    
+    return MIN(len, size);
+}
+#endif
+
 /**
- * @brief Output a line (adds newline)
+ * @brief Write a line to the UART (adds newline)
  */
-static void output_line(const char *line)
+static void transmit_line(const char *line)
 {
+#ifdef CONFIG_OUTPUT_RELIABLE_LINK
+    reliable_link_send(line);
+#else
     printk("%s\n", line);
+    atomic_add(&tx_bytes, strlen(line) + 1);
+#endif
+}
+
+/**
+ * @brief Output a line of the given class
+ *
+ * Queued for the output thread once it is running, written directly
+ * before that (banner, init errors).
+ */
+static void output_line(output_type_t type, const char *line)
+{
+#ifdef CONFIG_OUTPUT_PRIORITY_QUEUES
+    if (output_queue_is_active()) {
+        (void)output_queue_push(type, line);
+        return;
+    }
+#else
+    ARG_UNUSED(type);
+#endif
+    transmit_line(line);
 }
 
+#ifdef CONFIG_DEBUG_MEMMAP
+/** Longest wait for queue room per line of a one-off dump */
+#define DUMP_WAIT_MS 1000
+
+/**
+ * @brief Output one line of a burst longer than its class queue
+ *
+ * Waits for the output thread to make room instead of letting the
+ * burst overwrite its own first lines in a drop-oldest queue.
+ */
+static void output_line_wait(output_type_t type, const char *line)
+{
+#ifdef CONFIG_OUTPUT_PRIORITY_QUEUES
+    if (output_queue_is_active()) {
+        (void)output_queue_push_wait(type, line, K_MSEC(DUMP_WAIT_MS));
+        return;
+    }
+#else
+    ARG_UNUSED(type);
+#endif
+    transmit_line(line);
+}
+#endif
+
 /* ============================================================================
  * Public API Implementation
  * ============================================================================ */
@@ -66,6 +152,17 @@ int uart_protocol_init(void)
     }
     
     output_sequence = 0;
+    
+#ifdef CONFIG_OUTPUT_PRIORITY_QUEUES
+    output_queue_init();
+#endif
+    
+#ifdef CONFIG_OUTPUT_RELIABLE_LINK
+    if (reliable_link_init() != 0) {
+        LOG_WRN("Reliable link RX unavailable");
+    }
+#endif
+    
     initialized = true;
     
     LOG_INF("UART protocol initialized");
@@ -128,9 +225,48 @@ void uart_output_inference(const inference_result_t *result,
 #endif
     
     (void)len;  /* Suppress unused warning */
-    output_line(buf);
+    output_line(OUTPUT_TYPE_INFERENCE, buf);
 }
 
+#ifdef CONFIG_ML_TEMPORAL_DECODER
+void uart_output_event(const decoder_event_t *event)
+{
+    char buf[MAX_OUTPUT_LEN];
+    
+    if (!initialized || event == NULL) {
+        return;
+    }
+    
+#ifdef CONFIG_OUTPUT_JSON_FORMAT
+    snprintf(buf, sizeof(buf),
+        "{\"type\":\"event\","
+        "\"seq\":%u,"
+        "\"ts\":%u,"
+        "\"gesture\":\"%s\","
+        "\"conf\":%.3f,"
+        "\"frames\":%u,"
+        "\"start\":%u,"
+        "\"delay_us\":%u}",
+        event->sequence,
+        get_timestamp_us(),
+        ml_gesture_to_string(event->gesture),
+        (double)event->confidence,
+        event->frames,
+        event->start_us,
+        event->delay_us);
+#else
+    snprintf(buf, sizeof(buf),
+        "[E%u] EVENT: %s (conf=%.2f, %u frames)",
+        event->sequence,
+        ml_gesture_to_string(event->gesture),
+        (double)event->confidence,
+        event->frames);
+#endif
+    
+    output_line(OUTPUT_TYPE_INFERENCE, buf);
+}
+#endif
+
 void uart_output_debug(const debug_stats_t *stats)
 {
     char buf[MAX_OUTPUT_LEN];
@@ -148,14 +284,22 @@ void uart_output_debug(const debug_stats_t *stats)
         "\"heap_free\":%u,"
         "\"stack_used\":%u,"
         "\"stack_size\":%u,"
-        "\"cpu_usage\":%.1f}",
+        "\"cpu_usage\":%.1f,"
+        "\"win_drop\":%u,"
+        "\"res_drop\":%u,"
+        "\"windows\":%u,"
+        "\"rate_hz\":%u}",
         (uint32_t)(k_uptime_get() * 1000),
         stats->uptime_ms,
         stats->heap_used,
         stats->heap_free,
         stats->stack_used,
         stats->stack_size,
-        (double)stats->cpu_usage_percent);
+        (double)stats->cpu_usage_percent,
+        preprocessing_get_dropped_windows(),
+        result_buffer_dropped(),
+        preprocessing_get_emitted_windows(),
+        sensor_hal_get_rate());
 #else
     snprintf(buf, sizeof(buf),
         "[DEBUG] Heap: %u/%u, Stack: %u/%u, CPU: %.1f%%",
@@ -166,7 +310,7 @@ void uart_output_debug(const debug_stats_t *stats)
         (double)stats->cpu_usage_percent);
 #endif
     
-    output_line(buf);
+    output_line(OUTPUT_TYPE_DEBUG, buf);
 }
 
 void uart_output_heartbeat(void)
@@ -190,7 +334,7 @@ void uart_output_heartbeat(void)
         k_uptime_get());
 #endif
     
-    output_line(buf);
+    output_line(OUTPUT_TYPE_HEARTBEAT, buf);
 }
 
 void uart_output_error(int code, const char *message)
@@ -217,9 +361,622 @@ void uart_output_error(int code, const char *message)
         message ? message : "unknown");
 #endif
     
-    output_line(buf);
+    output_line(OUTPUT_TYPE_ERROR, buf);
 }
 
+void uart_protocol_poll(void)
+{
+#ifdef CONFIG_OUTPUT_PRIORITY_QUEUES
+    char line[OUTPUT_QUEUE_LINE_LEN];
+    
+    /* Single transmitter: drain queued lines in scheduling order */
+    while (output_queue_pop(line, NULL)) {
+        transmit_line(line);
+    }
+#endif
+    
+#ifdef CONFIG_OUTPUT_RELIABLE_LINK
+    reliable_link_poll();
+#endif
+}
+
+uint32_t uart_protocol_get_tx_bytes(void)
+{
+#ifdef CONFIG_OUTPUT_RELIABLE_LINK
+    reliable_link_stats_t stats;
+    
+    /* Framed bytes including retransmissions */
+    reliable_link_get_stats(&stats);
+    return stats.bytes_sent + stats.bytes_retransmitted;
+#else
+    return (uint32_t)atomic_get(&tx_bytes);
+#endif
+}
+
+#ifdef CONFIG_OUTPUT_RELIABLE_LINK
+void uart_output_link_stats(void)
+{
+    char buf[MAX_OUTPUT_LEN];
+    reliable_link_stats_t stats;
+    
+    if (!initialized) {
+        return;
+    }
+    
+    reliable_link_get_stats(&stats);
+    
+    /* Share of transmitted bytes that were first transmissions */
+    uint32_t total = stats.bytes_sent + stats.bytes_retransmitted;
+    double efficiency = (total > 0) ?
+                        100.0 * (double)stats.bytes_sent / (double)total : 100.0;
+    
+    snprintf(buf, sizeof(buf),
+        "{\"type\":\"link\","
+        "\"ts\":%u,"
+        "\"sent\":%u,"
+        "\"retx\":%u,"
+        "\"acks\":%u,"
+        "\"nacks\":%u,"
+        "\"evicted\":%u,"
+        "\"bad_cmd\":%u,"
+        "\"acked\":%u,"
+        "\"eff\":%.1f}",
+        get_timestamp_us(),
+        stats.frames_sent,
+        stats.retransmits,
+        stats.acks,
+        stats.nacks,
+        stats.evicted,
+        stats.bad_commands,
+        stats.acked_seq,
+        efficiency);
+    
+    output_line(OUTPUT_TYPE_DEBUG, buf);
+}
+#endif
+
+#ifdef CONFIG_OUTPUT_PRIORITY_QUEUES
+void uart_output_queue_stats(void)
+{
+    static const char *const names[OUTPUT_CLASS_COUNT] = {
+        [OUTPUT_TYPE_INFERENCE] = "inf",
+        [OUTPUT_TYPE_DEBUG] = "dbg",
+        [OUTPUT_TYPE_HEARTBEAT] = "hb",
+        [OUTPUT_TYPE_ERROR] = "err",
+    };
+    char buf[MAX_OUTPUT_LEN];
+    output_queue_stats_t stats;
+    int len;
+    
+    if (!initialized) {
+        return;
+    }
+    
+    /* Per class: [sent, dropped, max depth, max latency us] */
+    len = snprintf(buf, sizeof(buf), "{\"type\":\"outq\",\"ts\":%u",
+                   get_timestamp_us());
+    for (int i = 0; i < OUTPUT_CLASS_COUNT && len < (int)sizeof(buf); i++) {
+        output_queue_get_stats((output_type_t)i, &stats);
+        len += snprintf(buf + len, sizeof(buf) - len,
+                        ",\"%s\":[%u,%u,%u,%u]", names[i], stats.sent,
+                        stats.dropped, stats.max_depth, stats.max_latency_us);
+    }
+    if (len < (int)sizeof(buf) - 1) {
+        buf[len++] = '}';
+        buf[len] = '\0';
+    }
+    
+    output_line(OUTPUT_TYPE_DEBUG, buf);
+}
+#endif
+
+#ifdef CONFIG_DEBUG_LOCKSTAT
+void uart_output_lock_stats(void)
+{
+    char buf[MAX_OUTPUT_LEN];
+    lockstat_info_t info;
+    
+    if (!initialized) {
+        return;
+    }
+    
+    for (int i = 0; lockstat_get(i, &info); i++) {
+        /* Send only the occupied span of the wait histogram */
+        int lo = 0;
+        int hi = PROFILE_HIST_BUCKETS - 1;
+        
+        while (lo < hi && info.wait_us.bucket[lo] == 0) {
+            lo++;
+        }
+        while (hi > lo && info.wait_us.bucket[hi] == 0) {
+            hi--;
+        }
+        
+        int len = snprintf(buf, sizeof(buf),
+            "{\"type\":\"lock\","
+            "\"ts\":%u,"
+            "\"name\":\"%s\","
+            "\"acq\":%u,"
+            "\"cont\":%u,"
+            "\"tmo\":%u,"
+            "\"hold_max\":%u,"
+            "\"holder\":\"%s\","
+            "\"wait_lo\":%u,"
+            "\"wait_max\":%u",
+            get_timestamp_us(),
+            info.name,
+            info.acquisitions,
+            info.contended,
+            info.timeouts,
+            info.max_hold_us,
+            info.max_holder,
+            profile_hist_bucket_floor(lo),
+            info.wait_us.max);
+        len = append_array(buf, len, sizeof(buf), "wait",
+                           &info.wait_us.bucket[lo], hi - lo + 1);
+        len += snprintf(buf + len, MAX((int)sizeof(buf) - len, 0), "}");
+        
+        if (len >= (int)sizeof(buf)) {
+            LOG_WRN("Lock record for %s truncated", info.name);
+            continue;
+        }
+        
+        output_line(OUTPUT_TYPE_DEBUG, buf);
+    }
+}
+#endif
+
+#ifdef CONFIG_DEBUG_SCHED_CHECK
+void uart_output_sched(const sched_report_t *report)
+{
+    char buf[MAX_OUTPUT_LEN];
+    
+    if (!initialized || report == NULL) {
+        return;
+    }
+    
+#ifdef CONFIG_OUTPUT_JSON_FORMAT
+    uint32_t wcet[SCHED_TASK_COUNT];
+    uint32_t period[SCHED_TASK_COUNT];
+    uint32_t observed[SCHED_TASK_COUNT];
+    uint32_t overruns[SCHED_TASK_COUNT];
+    
+    for (int i = 0; i < SCHED_TASK_COUNT; i++) {
+        wcet[i] = report->task[i].wcet_us;
+        period[i] = report->task[i].period_us;
+        observed[i] = report->task[i].max_response_us;
+        overruns[i] = report->task[i].overruns;
+    }
+    
+    int len = snprintf(buf, sizeof(buf),
+        "{\"type\":\"sched\","
+        "\"ts\":%u,"
+        "\"u\":%u.%u,"
+        "\"ub\":%u.%u,"
+        "\"ok\":%s,"
+        "\"risk\":%s",
+        get_timestamp_us(),
+        report->util_permille / 10,
+        report->util_permille % 10,
+        report->bound_permille / 10,
+        report->bound_permille % 10,
+        report->schedulable ? "true" : "false",
+        report->at_risk ? "true" : "false");
+    len = append_array(buf, len, sizeof(buf), "t", period, SCHED_TASK_COUNT);
+    len = append_array(buf, len, sizeof(buf), "c", wcet, SCHED_TASK_COUNT);
+    
+    /* Analyzed response times, -1 where the recurrence exceeds the period */
+    if (len < (int)sizeof(buf)) {
+        len += snprintf(buf + len, sizeof(buf) - len, ",\"r\":[");
+    }
+    for (int i = 0; i < SCHED_TASK_COUNT && len < (int)sizeof(buf); i++) {
+        uint32_t r = report->task[i].rta_us;
+        
+        if (r == SCHED_CHECK_UNBOUNDED) {
+            len += snprintf(buf + len, sizeof(buf) - len, "%s-1",
+                            (i > 0) ? "," : "");
+        } else {
+            len += snprintf(buf + len, sizeof(buf) - len, "%s%u",
+                            (i > 0) ? "," : "", r);
+        }
+    }
+    if (len < (int)sizeof(buf)) {
+        len += snprintf(buf + len, sizeof(buf) - len, "]");
+    }
+    len = MIN(len, (int)sizeof(buf));
+    
+    len = append_array(buf, len, sizeof(buf), "obs", observed, SCHED_TASK_COUNT);
+    len = append_array(buf, len, sizeof(buf), "over", overruns, SCHED_TASK_COUNT);
+    len += snprintf(buf + len, MAX((int)sizeof(buf) - len, 0), "}");
+    
+    if (len >= (int)sizeof(buf)) {
+        LOG_WRN("Sched record truncated");
+        return;
+    }
+#else
+    snprintf(buf, sizeof(buf),
+        "[SCHED] U=%u.%u%% (bound %u.%u%%), %s",
+        report->util_permille / 10,
+        report->util_permille % 10,
+        report->bound_permille / 10,
+        report->bound_permille % 10,
+        !report->schedulable ? "NOT SCHEDULABLE" :
+        report->at_risk ? "at risk" : "ok");
+#endif
+    
+    output_line(OUTPUT_TYPE_DEBUG, buf);
+}
+#endif
+
+#ifdef CONFIG_DEBUG_ENERGY
+void uart_output_energy(const energy_stats_t *stats)
+{
+    char buf[MAX_OUTPUT_LEN];
+    
+    if (!initialized || stats == NULL) {
+        return;
+    }
+    
+#ifdef CONFIG_OUTPUT_JSON_FORMAT
+    snprintf(buf, sizeof(buf),
+        "{\"type\":\"energy\","
+        "\"ts\":%u,"
+        "\"dur_ms\":%u,"
+        "\"avg_uw\":%u,"
+        "\"uj_inf\":%u,"
+        "\"uj_ml\":%u,"
+        "\"active\":%u.%u,"
+        "\"n\":%u,"
+        "\"tx_bytes\":%u,"
+        "\"total_mj\":%u}",
+        get_timestamp_us(),
+        stats->interval_ms,
+        stats->avg_power_uw,
+        stats->uj_per_inference,
+        stats->ml_uj_per_inference,
+        stats->active_permille / 10,
+        stats->active_permille % 10,
+        stats->inferences,
+        stats->uart_tx_bytes,
+        stats->total_mj);
+#else
+    snprintf(buf, sizeof(buf),
+        "[ENERGY] %u uW avg, %u uJ/inference (ML %u uJ), CPU %u.%u%%",
+        stats->avg_power_uw,
+        stats->uj_per_inference,
+        stats->ml_uj_per_inference,
+        stats->active_permille / 10,
+        stats->active_permille % 10);
+#endif
+    
+    output_line(OUTPUT_TYPE_DEBUG, buf);
+}
+#endif
+
+#ifdef CONFIG_ML_WEIGHT_STREAM
+void uart_output_wstream(const weight_stream_stats_t *stats)
+{
+    char buf[MAX_OUTPUT_LEN];
+    
+    if (!initialized || stats == NULL || stats->inferences == 0) {
+        return;
+    }
+    
+    uint32_t n = stats->inferences;
+    
+#ifdef CONFIG_OUTPUT_JSON_FORMAT
+    snprintf(buf, sizeof(buf),
+        "{\"type\":\"wstream\","
+        "\"ts\":%u,"
+        "\"n\":%u,"
+        "\"layers\":%u,"
+        "\"image\":%u,"
+        "\"chunks\":%u,"
+        "\"bytes\":%u,"
+        "\"read_us\":%u,"
+        "\"stall_us\":%u,"
+        "\"compute_us\":%u,"
+        "\"total_us\":%u,"
+        "\"overlap\":%u.%u}",
+        get_timestamp_us(),
+        n,
+        stats->layers,
+        stats->image_bytes,
+        stats->chunks / n,
+        (uint32_t)(stats->bytes / n),
+        (uint32_t)(stats->read_us / n),
+        (uint32_t)(stats->stall_us / n),
+        (uint32_t)(stats->compute_us / n),
+        (uint32_t)(stats->total_us / n),
+        stats->overlap_permille / 10,
+        stats->overlap_permille % 10);
+#else
+    snprintf(buf, sizeof(buf),
+        "[WSTREAM] read %u us, stall %u us, compute %u us per inference, "
+        "overlap %u.%u%%",
+        (uint32_t)(stats->read_us / n),
+        (uint32_t)(stats->stall_us / n),
+        (uint32_t)(stats->compute_us / n),
+        stats->overlap_permille / 10,
+        stats->overlap_permille % 10);
+#endif
+    
+    output_line(OUTPUT_TYPE_DEBUG, buf);
+}
+#endif
+
+#ifdef CONFIG_ML_FC_TUNE
+void uart_output_fctune(const fc_tune_result_t *result)
+{
+    char buf[MAX_OUTPUT_LEN];
+    
+    if (!initialized || result == NULL) {
+        return;
+    }
+    
+#ifdef CONFIG_OUTPUT_JSON_FORMAT
+    snprintf(buf, sizeof(buf),
+        "{\"type\":\"fctune\","
+        "\"ts\":%u,"
+        "\"layer\":%u,"
+        "\"layers\":%u,"
+        "\"variants\":%d,"
+        "\"in\":%u,"
+        "\"out\":%u,"
+        "\"rows\":%u,"
+        "\"variant\":\"%s\","
+        "\"cycles\":%u,"
+        "\"match\":%d}",
+        get_timestamp_us(),
+        result->layer,
+        result->layers,
+        FC_VARIANT_COUNT,
+        result->in_dim,
+        result->out_dim,
+        result->rows,
+        fc_variant_name(result->variant),
+        result->cycles,
+        result->match ? 1 : 0);
+#else
+    snprintf(buf, sizeof(buf),
+        "[FCTUNE] layer %u/%u (%ux%u, %u rows): %s %u cycles%s",
+        result->layer + 1,
+        result->layers,
+        result->in_dim,
+        result->out_dim,
+        result->rows,
+        fc_variant_name(result->variant),
+        result->cycles,
+        result->match ? "" : ", MISMATCH");
+#endif
+    
+    output_line(OUTPUT_TYPE_DEBUG, buf);
+}
+#endif
+
+#ifdef CONFIG_DEBUG_PREPROC_BENCH
+void uart_output_preproc_bench(const preproc_bench_result_t *result)
+{
+    char buf[MAX_OUTPUT_LEN];
+    
+    if (!initialized || result == NULL) {
+        return;
+    }
+    
+#ifdef CONFIG_OUTPUT_JSON_FORMAT
+    snprintf(buf, sizeof(buf),
+        "{\"type\":\"ppbench\","
+        "\"ts\":%u,"
+        "\"win\":%u,"
+        "\"scheme\":\"%s\","
+        "\"spec\":%s,"
+        "\"gen_min\":%u,"
+        "\"gen_mean\":%u,"
+        "\"ker_min\":%u,"
+        "\"ker_mean\":%u,"
+        "\"diff\":%u}",
+        get_timestamp_us(),
+        result->window,
+        preprocess_kernel_scheme(),
+        result->specialized ? "true" : "false",
+        result->generic_min_cyc,
+        result->generic_mean_cyc,
+        result->kernel_min_cyc,
+        result->kernel_mean_cyc,
+        result->max_diff);
+#else
+    snprintf(buf, sizeof(buf),
+        "[PPBENCH] window %u, %s%s: generic %u/%u, kernel %u/%u cycles "
+        "(min/mean), max diff %u",
+        result->window,
+        preprocess_kernel_scheme(),
+        result->specialized ? "" : " (generic)",
+        result->generic_min_cyc,
+        result->generic_mean_cyc,
+        result->kernel_min_cyc,
+        result->kernel_mean_cyc,
+        result->max_diff);
+#endif
+    
+    output_line(OUTPUT_TYPE_DEBUG, buf);
+}
+#endif
+
+#ifdef CONFIG_DEBUG_MEMMAP
+void uart_output_memmap(void)
+{
+    char buf[MAX_OUTPUT_LEN];
+    memmap_image_t image;
+    memmap_region_t region;
+    int count = 0;
+    
+    if (!initialized) {
+        return;
+    }
+    
+    while (memmap_get(count, &region)) {
+        count++;
+    }
+    
+    memmap_get_image(&image);
+    
+    snprintf(buf, sizeof(buf),
+        "{\"type\":\"memmap\","
+        "\"ts\":%u,"
+        "\"board\":\"%s\","
+        "\"rom\":%u,"
+        "\"ram\":%u,"
+        "\"ram_size\":%u,"
+        "\"data\":%u,"
+        "\"bss\":%u,"
+        "\"noinit\":%u,"
+        "\"regions\":%d}",
+        get_timestamp_us(),
+        CONFIG_BOARD,
+        image.rom,
+        image.ram,
+        image.ram_size,
+        image.data,
+        image.bss,
+        image.noinit,
+        count);
+    output_line_wait(OUTPUT_TYPE_DEBUG, buf);
+    
+    for (int i = 0; memmap_get(i, &region); i++) {
+        if (region.used == MEMMAP_USED_UNKNOWN) {
+            snprintf(buf, sizeof(buf),
+                "{\"type\":\"mem\",\"name\":\"%s\",\"size\":%u}",
+                region.name, region.size);
+        } else {
+            snprintf(buf, sizeof(buf),
+                "{\"type\":\"mem\",\"name\":\"%s\",\"size\":%u,\"used\":%u}",
+                region.name, region.size, region.used);
+        }
+        output_line_wait(OUTPUT_TYPE_DEBUG, buf);
+    }
+}
+#endif
+
+#ifdef CONFIG_DEBUG_SCHED_BENCH
+void uart_output_bench(const sched_bench_result_t *result)
+{
+    char buf[MAX_OUTPUT_LEN];
+    
+    if (!initialized || result == NULL || result->samples == 0) {
+        return;
+    }
+    
+    /* Send only the occupied span of the histogram */
+    int lo = 0;
+    int hi = PROFILE_HIST_BUCKETS - 1;
+    
+    while (lo < hi && result->hist.bucket[lo] == 0) {
+        lo++;
+    }
+    while (hi > lo && result->hist.bucket[hi] == 0) {
+        hi--;
+    }
+    
+    int len = snprintf(buf, sizeof(buf),
+        "{\"type\":\"bench\","
+        "\"ts\":%u,"
+        "\"prim\":\"%s\","
+        "\"load\":\"%s\","
+        "\"n\":%u,"
+        "\"min_ns\":%u,"
+        "\"mean_ns\":%u,"
+        "\"max_ns\":%u,"
+        "\"lo_us\":%u",
+        get_timestamp_us(),
+        sched_bench_prim_name(result->prim),
+        result->loaded ? "loaded" : "idle",
+        result->samples,
+        result->min_ns,
+        (uint32_t)(result->total_ns / result->samples),
+        result->max_ns,
+        profile_hist_bucket_floor(lo));
+    len = append_array(buf, len, sizeof(buf), "hist",
+                       &result->hist.bucket[lo], hi - lo + 1);
+    len += snprintf(buf + len, MAX((int)sizeof(buf) - len, 0), "}");
+    
+    if (len >= (int)sizeof(buf)) {
+        LOG_WRN("Bench record truncated");
+        return;
+    }
+    
+    output_line(OUTPUT_TYPE_DEBUG, buf);
+}
+#endif
+
+#ifdef CONFIG_OUTPUT_SUMMARY
+void uart_output_summary(const summary_t *summary)
+{
+    char buf[MAX_OUTPUT_LEN];
+    int len;
+    
+    if (!initialized || summary == NULL) {
+        return;
+    }
+    
+#ifdef CONFIG_OUTPUT_JSON_FORMAT
+    /* Send only the occupied span of the latency histogram */
+    int lo = 0;
+    int hi = PROFILE_HIST_BUCKETS - 1;
+    
+    while (lo < hi && summary->latency.bucket[lo] == 0) {
+        lo++;
+    }
+    while (hi > lo && summary->latency.bucket[hi] == 0) {
+        hi--;
+    }
+    
+    len = snprintf(buf, sizeof(buf),
+        "{\"type\":\"summary\","
+        "\"ts\":%u,"
+        "\"dur_ms\":%u,"
+        "\"n\":%u",
+        get_timestamp_us(),
+        summary->interval_ms,
+        summary->inferences);
+    len = append_array(buf, len, sizeof(buf), "g",
+                       summary->gestures, GESTURE_COUNT);
+    len = append_array(buf, len, sizeof(buf), "conf",
+                       summary->confidence, SUMMARY_CONF_BINS);
+    len = append_array(buf, len, sizeof(buf), "lat",
+                       &summary->latency.bucket[lo], hi - lo + 1);
+    len += snprintf(buf + len, MAX((int)sizeof(buf) - len, 0),
+        ",\"lat_lo\":%u,"
+        "\"lat_max\":%u,"
+        "\"drop\":[%u,%u]}",
+        profile_hist_bucket_floor(lo),
+        summary->latency.max,
+        summary->windows_dropped,
+        summary->results_dropped);
+    
+    if (len >= (int)sizeof(buf)) {
+        LOG_WRN("Summary record truncated");
+        return;
+    }
+#else
+    len = snprintf(buf, sizeof(buf),
+        "[SUMMARY] %u ms: %u results (IDLE %u, WAVE %u, TAP %u, CIRCLE %u), "
+        "max lat=%uus, drops=%u/%u",
+        summary->interval_ms,
+        summary->inferences,
+        summary->gestures[GESTURE_IDLE],
+        summary->gestures[GESTURE_WAVE],
+        summary->gestures[GESTURE_TAP],
+        summary->gestures[GESTURE_CIRCLE],
+        summary->latency.max,
+        summary->windows_dropped,
+        summary->results_dropped);
+#endif
+    
+    (void)len;
+    output_line(OUTPUT_TYPE_INFERENCE, buf);
+}
+#endif
+
 void uart_output_banner(void)
 {
     char buf[MAX_OUTPUT_LEN];
@@ -240,7 +997,7 @@ void uart_output_banner(void)
         APP_VERSION,
         CONFIG_BOARD,
         get_timestamp_us());
-    output_line(buf);
+    output_line(OUTPUT_TYPE_DEBUG, buf);
 #endif
     
     LOG_INF("UART output initialized");
@@ -11,6 +11,13 @@
 
 #include "inference.h"
 #include "debug_monitor.h"
+#include "summary.h"
+#include "sched_bench.h"
+#include "preproc_bench.h"
+#include "energy.h"
+#include "sched_check.h"
+#include "temporal_decoder.h"
+#include "weight_stream.h"
 #include <stdbool.h>
 #include <stdint.h>
 
@@ -75,6 +82,15 @@ int uart_protocol_init(void);
 void uart_output_inference(const inference_result_t *result,
                            const debug_stats_t *debug);
 
+#ifdef CONFIG_ML_TEMPORAL_DECODER
+/**
+ * @brief Output a decoded gesture event
+ *
+ * @param event Event from the temporal decoder
+ */
+void uart_output_event(const decoder_event_t *event);
+#endif
+
 /**
  * @brief Output debug information
  *
@@ -97,6 +113,142 @@ void uart_output_heartbeat(void);
  */
 void uart_output_error(int code, const char *message);
 
+/**
+ * @brief Service the output link
+ *
+ * Transmits queued lines when the priority queues are enabled, then
+ * processes host commands and retransmissions when the reliable link is
+ * enabled. Call periodically from the output thread.
+ */
+void uart_protocol_poll(void);
+
+/**
+ * @brief Get the number of protocol bytes written to the UART
+ *
+ * Counts framed bytes including retransmissions when the reliable link
+ * is enabled. Zephyr log output is not included.
+ *
+ * @return Cumulative byte count
+ */
+uint32_t uart_protocol_get_tx_bytes(void);
+
+#ifdef CONFIG_OUTPUT_RELIABLE_LINK
+/**
+ * @brief Output reliable link statistics
+ *
+ * Frames sent, retransmits, ACK/NACK counts and link efficiency
+ * (first-transmission bytes as a share of all bytes sent).
+ */
+void uart_output_link_stats(void);
+#endif
+
+#ifdef CONFIG_OUTPUT_PRIORITY_QUEUES
+/**
+ * @brief Output priority queue statistics
+ *
+ * Per class: lines sent, lines dropped, highest depth and longest
+ * enqueue-to-transmit latency.
+ */
+void uart_output_queue_stats(void);
+#endif
+
+#ifdef CONFIG_DEBUG_LOCKSTAT
+/**
+ * @brief Output one contention record per instrumented mutex
+ *
+ * Acquisitions, contended acquisitions, timeouts, longest hold and its
+ * holder, and the occupied span of the log2 wait histogram starting at
+ * wait_lo us.
+ */
+void uart_output_lock_stats(void);
+#endif
+
+#ifdef CONFIG_DEBUG_SCHED_CHECK
+/**
+ * @brief Output a schedulability analysis
+ *
+ * Utilization and its Liu & Layland bound, then per-task arrays in
+ * sched_task_t order: period, observed WCET, analyzed response time
+ * (-1 if beyond the period), observed longest job and overrun count.
+ *
+ * @param report Analysis result
+ */
+void uart_output_sched(const sched_report_t *report);
+#endif
+
+#ifdef CONFIG_DEBUG_ENERGY
+/**
+ * @brief Output an energy estimate
+ *
+ * @param stats Estimate for one debug interval
+ */
+void uart_output_energy(const energy_stats_t *stats);
+#endif
+
+#ifdef CONFIG_ML_WEIGHT_STREAM
+/**
+ * @brief Output weight streaming statistics
+ *
+ * Flash read, compute-side stall and compute time are averaged per
+ * inference; overlap is the share of read time hidden by prefetch.
+ * Nothing is sent when no inference was streamed.
+ *
+ * @param stats Streaming statistics of one reporting interval (see
+ *              weight_stream_stats_interval())
+ */
+void uart_output_wstream(const weight_stream_stats_t *stats);
+#endif
+
+#ifdef CONFIG_ML_FC_TUNE
+/**
+ * @brief Output one FC kernel benchmark result
+ *
+ * @param result Cycles of one variant on one layer's chunk
+ */
+void uart_output_fctune(const fc_tune_result_t *result);
+#endif
+
+#ifdef CONFIG_DEBUG_MEMMAP
+/**
+ * @brief Output the memory map
+ *
+ * One "memmap" record with the image section sizes, then one "mem"
+ * record per registered region.
+ */
+void uart_output_memmap(void);
+#endif
+
+#ifdef CONFIG_DEBUG_SCHED_BENCH
+/**
+ * @brief Output one scheduling benchmark result
+ *
+ * @param result Result of one primitive
+ */
+void uart_output_bench(const sched_bench_result_t *result);
+#endif
+
+#ifdef CONFIG_DEBUG_PREPROC_BENCH
+/**
+ * @brief Output one preprocessing kernel benchmark result
+ *
+ * @param result Result for one window length
+ */
+void uart_output_preproc_bench(const preproc_bench_result_t *result);
+#endif
+
+#ifdef CONFIG_OUTPUT_SUMMARY
+/**
+ * @brief Output an aggregated summary record
+ *
+ * Gesture counts, confidence histogram (0.1 bins), the occupied span
+ * of the log2 latency histogram starting at lat_lo us, and drop counts
+ * for one summary interval.
+ *
+ * @param summary Aggregates of the closed interval
+ */
+void uart_output_summary(const summary_t *summary);
+#endif
+
 /**
  * @brief Output startup banner
  */
@@ -12,14 +12,21 @@
  *   - WAVE: Sinusoidal motion on X/Y axes
  *   - TAP:  Sharp impulse followed by decay
  *   - CIRCLE: Circular motion pattern
+ *
+ * Which pattern plays when is set by a scenario (see mock_accel.h):
+ * the built-in one selected in Kconfig, a script from Kconfig, or one
+ * installed at runtime.
  */
 
-#include "sensor_hal.h"
+#include "mock_accel.h"
 
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
-#include <zephyr/random/random.h>
+#include <ctype.h>
+#include <errno.h>
 #include <math.h>
+#include <stdlib.h>
+#include <string.h>
 
 LOG_MODULE_REGISTER(mock_accel, CONFIG_LOG_DEFAULT_LEVEL);
 
@@ -35,6 +42,14 @@ LOG_MODULE_REGISTER(mock_accel, CONFIG_LOG_DEFAULT_LEVEL);
 #define CONFIG_SENSOR_MOCK_GESTURE_INTERVAL_MS 3000
 #endif
 
+#ifndef CONFIG_SENSOR_MOCK_SEED
+#define CONFIG_SENSOR_MOCK_SEED 1
+#endif
+
+#ifndef CONFIG_SENSOR_MOCK_SCRIPT
+#define CONFIG_SENSOR_MOCK_SCRIPT ""
+#endif
+
 /** Duration of gesture patterns in milliseconds */
 #define GESTURE_DURATION_MS 500
 
@@ -48,30 +63,117 @@ LOG_MODULE_REGISTER(mock_accel, CONFIG_LOG_DEFAULT_LEVEL);
 #define GRAVITY_OFFSET 8192
 
 /* ============================================================================
- * Type Definitions
+ * Built-in Scenarios
  * ============================================================================ */
 
-typedef enum {
-    MOCK_GESTURE_IDLE = 0,
-    MOCK_GESTURE_WAVE,
-    MOCK_GESTURE_TAP,
-    MOCK_GESTURE_CIRCLE,
-    MOCK_GESTURE_COUNT
-} mock_gesture_t;
+/** Idle stretch with the given noise */
+#define IDLE_STEP(ms, noise_)                                                 \
+    { .gesture = MOCK_GESTURE_IDLE, .noise = (noise_), .duration_ms = (ms) }
+
+/** Gesture played count times, gap_ ms apart */
+#define GESTURE_STEP(g, ms, count, gap_, amp, noise_)                         \
+    { .gesture = (g), .repeat = (count) - 1, .amplitude_pct = (amp),         \
+      .noise = (noise_), .gap_ms = (gap_), .duration_ms = (ms) }
+
+/** One gesture of each kind at a fixed interval (the original demo) */
+static const struct mock_scenario_step cycle_steps[] = {
+    IDLE_STEP(CONFIG_SENSOR_MOCK_GESTURE_INTERVAL_MS, NOISE_AMPLITUDE),
+    GESTURE_STEP(MOCK_GESTURE_WAVE, GESTURE_DURATION_MS, 1, 0, 100, NOISE_AMPLITUDE),
+    IDLE_STEP(CONFIG_SENSOR_MOCK_GESTURE_INTERVAL_MS, NOISE_AMPLITUDE),
+    GESTURE_STEP(MOCK_GESTURE_TAP, GESTURE_DURATION_MS, 1, 0, 100, NOISE_AMPLITUDE),
+    IDLE_STEP(CONFIG_SENSOR_MOCK_GESTURE_INTERVAL_MS, NOISE_AMPLITUDE),
+    GESTURE_STEP(MOCK_GESTURE_CIRCLE, GESTURE_DURATION_MS, 1, 0, 100, NOISE_AMPLITUDE),
+};
+
+/** Back-to-back gestures with no settling time, then a pause */
+static const struct mock_scenario_step storm_steps[] = {
+    IDLE_STEP(2000, NOISE_AMPLITUDE),
+    GESTURE_STEP(MOCK_GESTURE_WAVE, 300, 6, 0, 100, NOISE_AMPLITUDE),
+    GESTURE_STEP(MOCK_GESTURE_TAP, 150, 10, 20, 130, 200),
+    GESTURE_STEP(MOCK_GESTURE_CIRCLE, 400, 4, 0, 80, NOISE_AMPLITUDE),
+    GESTURE_STEP(MOCK_GESTURE_WAVE, 250, 4, 50, 150, 300),
+    GESTURE_STEP(MOCK_GESTURE_TAP, 100, 12, 0, 100, NOISE_AMPLITUDE),
+    IDLE_STEP(5000, NOISE_AMPLITUDE),
+};
+
+/** Short bursts of mixed gestures separated by long idle stretches */
+static const struct mock_scenario_step burst_steps[] = {
+    IDLE_STEP(8000, NOISE_AMPLITUDE),
+    GESTURE_STEP(MOCK_GESTURE_WAVE, 500, 1, 0, 100, NOISE_AMPLITUDE),
+    IDLE_STEP(100, NOISE_AMPLITUDE),
+    GESTURE_STEP(MOCK_GESTURE_TAP, 300, 1, 0, 120, NOISE_AMPLITUDE),
+    IDLE_STEP(100, NOISE_AMPLITUDE),
+    GESTURE_STEP(MOCK_GESTURE_CIRCLE, 500, 1, 0, 100, NOISE_AMPLITUDE),
+    IDLE_STEP(15000, NOISE_AMPLITUDE),
+    GESTURE_STEP(MOCK_GESTURE_TAP, 200, 3, 150, 100, NOISE_AMPLITUDE),
+};
+
+/** Long quiet and noisy idle stretches with weak and strong gestures */
+static const struct mock_scenario_step sparse_steps[] = {
+    IDLE_STEP(30000, 50),
+    GESTURE_STEP(MOCK_GESTURE_WAVE, 500, 1, 0, 50, 50),
+    IDLE_STEP(30000, 400),
+    GESTURE_STEP(MOCK_GESTURE_TAP, 500, 1, 0, 150, 400),
+    IDLE_STEP(60000, NOISE_AMPLITUDE),
+    GESTURE_STEP(MOCK_GESTURE_CIRCLE, 800, 1, 0, 100, NOISE_AMPLITUDE),
+};
+
+#define BUILTIN_SCENARIO(name_, steps_)                                       \
+    { .name = (name_), .steps = (steps_), .count = ARRAY_SIZE(steps_) }
+
+#if defined(CONFIG_SENSOR_MOCK_SCENARIO_STORM)
+static const struct mock_scenario builtin_scenario =
+    BUILTIN_SCENARIO("storm", storm_steps);
+#elif defined(CONFIG_SENSOR_MOCK_SCENARIO_BURST)
+static const struct mock_scenario builtin_scenario =
+    BUILTIN_SCENARIO("burst", burst_steps);
+#elif defined(CONFIG_SENSOR_MOCK_SCENARIO_SPARSE)
+static const struct mock_scenario builtin_scenario =
+    BUILTIN_SCENARIO("sparse", sparse_steps);
+#else
+static const struct mock_scenario builtin_scenario =
+    BUILTIN_SCENARIO("cycle", cycle_steps);
+#endif
 
 /* ============================================================================
  * Private Data
  * ============================================================================ */
 
+static const char *const gesture_names[MOCK_GESTURE_COUNT] = {
+    "IDLE", "WAVE", "TAP", "CIRCLE"
+};
+
+/** Script step letters, indexed by mock_gesture_t */
+static const char gesture_codes[MOCK_GESTURE_COUNT] = { 'I', 'W', 'T', 'C' };
+
 static bool mock_initialized = false;
-static mock_gesture_t current_gesture = MOCK_GESTURE_IDLE;
-static uint32_t gesture_start_time = 0;
-static uint32_t next_gesture_time = 0;
-static uint32_t gesture_sequence_index = 0;
+
+/** Scenario being played and the position in it */
+static const struct mock_scenario *scenario = &builtin_scenario;
+static uint16_t step_index = 0;
+static uint8_t repetition = 0;
+static bool in_gap = false;
+
+/** Scenario time (us), advanced one sample period per read */
+static uint64_t scenario_time_us = 0;
+static uint64_t phase_start_us = 0;
+
+/** Noise generator state */
+static uint32_t noise_state = CONFIG_SENSOR_MOCK_SEED;
+
+/** Storage for scripts loaded with mock_accel_load_script() */
+static struct mock_scenario_step script_steps[MOCK_SCENARIO_MAX_STEPS];
+static struct mock_scenario script_scenario = {
+    .name = "script",
+    .steps = script_steps,
+};
+
+/** Protects the scenario and the position in it */
+static K_MUTEX_DEFINE(scenario_mutex);
 
 /** Sample timing */
 static uint32_t last_sample_time = 0;
-static const uint32_t sample_period_us = 1000000 / CONFIG_SENSOR_SAMPLE_RATE_HZ;
+static uint32_t sample_period_us = 1000000 / CONFIG_SENSOR_SAMPLE_RATE_HZ;
 
 /* ============================================================================
  * Private Functions
@@ -79,75 +181,237 @@ static const uint32_t sample_period_us = 1000000 / CONFIG_SENSOR_SAMPLE_RATE_HZ;
 
 /**
  * @brief Generate random noise in range [-amplitude, +amplitude]
+ *
+ * xorshift32, so the sequence depends only on CONFIG_SENSOR_MOCK_SEED.
  */
-static int16_t generate_noise(int16_t amplitude)
+static int16_t generate_noise(uint16_t amplitude)
 {
-    uint32_t rand_val = sys_rand32_get();
-    int32_t noise = (int32_t)(rand_val % (2 * amplitude + 1)) - amplitude;
-    return (int16_t)noise;
+    if (amplitude == 0) {
+        return 0;
+    }
+
+    noise_state ^= noise_state << 13;
+    noise_state ^= noise_state >> 17;
+    noise_state ^= noise_state << 5;
+
+    return (int16_t)((int32_t)(noise_state % (2U * amplitude + 1U)) -
+                     amplitude);
 }
 
-/**
- * @brief Select next gesture type (cycles through all gestures for demo)
- */
-static mock_gesture_t select_next_gesture(void)
+static int16_t clamp_axis(float value)
 {
-    /* Cycle through gestures: WAVE, TAP, CIRCLE, then back to WAVE */
-    gesture_sequence_index = (gesture_sequence_index + 1) % (MOCK_GESTURE_COUNT - 1);
-    return (mock_gesture_t)(gesture_sequence_index + 1);  /* Skip IDLE */
+    return (int16_t)CLAMP(value, INT16_MIN, INT16_MAX);
 }
 
 /**
  * @brief Generate idle/baseline accelerometer data
  */
-static void generate_idle(struct accel_sample *sample)
+static void generate_idle(struct accel_sample *sample, uint16_t noise)
 {
-    sample->x = generate_noise(NOISE_AMPLITUDE);
-    sample->y = generate_noise(NOISE_AMPLITUDE);
-    sample->z = GRAVITY_OFFSET + generate_noise(NOISE_AMPLITUDE);
+    sample->x = generate_noise(noise);
+    sample->y = generate_noise(noise);
+    sample->z = clamp_axis(GRAVITY_OFFSET + generate_noise(noise));
 }
 
 /**
  * @brief Generate wave gesture (side-to-side motion)
  */
-static void generate_wave(struct accel_sample *sample, uint32_t elapsed_ms)
+static void generate_wave(struct accel_sample *sample, float t, float amp,
+                          uint16_t noise)
 {
     /* Sinusoidal wave on X-axis, smaller Y component */
-    float phase = (float)elapsed_ms / GESTURE_DURATION_MS * 4.0f * 3.14159f;
-    float envelope = 1.0f - ((float)elapsed_ms / GESTURE_DURATION_MS);
-    
-    sample->x = (int16_t)(sinf(phase) * GESTURE_AMPLITUDE * envelope);
-    sample->y = (int16_t)(cosf(phase * 0.5f) * GESTURE_AMPLITUDE * 0.3f * envelope);
-    sample->z = GRAVITY_OFFSET + generate_noise(NOISE_AMPLITUDE);
+    float phase = t * 4.0f * 3.14159f;
+    float envelope = 1.0f - t;
+
+    sample->x = clamp_axis(sinf(phase) * amp * envelope + generate_noise(noise));
+    sample->y = clamp_axis(cosf(phase * 0.5f) * amp * 0.3f * envelope +
+                           generate_noise(noise));
+    sample->z = clamp_axis(GRAVITY_OFFSET + generate_noise(noise));
 }
 
 /**
  * @brief Generate tap gesture (sharp impulse)
  */
-static void generate_tap(struct accel_sample *sample, uint32_t elapsed_ms)
+static void generate_tap(struct accel_sample *sample, float t, float amp,
+                         uint16_t noise)
 {
     /* Sharp spike followed by exponential decay with oscillation */
-    float t = (float)elapsed_ms / GESTURE_DURATION_MS;
     float decay = expf(-t * 8.0f);
     float oscillation = sinf(t * 30.0f);
-    
-    sample->x = generate_noise(NOISE_AMPLITUDE);
-    sample->y = (int16_t)(GESTURE_AMPLITUDE * 1.5f * decay * oscillation);
-    sample->z = GRAVITY_OFFSET + (int16_t)(GESTURE_AMPLITUDE * 0.5f * decay);
+
+    sample->x = generate_noise(noise);
+    sample->y = clamp_axis(amp * 1.5f * decay * oscillation +
+                           generate_noise(noise));
+    sample->z = clamp_axis(GRAVITY_OFFSET + amp * 0.5f * decay +
+                           generate_noise(noise));
 }
 
 /**
  * @brief Generate circle gesture (circular motion)
  */
-static void generate_circle(struct accel_sample *sample, uint32_t elapsed_ms)
+static void generate_circle(struct accel_sample *sample, float t, float amp,
+                            uint16_t noise)
 {
     /* Circular pattern on X-Y plane */
-    float phase = (float)elapsed_ms / GESTURE_DURATION_MS * 2.0f * 3.14159f;
-    float envelope = sinf((float)elapsed_ms / GESTURE_DURATION_MS * 3.14159f);
-    
-    sample->x = (int16_t)(cosf(phase) * GESTURE_AMPLITUDE * envelope);
-    sample->y = (int16_t)(sinf(phase) * GESTURE_AMPLITUDE * envelope);
-    sample->z = GRAVITY_OFFSET + generate_noise(NOISE_AMPLITUDE);
+    float phase = t * 2.0f * 3.14159f;
+    float envelope = sinf(t * 3.14159f);
+
+    sample->x = clamp_axis(cosf(phase) * amp * envelope + generate_noise(noise));
+    sample->y = clamp_axis(sinf(phase) * amp * envelope + generate_noise(noise));
+    sample->z = clamp_axis(GRAVITY_OFFSET + generate_noise(noise));
+}
+
+static bool step_valid(const struct mock_scenario_step *step)
+{
+    return step->gesture < MOCK_GESTURE_COUNT &&
+           step->duration_ms > 0 &&
+           step->amplitude_pct <= MOCK_MAX_AMPLITUDE_PCT &&
+           step->noise <= MOCK_MAX_NOISE;
+}
+
+static void log_step_start(void)
+{
+    const struct mock_scenario_step *step = &scenario->steps[step_index];
+
+    if (step->gesture == MOCK_GESTURE_IDLE) {
+        LOG_DBG("Idle for %u ms", step->duration_ms);
+    } else {
+        LOG_INF("Starting gesture: %s", gesture_names[step->gesture]);
+    }
+}
+
+/**
+ * @brief Play a scenario from its first step (caller holds scenario_mutex)
+ */
+static void restart_scenario(const struct mock_scenario *next)
+{
+    scenario = next;
+    step_index = 0;
+    repetition = 0;
+    in_gap = false;
+    scenario_time_us = 0;
+    phase_start_us = 0;
+    noise_state = CONFIG_SENSOR_MOCK_SEED != 0 ? CONFIG_SENSOR_MOCK_SEED : 1;
+
+    LOG_INF("Playing scenario '%s' (%u steps)", next->name, next->count);
+    log_step_start();
+}
+
+/**
+ * @brief Move through every step phase that has ended by scenario_time_us
+ *
+ * Phase boundaries are kept on the ideal timeline, so a step ending
+ * between two samples does not delay the next one. Caller holds
+ * scenario_mutex.
+ */
+static void advance_scenario(void)
+{
+    for (;;) {
+        const struct mock_scenario_step *step = &scenario->steps[step_index];
+        uint64_t phase_us = (uint64_t)(in_gap ? step->gap_ms :
+                                       step->duration_ms) * 1000U;
+
+        if (scenario_time_us - phase_start_us < phase_us) {
+            return;
+        }
+        phase_start_us += phase_us;
+
+        if (in_gap) {
+            in_gap = false;
+            repetition++;
+            log_step_start();
+        } else if (repetition < step->repeat) {
+            if (step->gap_ms > 0) {
+                in_gap = true;
+            } else {
+                repetition++;
+                log_step_start();
+            }
+        } else {
+            step_index = (step_index + 1) % scenario->count;
+            repetition = 0;
+            log_step_start();
+        }
+    }
+}
+
+/**
+ * @brief Parse one script step ("W300*5/20@130~300")
+ *
+ * @return 0 on success, -EINVAL on a syntax or range error
+ */
+static int parse_step(const char **cursor, struct mock_scenario_step *step)
+{
+    const char *p = *cursor;
+    unsigned long count = 1;
+    unsigned long value;
+    char *end;
+    int g;
+
+    for (g = 0; g < MOCK_GESTURE_COUNT; g++) {
+        if (toupper((unsigned char)*p) == gesture_codes[g]) {
+            break;
+        }
+    }
+    if (g == MOCK_GESTURE_COUNT) {
+        return -EINVAL;
+    }
+
+    *step = (struct mock_scenario_step){
+        .gesture = (uint8_t)g,
+        .amplitude_pct = 100,
+        .noise = NOISE_AMPLITUDE,
+    };
+
+    value = strtoul(++p, &end, 10);
+    if (end == p || value == 0) {
+        return -EINVAL;
+    }
+    step->duration_ms = (uint32_t)value;
+    p = end;
+
+    while (*p != '\0' && !isspace((unsigned char)*p)) {
+        char field = *p++;
+
+        value = strtoul(p, &end, 10);
+        if (end == p) {
+            return -EINVAL;
+        }
+        p = end;
+
+        switch (field) {
+        case '*':
+            if (value == 0 || value > UINT8_MAX + 1UL) {
+                return -EINVAL;
+            }
+            count = value;
+            break;
+        case '/':
+            if (value > UINT16_MAX) {
+                return -EINVAL;
+            }
+            step->gap_ms = (uint16_t)value;
+            break;
+        case '@':
+            if (value > MOCK_MAX_AMPLITUDE_PCT) {
+                return -EINVAL;
+            }
+            step->amplitude_pct = (uint16_t)value;
+            break;
+        case '~':
+            if (value > MOCK_MAX_NOISE) {
+                return -EINVAL;
+            }
+            step->noise = (uint16_t)value;
+            break;
+        default:
+            return -EINVAL;
+        }
+    }
+
+    step->repeat = (uint8_t)(count - 1);
+    *cursor = p;
+    return 0;
 }
 
 /* ============================================================================
@@ -158,24 +422,29 @@ int mock_accel_init(void)
 {
     LOG_INF("Initializing mock accelerometer");
     LOG_INF("  Sample rate: %d Hz", CONFIG_SENSOR_SAMPLE_RATE_HZ);
-    LOG_INF("  Gesture interval: %d ms", CONFIG_SENSOR_MOCK_GESTURE_INTERVAL_MS);
-    
+
     mock_initialized = true;
-    current_gesture = MOCK_GESTURE_IDLE;
-    gesture_start_time = 0;
-    next_gesture_time = k_uptime_get_32() + CONFIG_SENSOR_MOCK_GESTURE_INTERVAL_MS;
-    gesture_sequence_index = 0;
     last_sample_time = 0;
-    
+    sample_period_us = 1000000 / CONFIG_SENSOR_SAMPLE_RATE_HZ;
+
+#ifdef CONFIG_SENSOR_MOCK_SCENARIO_SCRIPT
+    if (mock_accel_load_script(CONFIG_SENSOR_MOCK_SCRIPT) == 0) {
+        LOG_INF("Mock accelerometer ready");
+        return 0;
+    }
+    LOG_ERR("Invalid CONFIG_SENSOR_MOCK_SCRIPT, using built-in scenario");
+#endif
+
+    k_mutex_lock(&scenario_mutex, K_FOREVER);
+    restart_scenario(&builtin_scenario);
+    k_mutex_unlock(&scenario_mutex);
+
     LOG_INF("Mock accelerometer ready");
     return 0;
 }
 
 int mock_accel_read(struct accel_sample *sample)
 {
-    uint32_t now;
-    uint32_t elapsed_ms;
-    
     if (!mock_initialized) {
         return -ENODEV;
     }
@@ -184,44 +453,35 @@ int mock_accel_read(struct accel_sample *sample)
         return -EINVAL;
     }
     
-    now = k_uptime_get_32();
-    
-    /* Check if we should start a new gesture */
-    if (current_gesture == MOCK_GESTURE_IDLE && now >= next_gesture_time) {
-        current_gesture = select_next_gesture();
-        gesture_start_time = now;
-        LOG_INF("Starting gesture: %s", 
-                current_gesture == MOCK_GESTURE_WAVE ? "WAVE" :
-                current_gesture == MOCK_GESTURE_TAP ? "TAP" :
-                current_gesture == MOCK_GESTURE_CIRCLE ? "CIRCLE" : "UNKNOWN");
-    }
-    
-    /* Calculate elapsed time in current gesture */
-    elapsed_ms = now - gesture_start_time;
-    
-    /* Check if gesture has completed */
-    if (current_gesture != MOCK_GESTURE_IDLE && elapsed_ms >= GESTURE_DURATION_MS) {
-        LOG_INF("Gesture complete");
-        current_gesture = MOCK_GESTURE_IDLE;
-        next_gesture_time = now + CONFIG_SENSOR_MOCK_GESTURE_INTERVAL_MS;
-    }
-    
+    k_mutex_lock(&scenario_mutex, K_FOREVER);
+
+    advance_scenario();
+
+    const struct mock_scenario_step *step = &scenario->steps[step_index];
+    float amp = GESTURE_AMPLITUDE * step->amplitude_pct / 100.0f;
+    float t = (float)(scenario_time_us - phase_start_us) /
+              ((float)step->duration_ms * 1000.0f);
+
     /* Generate sample based on current gesture */
-    switch (current_gesture) {
+    switch (in_gap ? MOCK_GESTURE_IDLE : step->gesture) {
         case MOCK_GESTURE_WAVE:
-            generate_wave(sample, elapsed_ms);
+            generate_wave(sample, t, amp, step->noise);
             break;
         case MOCK_GESTURE_TAP:
-            generate_tap(sample, elapsed_ms);
+            generate_tap(sample, t, amp, step->noise);
             break;
         case MOCK_GESTURE_CIRCLE:
-            generate_circle(sample, elapsed_ms);
+            generate_circle(sample, t, amp, step->noise);
             break;
         case MOCK_GESTURE_IDLE:
         default:
-            generate_idle(sample);
+            generate_idle(sample, step->noise);
             break;
     }
+
+    scenario_time_us += sample_period_us;
+
+    k_mutex_unlock(&scenario_mutex);
     
     return 0;
 }
@@ -241,3 +501,80 @@ bool mock_accel_data_ready(void)
     
     return false;
 }
+
+void mock_accel_set_rate(uint32_t rate_hz)
+{
+    if (rate_hz > 0) {
+        sample_period_us = 1000000 / rate_hz;
+    }
+}
+
+int mock_accel_set_scenario(const struct mock_scenario *next)
+{
+    if (next == NULL || next->steps == NULL || next->count == 0) {
+        return -EINVAL;
+    }
+
+    for (uint16_t i = 0; i < next->count; i++) {
+        if (!step_valid(&next->steps[i])) {
+            LOG_ERR("Scenario '%s' step %u is invalid", next->name, i);
+            return -EINVAL;
+        }
+    }
+
+    k_mutex_lock(&scenario_mutex, K_FOREVER);
+    restart_scenario(next);
+    k_mutex_unlock(&scenario_mutex);
+
+    return 0;
+}
+
+int mock_accel_load_script(const char *script)
+{
+    struct mock_scenario_step parsed[MOCK_SCENARIO_MAX_STEPS];
+    const char *p = script;
+    uint16_t count = 0;
+    int ret;
+
+    if (script == NULL) {
+        return -EINVAL;
+    }
+
+    for (;;) {
+        while (isspace((unsigned char)*p)) {
+            p++;
+        }
+        if (*p == '\0') {
+            break;
+        }
+        if (count == MOCK_SCENARIO_MAX_STEPS) {
+            LOG_ERR("Script longer than %d steps", MOCK_SCENARIO_MAX_STEPS);
+            return -E2BIG;
+        }
+
+        ret = parse_step(&p, &parsed[count]);
+        if (ret < 0) {
+            LOG_ERR("Script error at step %u", count + 1);
+            return ret;
+        }
+        count++;
+    }
+
+    if (count == 0) {
+        return -EINVAL;
+    }
+
+    /* The mutex also keeps script_steps stable while it is played */
+    k_mutex_lock(&scenario_mutex, K_FOREVER);
+    memcpy(script_steps, parsed, count * sizeof(parsed[0]));
+    script_scenario.count = count;
+    restart_scenario(&script_scenario);
+    k_mutex_unlock(&scenario_mutex);
+
+    return 0;
+}
+
+const char *mock_accel_scenario_name(void)
+{
+    return scenario->name;
+}
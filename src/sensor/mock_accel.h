@@ -0,0 +1,136 @@
+/*
+ * SPDX-License-Identifier: MIT
+ *
+ * Zephyr Edge AI Demo - Mock Accelerometer
+ *
+ * The mock plays a scenario: a looping list of steps, each an idle
+ * stretch or a gesture repeated back to back, with its own duration,
+ * amplitude and noise level. Scenario time advances by one sample
+ * period per read and noise comes from a seeded generator, so a given
+ * scenario, seed and sample rate always produce the same sample stream.
+ */
+
+#ifndef MOCK_ACCEL_H
+#define MOCK_ACCEL_H
+
+#include "sensor_hal.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ============================================================================
+ * Type Definitions
+ * ============================================================================ */
+
+/**
+ * @brief Generated motion patterns
+ */
+typedef enum {
+    MOCK_GESTURE_IDLE = 0,
+    MOCK_GESTURE_WAVE,
+    MOCK_GESTURE_TAP,
+    MOCK_GESTURE_CIRCLE,
+    MOCK_GESTURE_COUNT
+} mock_gesture_t;
+
+/** Longest script accepted by mock_accel_load_script() (steps) */
+#define MOCK_SCENARIO_MAX_STEPS 32
+
+/** Largest step amplitude (percent of the nominal gesture amplitude) */
+#define MOCK_MAX_AMPLITUDE_PCT 400
+
+/** Largest step noise amplitude (raw units) */
+#define MOCK_MAX_NOISE 4000
+
+/**
+ * @brief One scenario step
+ */
+struct mock_scenario_step {
+    /** Pattern (mock_gesture_t) */
+    uint8_t gesture;
+
+    /** Additional back-to-back repetitions (0 = play once) */
+    uint8_t repeat;
+
+    /** Gesture amplitude, percent of nominal (ignored for idle) */
+    uint16_t amplitude_pct;
+
+    /** Noise amplitude on every axis (raw units) */
+    uint16_t noise;
+
+    /** Idle gap between repetitions (ms, 0 = none) */
+    uint16_t gap_ms;
+
+    /** Duration of one repetition (ms, non-zero) */
+    uint32_t duration_ms;
+};
+
+/**
+ * @brief Scenario: a step list played in a loop
+ */
+struct mock_scenario {
+    /** Name shown in logs */
+    const char *name;
+
+    /** Steps */
+    const struct mock_scenario_step *steps;
+
+    /** Number of steps */
+    uint16_t count;
+};
+
+/* ============================================================================
+ * Public API Functions
+ * ============================================================================ */
+
+int mock_accel_init(void);
+int mock_accel_read(struct accel_sample *sample);
+bool mock_accel_data_ready(void);
+void mock_accel_set_rate(uint32_t rate_hz);
+
+/**
+ * @brief Play a scenario from its first step
+ *
+ * The scenario is referenced, not copied, and must stay valid while in
+ * use. The noise generator is reseeded, so replaying a scenario repeats
+ * its samples exactly.
+ *
+ * @param scenario Scenario to play
+ * @return 0 on success, -EINVAL if a step is malformed
+ */
+int mock_accel_set_scenario(const struct mock_scenario *scenario);
+
+/**
+ * @brief Parse a scenario script and play it from its first step
+ *
+ * A script is whitespace-separated steps of the form
+ *
+ *     <G><duration_ms>[*<count>][/<gap_ms>][@<amplitude_pct>][~<noise>]
+ *
+ * where G is I (idle), W (wave), T (tap) or C (circle) and count is
+ * the total number of back-to-back repetitions. For example
+ * "I2000 W300*5 T150*8/20@130~300 I10000" is a five-wave burst followed
+ * by eight strong, noisy taps 20 ms apart and a ten second pause.
+ *
+ * On error the current scenario keeps playing.
+ *
+ * @param script Scenario script
+ * @return 0 on success, -EINVAL on a syntax or range error, -E2BIG if
+ *         the script has more than MOCK_SCENARIO_MAX_STEPS steps
+ */
+int mock_accel_load_script(const char *script);
+
+/**
+ * @brief Name of the scenario being played
+ */
+const char *mock_accel_scenario_name(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MOCK_ACCEL_H */
@@ -9,9 +9,15 @@
  */
 
 #include "sensor_hal.h"
+#include "lockstat.h"
+
+#ifdef CONFIG_SENSOR_USE_MOCK
+#include "mock_accel.h"
+#endif
 
 #include <zephyr/kernel.h>
 #include <zephyr/logging/log.h>
+#include <stdlib.h>
 
 LOG_MODULE_REGISTER(sensor_hal, CONFIG_LOG_DEFAULT_LEVEL);
 
@@ -26,21 +32,26 @@ static bool initialized = false;
 static struct sensor_stats stats = {0};
 
 /** Mutex for thread-safe access */
-static K_MUTEX_DEFINE(sensor_mutex);
+static LOCKSTAT_MUTEX_DEFINE(sensor_mutex);
 
 /** Last sample time for rate calculation */
 static uint32_t last_sample_time = 0;
 static uint32_t sample_interval_sum = 0;
 static uint32_t sample_interval_count = 0;
 
-/* ============================================================================
- * External Mock Sensor Functions (defined in mock_accel.c)
- * ============================================================================ */
+/** Current sample rate */
+static uint32_t current_rate_hz = CONFIG_SENSOR_SAMPLE_RATE_HZ;
 
-#ifdef CONFIG_SENSOR_USE_MOCK
-extern int mock_accel_init(void);
-extern int mock_accel_read(struct accel_sample *sample);
-extern bool mock_accel_data_ready(void);
+#ifdef CONFIG_SENSOR_ADAPTIVE_RATE
+BUILD_ASSERT(CONFIG_SENSOR_IDLE_RATE_HZ < CONFIG_SENSOR_SAMPLE_RATE_HZ,
+             "Idle sample rate must be below the full sample rate");
+
+/** Previous sample for motion detection */
+static struct accel_sample prev_sample;
+static bool have_prev_sample = false;
+
+/** Time of the last sample above the motion threshold */
+static uint32_t last_motion_time = 0;
 #endif
 
 /* ============================================================================
@@ -49,9 +60,65 @@ extern bool mock_accel_data_ready(void);
 
 uint32_t sensor_get_timestamp_us(void)
 {
-    return (uint32_t)(k_uptime_get() * 1000);
+    /* Full tick resolution; k_uptime_get() would round to whole ms */
+    return (uint32_t)k_ticks_to_us_floor64(k_uptime_ticks());
 }
 
+/* ============================================================================
+ * Private Functions
+ * ============================================================================ */
+
+/**
+ * @brief Apply a new sample rate (caller holds sensor_mutex)
+ */
+static void apply_rate(uint32_t rate_hz)
+{
+    if (rate_hz == current_rate_hz) {
+        return;
+    }
+
+    current_rate_hz = rate_hz;
+    stats.current_rate_hz = rate_hz;
+    stats.rate_switches++;
+
+#ifdef CONFIG_SENSOR_USE_MOCK
+    mock_accel_set_rate(rate_hz);
+#endif
+
+    LOG_DBG("Sample rate: %u Hz", rate_hz);
+}
+
+#ifdef CONFIG_SENSOR_ADAPTIVE_RATE
+/**
+ * @brief Switch between idle and full rate based on motion
+ *
+ * Motion is the L1 change between consecutive samples, which ignores
+ * the constant gravity component. Caller holds sensor_mutex.
+ */
+static void adapt_rate(const struct accel_sample *sample)
+{
+    if (!have_prev_sample) {
+        prev_sample = *sample;
+        have_prev_sample = true;
+        last_motion_time = sample->timestamp_us;
+        return;
+    }
+
+    uint32_t motion = (uint32_t)(abs(sample->x - prev_sample.x) +
+                                 abs(sample->y - prev_sample.y) +
+                                 abs(sample->z - prev_sample.z));
+    prev_sample = *sample;
+
+    if (motion >= CONFIG_SENSOR_MOTION_THRESHOLD) {
+        last_motion_time = sample->timestamp_us;
+        apply_rate(CONFIG_SENSOR_SAMPLE_RATE_HZ);
+    } else if (sample->timestamp_us - last_motion_time >=
+               CONFIG_SENSOR_IDLE_TIMEOUT_MS * 1000U) {
+        apply_rate(CONFIG_SENSOR_IDLE_RATE_HZ);
+    }
+}
+#endif
+
 /* ============================================================================
  * Public API Implementation
  * ============================================================================ */
@@ -60,11 +127,11 @@ int sensor_hal_init(void)
 {
     int ret;
 
-    k_mutex_lock(&sensor_mutex, K_FOREVER);
+    lockstat_mutex_lock(&sensor_mutex, K_FOREVER);
 
     if (initialized) {
         LOG_WRN("Sensor HAL already initialized");
-        k_mutex_unlock(&sensor_mutex);
+        lockstat_mutex_unlock(&sensor_mutex);
         return SENSOR_STATUS_OK;
     }
 
@@ -86,12 +153,14 @@ int sensor_hal_init(void)
         stats.read_errors = 0;
         stats.avg_sample_rate_hz = 0;
         stats.last_read_time_us = 0;
+        stats.current_rate_hz = current_rate_hz;
+        stats.rate_switches = 0;
         LOG_INF("Sensor HAL initialized successfully");
     } else {
         LOG_ERR("Failed to initialize sensor (err %d)", ret);
     }
 
-    k_mutex_unlock(&sensor_mutex);
+    lockstat_mutex_unlock(&sensor_mutex);
     return (ret == 0) ? SENSOR_STATUS_OK : SENSOR_STATUS_ERROR;
 }
 
@@ -109,7 +178,7 @@ int sensor_hal_read(struct accel_sample *sample)
         return SENSOR_STATUS_NOT_INITIALIZED;
     }
 
-    k_mutex_lock(&sensor_mutex, K_FOREVER);
+    lockstat_mutex_lock(&sensor_mutex, K_FOREVER);
 
 #ifdef CONFIG_SENSOR_USE_MOCK
     ret = mock_accel_read(sample);
@@ -143,13 +212,17 @@ int sensor_hal_read(struct accel_sample *sample)
         last_sample_time = now;
         stats.last_read_time_us = now;
         
+#ifdef CONFIG_SENSOR_ADAPTIVE_RATE
+        adapt_rate(sample);
+#endif
+        
         LOG_DBG("Sample: x=%d, y=%d, z=%d", sample->x, sample->y, sample->z);
     } else {
         stats.read_errors++;
         LOG_WRN("Sensor read failed (err %d)", ret);
     }
 
-    k_mutex_unlock(&sensor_mutex);
+    lockstat_mutex_unlock(&sensor_mutex);
     
     return (ret == 0) ? SENSOR_STATUS_OK : SENSOR_STATUS_ERROR;
 }
@@ -167,33 +240,58 @@ bool sensor_hal_data_ready(void)
 #endif
 }
 
+int sensor_hal_set_rate(uint32_t rate_hz)
+{
+    if (rate_hz == 0 || rate_hz > 1000) {
+        return SENSOR_STATUS_ERROR;
+    }
+
+    lockstat_mutex_lock(&sensor_mutex, K_FOREVER);
+    apply_rate(rate_hz);
+    lockstat_mutex_unlock(&sensor_mutex);
+
+    return SENSOR_STATUS_OK;
+}
+
+uint32_t sensor_hal_get_rate(void)
+{
+    uint32_t rate;
+
+    lockstat_mutex_lock(&sensor_mutex, K_FOREVER);
+    rate = current_rate_hz;
+    lockstat_mutex_unlock(&sensor_mutex);
+
+    return rate;
+}
+
 int sensor_hal_get_stats(struct sensor_stats *out_stats)
 {
     if (out_stats == NULL) {
         return SENSOR_STATUS_ERROR;
     }
 
-    k_mutex_lock(&sensor_mutex, K_FOREVER);
+    lockstat_mutex_lock(&sensor_mutex, K_FOREVER);
     *out_stats = stats;
-    k_mutex_unlock(&sensor_mutex);
+    lockstat_mutex_unlock(&sensor_mutex);
 
     return SENSOR_STATUS_OK;
 }
 
 void sensor_hal_reset_stats(void)
 {
-    k_mutex_lock(&sensor_mutex, K_FOREVER);
+    lockstat_mutex_lock(&sensor_mutex, K_FOREVER);
     
     stats.samples_read = 0;
     stats.read_errors = 0;
     stats.avg_sample_rate_hz = 0;
     stats.last_read_time_us = 0;
+    stats.rate_switches = 0;
     
     last_sample_time = 0;
     sample_interval_sum = 0;
     sample_interval_count = 0;
     
-    k_mutex_unlock(&sensor_mutex);
+    lockstat_mutex_unlock(&sensor_mutex);
     
     LOG_INF("Sensor statistics reset");
 }
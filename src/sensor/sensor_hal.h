@@ -63,6 +63,10 @@ struct sensor_stats {
     uint32_t avg_sample_rate_hz;
     /** Time of last successful read (us since boot) */
     uint32_t last_read_time_us;
+    /** Current sample rate (Hz) */
+    uint32_t current_rate_hz;
+    /** Number of sample rate changes */
+    uint32_t rate_switches;
 };
 
 /* ============================================================================
@@ -117,6 +121,27 @@ int sensor_hal_get_stats(struct sensor_stats *stats);
  */
 void sensor_hal_reset_stats(void);
 
+/**
+ * @brief Change the sensor sample rate at runtime
+ *
+ * The caller is responsible for reading samples at the new rate; use
+ * sensor_hal_get_rate() to pace the read loop.
+ *
+ * @param rate_hz New sample rate (1-1000 Hz)
+ * @return SENSOR_STATUS_OK on success, error code otherwise
+ */
+int sensor_hal_set_rate(uint32_t rate_hz);
+
+/**
+ * @brief Get the current sensor sample rate
+ *
+ * With CONFIG_SENSOR_ADAPTIVE_RATE this changes between the idle and
+ * full rates as motion is detected.
+ *
+ * @return Current sample rate in Hz
+ */
+uint32_t sensor_hal_get_rate(void);
+
 /**
  * @brief Convert raw sample to floating point (g)
  *